@@ -0,0 +1,89 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Reading and tokenizing of the text corpus shared by benchmarks and tools.
+ */
+
+#ifndef CORPUS_READER_HPP_
+#define CORPUS_READER_HPP_
+
+#include <cctype>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <SmallStringOptimization/Split.hpp>
+
+/**
+ * @brief Read all lines of the given file.
+ * 
+ * @param aFilePath Path to file.
+ * @return Lines. Empty if the file cannot be opened.
+ */
+inline std::vector<std::string> readFileLineByLine(const char* aFilePath)
+{
+    std::vector<std::string> output;
+    std::ifstream file;
+    file.open(aFilePath);
+
+    if (!file)
+    {
+        return output;
+    }
+    
+    
+    for (std::string line; std::getline(file, line); )
+    {
+        output.push_back(line);
+    }
+    return output;
+}
+
+/**
+ * @brief Return the given piece of line without a non alphanumeric character at its end.
+ * 
+ * @param aPiece Piece of line.
+ * @return Word.
+ */
+inline std::string_view trimWord(std::string_view aPiece)
+{
+    if (!aPiece.empty() && !std::isalnum(aPiece.back()))
+    {
+        aPiece.remove_suffix(1u);
+    }
+    return aPiece;
+}
+
+/**
+ * @brief Split lines to words. Words are separated by space, a non alphanumeric character at the end of word is removed.
+ * The last word of line is taken as it is (also if empty).
+ * 
+ * @param aLines Lines.
+ * @return Words.
+ */
+inline std::vector<std::string> getWordsFromLines(const std::vector<std::string>& aLines)
+{
+    std::vector<std::string> output;
+    for (const auto& line : aLines)
+    {
+        const char* const lineEnd = line.data() + line.size();
+        for (const std::string_view piece : NSSO::split(line, ' '))
+        {
+            if (piece.data() + piece.size() == lineEnd)
+            {
+                output.emplace_back(piece);
+            }
+            else if (!piece.empty())
+            {
+                output.emplace_back(trimWord(piece));
+            }
+        }
+    }
+    return output;
+}
+
+#endif // CORPUS_READER_HPP_
@@ -0,0 +1,236 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Offline advisor of the small string optimization array length. It reads a text corpus (tokenized like in benchmarks)
+ * or a length histogram printed by CSsoProfiler::dumpLengths and for each candidate length reports inline hit rate,
+ * bytes per string and allocations, then recommends the length.
+ *
+ * Usage: SmallStringCapacityAdvisor [--lengths] [--alloc-cost BYTES] [--header PATH] [--alias NAME] [FILE]
+ *   --lengths     FILE contains "length count" lines instead of text,
+ *   --alloc-cost  cost of a single dynamic allocation expressed in bytes, default 32,
+ *   --header      write a header with using alias of the recommended type,
+ *   --alias       name of the alias, default CAdvisedString,
+ *   FILE          input file, default pan-tadeusz.txt.
+ */
+
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include "CorpusReader.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace NSSO;
+
+/**
+ * @brief Result of simulation for a single candidate length.
+ */
+struct CCandidateResult
+{
+    std::size_t mSmallStringOptLength;
+    std::size_t mObjectSize;
+    double mHitRate;
+    double mBytesPerString;
+    double mAllocationsPerString;
+    double mScore;
+};
+
+/**
+ * @brief Histogram of string lengths: length -> number of strings.
+ */
+using THistogram = std::map<std::size_t, std::uint64_t>;
+
+/**
+ * @brief Build histogram from words of the given text file.
+ */
+THistogram histogramFromCorpus(const char* aFilePath)
+{
+    THistogram output;
+    for (const auto& word : getWordsFromLines(readFileLineByLine(aFilePath)))
+    {
+        ++output[word.size()];
+    }
+    return output;
+}
+
+/**
+ * @brief Build histogram from "length count" lines.
+ */
+THistogram histogramFromLengths(const char* aFilePath)
+{
+    THistogram output;
+    std::ifstream file{aFilePath};
+    std::size_t length = 0u;
+    std::uint64_t count = 0u;
+    while (file >> length >> count)
+    {
+        output[length] += count;
+    }
+    return output;
+}
+
+/**
+ * @brief Return size of memory chunk used by a typical malloc implementation for the given request: 8 bytes of header,
+ * 16 bytes alignment, 32 bytes at least.
+ */
+std::size_t mallocChunkSize(std::size_t aBytes)
+{
+    const std::size_t chunk = (aBytes + 8u + 15u) & ~static_cast<std::size_t>(15u);
+    return chunk < 32u ? 32u : chunk;
+}
+
+/**
+ * @brief Simulate storing strings of the given histogram in CSmallStringOpt<TSmallStringOptLength>.
+ */
+template<std::size_t TSmallStringOptLength>
+CCandidateResult simulate(const THistogram& aHistogram, double aAllocationCost)
+{
+    using TString = CSmallStringOpt<TSmallStringOptLength>;
+    std::uint64_t strings = 0u;
+    std::uint64_t inlineStrings = 0u;
+    std::uint64_t heapBytes = 0u;
+    for (const auto& item : aHistogram)
+    {
+        strings += item.second;
+        // the same condition as in CSmallStringOpt constructor: a terminating character must fit too.
+        if (item.first + 1u > TSmallStringOptLength)
+        {
+            heapBytes += item.second * mallocChunkSize((item.first + 1u) * sizeof(typename TString::value_type));
+        }
+        else
+        {
+            inlineStrings += item.second;
+        }
+    }
+
+    CCandidateResult output{TSmallStringOptLength, sizeof(TString), 0.0, 0.0, 0.0, 0.0};
+    if (strings != 0u)
+    {
+        const double count = static_cast<double>(strings);
+        output.mHitRate = static_cast<double>(inlineStrings) / count;
+        output.mBytesPerString = static_cast<double>(sizeof(TString)) + static_cast<double>(heapBytes) / count;
+        output.mAllocationsPerString = static_cast<double>(strings - inlineStrings) / count;
+        output.mScore = output.mBytesPerString + aAllocationCost * output.mAllocationsPerString;
+    }
+    return output;
+}
+
+/**
+ * @brief Simulate all candidate lengths.
+ */
+template<std::size_t... TLengths>
+std::vector<CCandidateResult> simulateAll(const THistogram& aHistogram, double aAllocationCost)
+{
+    return {simulate<TLengths>(aHistogram, aAllocationCost)...};
+}
+
+/**
+ * @brief Write header with using alias of the recommended type.
+ */
+bool writeHeader(const std::string& aPath, const std::string& aAlias, const std::string& aSource, std::size_t aLength)
+{
+    std::ofstream file{aPath};
+    if (!file)
+    {
+        return false;
+    }
+    std::string guard = aAlias;
+    for (auto& c : guard)
+    {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    guard += "_HPP_";
+    file << "// Generated by SmallStringCapacityAdvisor from " << aSource << ".\n"
+         << "#ifndef " << guard << '\n'
+         << "#define " << guard << "\n\n"
+         << "#include <SmallStringOptimization/SmallStringOptimization.hpp>\n\n"
+         << "using " << aAlias << " = NSSO::CSmallStringOpt<" << aLength << "u>;\n\n"
+         << "#endif // " << guard << '\n';
+    return static_cast<bool>(file);
+}
+
+int main(int aArgc, char** aArgv)
+{
+    const char* filePath = "pan-tadeusz.txt";
+    bool lengthsInput = false;
+    double allocationCost = 32.0;
+    std::string headerPath;
+    std::string alias = "CAdvisedString";
+
+    for (int i = 1; i < aArgc; ++i)
+    {
+        const bool hasValue = i + 1 < aArgc;
+        if (std::strcmp(aArgv[i], "--lengths") == 0)
+        {
+            lengthsInput = true;
+        }
+        else if (std::strcmp(aArgv[i], "--alloc-cost") == 0 && hasValue)
+        {
+            allocationCost = std::atof(aArgv[++i]);
+        }
+        else if (std::strcmp(aArgv[i], "--header") == 0 && hasValue)
+        {
+            headerPath = aArgv[++i];
+        }
+        else if (std::strcmp(aArgv[i], "--alias") == 0 && hasValue)
+        {
+            alias = aArgv[++i];
+        }
+        else
+        {
+            filePath = aArgv[i];
+        }
+    }
+
+    const THistogram histogram = lengthsInput ? histogramFromLengths(filePath) : histogramFromCorpus(filePath);
+    if (histogram.empty())
+    {
+        std::cerr << "No strings read from " << filePath << std::endl;
+        return 1;
+    }
+
+    const auto results = simulateAll<8u, 10u, 12u, 16u, 20u, 24u, 32u, 40u, 48u, 64u>(histogram, allocationCost);
+
+    std::cout << std::setw(6) << "N"
+              << std::setw(10) << "sizeof"
+              << std::setw(12) << "inline %"
+              << std::setw(14) << "bytes/string"
+              << std::setw(14) << "allocs/string"
+              << std::setw(10) << "score" << '\n';
+    const CCandidateResult* best = &results.front();
+    for (const auto& result : results)
+    {
+        std::cout << std::setw(6) << result.mSmallStringOptLength
+                  << std::setw(10) << result.mObjectSize
+                  << std::setw(12) << std::fixed << std::setprecision(2) << 100.0 * result.mHitRate
+                  << std::setw(14) << result.mBytesPerString
+                  << std::setw(14) << std::setprecision(4) << result.mAllocationsPerString
+                  << std::setw(10) << std::setprecision(2) << result.mScore << '\n';
+        if (result.mScore < best->mScore)
+        {
+            best = &result;
+        }
+    }
+    std::cout << "Recommended TSmallStringOptLength: " << best->mSmallStringOptLength << std::endl;
+
+    if (!headerPath.empty())
+    {
+        if (!writeHeader(headerPath, alias, filePath, best->mSmallStringOptLength))
+        {
+            std::cerr << "Cannot write " << headerPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,12 +1,24 @@
 
 #include <SmallStringOptimization/SmallStringOptimization.hpp>
 #include <SmallStringOptimization/SimpleString.hpp>
+#include <SmallStringOptimization/CountingAllocator.hpp>
+#include <SmallStringOptimization/Format.hpp>
+#include <SmallStringOptimization/Join.hpp>
+#include <SmallStringOptimization/MultiMatcher.hpp>
+#include <SmallStringOptimization/Rope.hpp>
+#include <SmallStringOptimization/StaticString.hpp>
+#include <SmallStringOptimization/StringStream.hpp>
+#include <SmallStringOptimization/StringVector.hpp>
+#include <SmallStringOptimization/Transcode.hpp>
+#include "CorpusReader.hpp"
 
 
 #include <benchmark/benchmark.h>
 #include <memory>
+#include <set>
 #include <vector>
 #include <fstream>
+#include <sstream>
 #include <string>
 
 using namespace NSSO;
@@ -17,59 +29,12 @@ using namespace NSSO;
 
 const char* gFilePath = "pan-tadeusz.txt";
 
-std::vector<std::string> readFileLineByLine(const char* aFilePath)
-{
-    std::vector<std::string> output;
-    std::ifstream file;
-    file.open(aFilePath);
-
-    if (!file)
-    {
-        return output;
-    }
-    
-    
-    for (std::string line; std::getline(file, line); )
-    {
-        output.push_back(line);
-    }
-    return output;
-}
-
 const std::vector<std::string>& getLines()
 {
     static std::vector<std::string> output = readFileLineByLine(gFilePath);
     return output;
 }
 
-std::vector<std::string> getWordsFromLines(const std::vector<std::string>& aLines)
-{
-    std::vector<std::string> output;
-    for (const auto& line : aLines)
-    {
-        size_t index = 0;
-        size_t pos = 0;
-        while (std::string::npos != (pos = line.find(' ', index)))
-        {
-            if (pos > index)
-            {
-                size_t end = pos;
-                const auto c = line[end - 1];
-                if (!std::isalnum(c))
-                {
-                    --end;
-                }
-                std::string word(line.data() + index, end - index);
-                output.push_back(std::move(word));
-            }
-            index = pos + 1;
-        }
-        std::string word(line.data() + index, line.length() - index);
-        output.push_back(std::move(word));
-    }
-    return output;
-}
-
 const std::vector<std::string>& getWords()
 {
     static std::vector<std::string> output = getWordsFromLines(getLines());
@@ -119,6 +84,36 @@ struct CIncreasedWordToMap
 };
 volatile char CIncreasedWordToMap::volBuf;
 
+/**
+ * @brief The same as CIncreasedWordToMap, but the key is written directly into the string by resize_and_overwrite,
+ * without a side buffer.
+ */
+struct CIncreasedWordInPlaceToMap
+{
+    static volatile char volBuf;
+
+    template<typename T>
+    static unsigned int run(const std::vector<std::string>& aWords)
+    {
+        std::map<T, unsigned int> wordsOccurs;
+        for (const auto& word : aWords)
+        {
+            const std::string buf = word + "ab";
+            volBuf = buf[buf.size() / 3];
+            T key;
+            key.resize_and_overwrite(buf.size(), [&buf](char* aPtr, std::size_t aCount)
+                {
+                    memcpy(aPtr, buf.c_str(), aCount);
+                    aPtr[aCount / 2] = volBuf;
+                    return aCount;
+                });
+            wordsOccurs[std::move(key)]++;
+        }
+        return wordsOccurs.size();
+    }
+};
+volatile char CIncreasedWordInPlaceToMap::volBuf;
+
 
 
 struct CSumWordToMap
@@ -135,10 +130,10 @@ struct CSumWordToMap
         {
             volBuf1 = aWords[i][aWords[i].size() / 2];
             volBuf2 = aWords[i + 3][aWords[i + 3].size() / 2];
-            T a{aWords[i]};
-            a += aWords[i + 1];
+            T a(aWords[i].data(), aWords[i].size());
+            a.append(aWords[i + 1].data(), aWords[i + 1].size());
             a += aWords[i + 2].c_str();
-            a += aWords[i + 3];
+            a.append(aWords[i + 3].data(), aWords[i + 3].size());
             a += aWords[i + 4].c_str();
             a[a.size() / 3] = volBuf1;
             a[a.size() / 4] = volBuf2;
@@ -151,10 +146,32 @@ volatile char CSumWordToMap::volBuf1;
 volatile char CSumWordToMap::volBuf2;
 
 // ---------------
+
+/**
+ * @brief Strings used in benchmarks allocate via CCountingAllocator, so allocation pressure can be reported.
+ */
+using TCountedString = std::basic_string<char, std::char_traits<char>, CCountingAllocator<char>>;
+using TCountedStringOpt10 = CSmallStringOpt<10u, char, CCountingAllocator<char>>;
+using TCountedStringOpt20 = CSmallStringOpt<20u, char, CCountingAllocator<char>>;
+using TCountedSimpleString = CSimpleString<char, CCountingAllocator<char>>;
+
+/**
+ * @brief Report string allocations done since the given snapshot as per iteration counters.
+ */
+void reportAllocations(benchmark::State& aState, const CAllocationSnapshot& aStart)
+{
+    const auto diff = CAllocationStatistics::instance().snapshot() - aStart;
+    aState.counters["allocs/iter"] = benchmark::Counter(
+        static_cast<double>(diff.mAllocations), benchmark::Counter::kAvgIterations);
+    aState.counters["bytes/iter"] = benchmark::Counter(
+        static_cast<double>(diff.mAllocatedBytes), benchmark::Counter::kAvgIterations);
+}
+
 template<typename TType, typename TFunctor>
 void runner(benchmark::State& aState)
 {
     const auto words = getWords();
+    const auto start = CAllocationStatistics::instance().snapshot();
     while(aState.KeepRunning())
     {
         // Prevent optimisation.
@@ -162,31 +179,32 @@ void runner(benchmark::State& aState)
         // Force writing cached values into memory.
         benchmark::ClobberMemory();
     }
+    reportAllocations(aState, start);
 }
 
 template<typename T>
 void Benchmark_String(benchmark::State& aState)
 {
-    runner<std::string, T>(aState);
+    runner<TCountedString, T>(aState);
 }
 
 template<typename T>
 void Benchmark_StringOpt10(benchmark::State& aState)
 {
-    runner<CSmallStringOpt<10u>, T>(aState);
+    runner<TCountedStringOpt10, T>(aState);
 }
 
 template<typename T>
 void Benchmark_StringOpt20(benchmark::State& aState)
 {
-    runner<CSmallStringOpt<20u>, T>(aState);
+    runner<TCountedStringOpt20, T>(aState);
 }
 
 
 template<typename T>
 void Benchmark_SimpleString(benchmark::State& aState)
 {
-    runner<CSimpleString<>, T>(aState);
+    runner<TCountedSimpleString, T>(aState);
 }
 
 
@@ -200,6 +218,9 @@ BENCHMARK_TEMPLATE(Benchmark_String, CIncreasedWordToMap);
 BENCHMARK_TEMPLATE(Benchmark_StringOpt10, CIncreasedWordToMap);
 BENCHMARK_TEMPLATE(Benchmark_StringOpt20, CIncreasedWordToMap);
 BENCHMARK_TEMPLATE(Benchmark_SimpleString, CIncreasedWordToMap);
+BENCHMARK_TEMPLATE(Benchmark_StringOpt10, CIncreasedWordInPlaceToMap);
+BENCHMARK_TEMPLATE(Benchmark_StringOpt20, CIncreasedWordInPlaceToMap);
+BENCHMARK_TEMPLATE(Benchmark_SimpleString, CIncreasedWordInPlaceToMap);
 
 
 BENCHMARK_TEMPLATE(Benchmark_String, CSumWordToMap);
@@ -207,5 +228,1106 @@ BENCHMARK_TEMPLATE(Benchmark_StringOpt10, CSumWordToMap);
 BENCHMARK_TEMPLATE(Benchmark_StringOpt20, CSumWordToMap);
 BENCHMARK_TEMPLATE(Benchmark_SimpleString, CSumWordToMap);
 
+// ---------------
+
+using TCountedCowStringOpt20 = CSmallStringOpt<20u, char, CCountingAllocator<char>, CCopyOnWritePolicy>;
+
+/**
+ * @brief Return snapshot of big strings: lines of the text joined into strings of about 4KB.
+ */
+template<typename T>
+const std::vector<T>& getSnapshot()
+{
+    static const std::vector<T> output = []()
+    {
+        std::vector<T> strings;
+        T buffer;
+        for (const auto& line : getLines())
+        {
+            buffer.append(line.data(), line.size());
+            if (buffer.size() > 4096u)
+            {
+                strings.emplace_back(buffer);
+                buffer.assign("");
+            }
+        }
+        return strings;
+    }();
+    return output;
+}
+
+/**
+ * @brief Every thread copies the shared snapshot of big strings and reads characters of the copies.
+ */
+template<typename T>
+void Benchmark_CopySnapshot(benchmark::State& aState)
+{
+    const auto& snapshot = getSnapshot<T>();
+    std::size_t bytes = 0u;
+    for (auto _ : aState)
+    {
+        std::vector<T> copy;
+        copy.reserve(snapshot.size());
+        for (const auto& str : snapshot)
+        {
+            copy.emplace_back(str);
+        }
+        unsigned int sum = 0u;
+        for (const auto& str : copy)
+        {
+            const char* ptr = str.data();
+            for (std::size_t i = 0u; i < str.size(); i += 64u)
+            {
+                sum += static_cast<unsigned char>(ptr[i]);
+            }
+            bytes += str.size();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    aState.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+BENCHMARK_TEMPLATE(Benchmark_CopySnapshot, TCountedStringOpt20)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(Benchmark_CopySnapshot, TCountedCowStringOpt20)->ThreadRange(1, 8)->UseRealTime();
+
+// ---------------
+
+/**
+ * @brief Append words until the string has the given number of characters.
+ */
+template<typename T>
+void Benchmark_AppendWords(benchmark::State& aState)
+{
+    const auto& words = getWords();
+    const auto length = static_cast<std::size_t>(aState.range(0));
+    for (auto _ : aState)
+    {
+        T output;
+        std::size_t i = 0u;
+        while (output.size() < length)
+        {
+            const auto& word = words[i++ % words.size()];
+            output.append(word.data(), word.size());
+        }
+        benchmark::DoNotOptimize(output.size());
+    }
+    aState.SetBytesProcessed(static_cast<int64_t>(aState.iterations() * length));
+}
+
+/**
+ * @brief Insert 1KB blocks in the middle until the string has the given number of characters.
+ */
+template<typename T>
+void Benchmark_InsertMiddle(benchmark::State& aState)
+{
+    std::string block;
+    for (const auto& line : getLines())
+    {
+        block += line;
+        if (block.size() >= 1024u)
+        {
+            break;
+        }
+    }
+    block.resize(1024u);
+    const auto length = static_cast<std::size_t>(aState.range(0));
+    for (auto _ : aState)
+    {
+        T output;
+        while (output.size() < length)
+        {
+            output.insert(output.size() / 2u, block.data(), block.size());
+        }
+        benchmark::DoNotOptimize(output.size());
+    }
+    aState.SetBytesProcessed(static_cast<int64_t>(aState.iterations() * length));
+}
+
+// exact-fit growth of CSimpleString and memmove of std::string::insert are quadratic, so they use smaller sizes
+BENCHMARK_TEMPLATE(Benchmark_AppendWords, CRope<char>)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK_TEMPLATE(Benchmark_AppendWords, std::string)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK_TEMPLATE(Benchmark_AppendWords, CSimpleString<char>)->Arg(1 << 10)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(Benchmark_InsertMiddle, CRope<char>)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK_TEMPLATE(Benchmark_InsertMiddle, std::string)->Arg(1 << 10)->Arg(1 << 17)->Arg(1 << 20);
+
+/**
+ * @brief Copy a rope of words of the given number of characters to a contiguous string.
+ */
+template<typename T>
+void Benchmark_RopeFlatten(benchmark::State& aState)
+{
+    const auto& words = getWords();
+    const auto length = static_cast<std::size_t>(aState.range(0));
+    CRope<char> rope;
+    for (std::size_t i = 0u; rope.size() < length; ++i)
+    {
+        const auto& word = words[i % words.size()];
+        rope.append(word.data(), word.size());
+    }
+    for (auto _ : aState)
+    {
+        const T output = rope.flatten<T>();
+        benchmark::DoNotOptimize(output.data());
+    }
+    aState.SetBytesProcessed(static_cast<int64_t>(aState.iterations() * length));
+}
+
+BENCHMARK_TEMPLATE(Benchmark_RopeFlatten, std::string)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK_TEMPLATE(Benchmark_RopeFlatten, CSimpleString<char>)->Arg(1 << 20)->Arg(100 << 20);
+
+// ---------------
+
+/**
+ * @brief Count fields of every line separated by any of delimiters.
+ */
+template<typename T>
+void Benchmark_Tokenize(benchmark::State& aState)
+{
+    std::vector<T> lines;
+    for (const auto& line : getLines())
+    {
+        lines.emplace_back(line.data(), line.size());
+    }
+    for (auto _ : aState)
+    {
+        std::size_t fields = 0u;
+        for (const auto& line : lines)
+        {
+            std::size_t pos = line.find_first_not_of(" ,.;:!?");
+            while (pos != T::npos)
+            {
+                ++fields;
+                const auto end = line.find_first_of(" ,.;:!?", pos);
+                pos = end == T::npos ? T::npos : line.find_first_not_of(" ,.;:!?", end);
+            }
+        }
+        benchmark::DoNotOptimize(fields);
+    }
+}
+
+BENCHMARK_TEMPLATE(Benchmark_Tokenize, std::string);
+BENCHMARK_TEMPLATE(Benchmark_Tokenize, CSmallStringOpt<20u>);
+BENCHMARK_TEMPLATE(Benchmark_Tokenize, CSimpleString<char>);
+
+// ---------------
+
+/**
+ * @brief Return the whole text and needles: every 500th word and 40 characters long fragments of the text.
+ */
+const std::pair<std::string, std::vector<std::string>>& getTextAndNeedles()
+{
+    static const std::pair<std::string, std::vector<std::string>> output = []()
+    {
+        std::pair<std::string, std::vector<std::string>> result;
+        for (const auto& line : getLines())
+        {
+            result.first += line;
+            result.first += '\n';
+        }
+        const auto& words = getWords();
+        for (std::size_t i = 0u; i < words.size(); i += 500u)
+        {
+            result.second.push_back(words[i]);
+        }
+        for (std::size_t i = 1u; i <= 10u; ++i)
+        {
+            result.second.push_back(result.first.substr(result.first.size() * i / 11u, 40u));
+        }
+        return result;
+    }();
+    return output;
+}
+
+/**
+ * @brief Count occurrences of needles in the whole text.
+ */
+template<typename T>
+void Benchmark_FindInText(benchmark::State& aState)
+{
+    const auto& textAndNeedles = getTextAndNeedles();
+    const T text{textAndNeedles.first.data(), textAndNeedles.first.size()};
+    for (auto _ : aState)
+    {
+        std::size_t count = 0u;
+        for (const auto& needle : textAndNeedles.second)
+        {
+            for (auto pos = text.find(needle); pos != T::npos; pos = text.find(needle, pos + 1u))
+            {
+                ++count;
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+/**
+ * @brief Count occurrences of needles in the whole text using searchers built once.
+ */
+void Benchmark_FindInTextSearcher(benchmark::State& aState)
+{
+    const auto& textAndNeedles = getTextAndNeedles();
+    const CSimpleString<char> text{textAndNeedles.first.data(), textAndNeedles.first.size()};
+    std::vector<CSearcher<char>> searchers;
+    for (const auto& needle : textAndNeedles.second)
+    {
+        searchers.emplace_back(needle);
+    }
+    for (auto _ : aState)
+    {
+        std::size_t count = 0u;
+        for (const auto& searcher : searchers)
+        {
+            for (auto pos = text.find(searcher); pos != text.npos; pos = text.find(searcher, pos + 1u))
+            {
+                ++count;
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+BENCHMARK_TEMPLATE(Benchmark_FindInText, std::string);
+BENCHMARK_TEMPLATE(Benchmark_FindInText, CSimpleString<char>);
+BENCHMARK(Benchmark_FindInTextSearcher);
+
+// ---------------
+
+/**
+ * @brief Return 3000 distinct words of the poem as keywords.
+ */
+const std::vector<CSmallStringOpt<20>>& getKeywords()
+{
+    static const std::vector<CSmallStringOpt<20>> output = []()
+    {
+        std::vector<CSmallStringOpt<20>> result;
+        std::set<std::string> seen;
+        for (const auto& word : getWords())
+        {
+            if (result.size() < 3000u && seen.insert(word).second)
+            {
+                result.emplace_back(word.data(), word.size());
+            }
+        }
+        return result;
+    }();
+    return output;
+}
+
+/**
+ * @brief Count keywords in each line of the poem (message) by searching each keyword separately.
+ */
+void Benchmark_KeywordsFindLoop(benchmark::State& aState)
+{
+    const auto& keywords = getKeywords();
+    for (auto _ : aState)
+    {
+        std::size_t count = 0u;
+        for (const auto& line : getLines())
+        {
+            for (const auto& keyword : keywords)
+            {
+                for (auto pos = line.find(keyword.data(), 0u, keyword.size()); pos != std::string::npos;
+                    pos = line.find(keyword.data(), pos + 1u, keyword.size()))
+                {
+                    ++count;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+/**
+ * @brief Count keywords in each line of the poem (message) in a single pass with CMultiMatcher.
+ */
+void Benchmark_KeywordsMultiMatcher(benchmark::State& aState)
+{
+    const CMultiMatcher<char> matcher{getKeywords()};
+    for (auto _ : aState)
+    {
+        std::size_t count = 0u;
+        for (const auto& line : getLines())
+        {
+            matcher.findAll(line, [&count](const CMultiMatcher<char>::CMatch&) { ++count; });
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+BENCHMARK(Benchmark_KeywordsFindLoop)->Unit(benchmark::kMillisecond);
+BENCHMARK(Benchmark_KeywordsMultiMatcher)->Unit(benchmark::kMillisecond);
+
+// ---------------
+
+/**
+ * @brief Build "user:<id>" keys by appending std::to_string(id).
+ */
+template<typename T>
+void Benchmark_KeyToString(benchmark::State& aState)
+{
+    const auto start = CAllocationStatistics::instance().snapshot();
+    std::uint64_t id = 1000000u;
+    for (auto _ : aState)
+    {
+        T key{"user:"};
+        key.append(std::to_string(id++));
+        benchmark::DoNotOptimize(key.data());
+    }
+    reportAllocations(aState, start);
+}
+
+/**
+ * @brief Build "user:<id>" keys by append_number, that formats directly into the string.
+ */
+template<typename T>
+void Benchmark_KeyAppendNumber(benchmark::State& aState)
+{
+    const auto start = CAllocationStatistics::instance().snapshot();
+    std::uint64_t id = 1000000u;
+    for (auto _ : aState)
+    {
+        T key{"user:"};
+        key.append_number(id++);
+        benchmark::DoNotOptimize(key.data());
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_KeyToString, TCountedString);
+BENCHMARK_TEMPLATE(Benchmark_KeyToString, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_KeyAppendNumber, TCountedStringOpt20);
+
+// ---------------
+
+/**
+ * @brief Build a log message by std::ostringstream and convert it to CSmallStringOpt.
+ */
+void Benchmark_OStringStream(benchmark::State& aState)
+{
+    const auto& words = getWords();
+    std::size_t i = 0u;
+    for (auto _ : aState)
+    {
+        std::ostringstream stream;
+        stream << "user " << i << " said " << words[i % words.size()];
+        const std::string message = stream.str();
+        const CSmallStringOpt<32> str{message.data(), message.size()};
+        benchmark::DoNotOptimize(str.data());
+        ++i;
+    }
+}
+
+/**
+ * @brief Build a log message by CStringOStream directly in CSmallStringOpt.
+ */
+void Benchmark_StringOStream(benchmark::State& aState)
+{
+    const auto& words = getWords();
+    std::size_t i = 0u;
+    for (auto _ : aState)
+    {
+        CSmallStringOpt<32> str;
+        {
+            CStringOStream<CSmallStringOpt<32>> stream{str};
+            stream << "user " << i << " said " << words[i % words.size()];
+        }
+        benchmark::DoNotOptimize(str.data());
+        ++i;
+    }
+}
+
+BENCHMARK(Benchmark_OStringStream);
+BENCHMARK(Benchmark_StringOStream);
+
+// ---------------
+
+/**
+ * @brief Read the poem line by line into a single string object (getline).
+ */
+template<typename T>
+void Benchmark_ReadLines(benchmark::State& aState)
+{
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        std::ifstream file{gFilePath};
+        std::size_t length = 0u;
+        for (T line; getline(file, line); )
+        {
+            length += line.size();
+        }
+        benchmark::DoNotOptimize(length);
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_ReadLines, TCountedString);
+BENCHMARK_TEMPLATE(Benchmark_ReadLines, TCountedStringOpt10);
+BENCHMARK_TEMPLATE(Benchmark_ReadLines, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_ReadLines, TCountedSimpleString);
+
+// ---------------
+
+/**
+ * @brief Edit-heavy workload: every word is turned into a short path by insert, replace, erase, push_back and
+ * pop_back; most results fit into the small string optimization array of 20 characters.
+ */
+template<typename T>
+void Benchmark_EditWords(benchmark::State& aState)
+{
+    const auto& words = getWords();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        std::size_t length = 0u;
+        T str;
+        for (const auto& word : words)
+        {
+            str.clear();
+            str.insert(0u, word.c_str());
+            str.insert(0u, "/usr/");
+            str.replace(1u, 3u, "opt");
+            str.push_back('/');
+            str.erase(str.size() / 2u, 1u);
+            str.insert(str.size() / 2u, 2u, '_');
+            str.pop_back();
+            length += str.size();
+        }
+        benchmark::DoNotOptimize(length);
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_EditWords, TCountedString);
+BENCHMARK_TEMPLATE(Benchmark_EditWords, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_EditWords, TCountedSimpleString);
+
+// ---------------
+
+/**
+ * @brief Tokenize lines into words by std::string::find, allocating std::string per word (the former tokenizer).
+ */
+void Benchmark_TokenizeFind(benchmark::State& aState)
+{
+    const auto& lines = getLines();
+    for (auto _ : aState)
+    {
+        std::size_t length = 0u;
+        for (const auto& line : lines)
+        {
+            std::size_t index = 0u;
+            for (std::size_t pos = line.find(' '); pos != std::string::npos; pos = line.find(' ', index))
+            {
+                if (pos > index)
+                {
+                    const std::string word{trimWord(std::string_view{line.data() + index, pos - index})};
+                    length += word.size();
+                }
+                index = pos + 1u;
+            }
+            const std::string word{line.data() + index, line.size() - index};
+            length += word.size();
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+/**
+ * @brief Tokenize lines into words by NSSO::split: words are views of lines, nothing is allocated.
+ */
+void Benchmark_TokenizeSplit(benchmark::State& aState)
+{
+    const auto& lines = getLines();
+    for (auto _ : aState)
+    {
+        std::size_t length = 0u;
+        for (const auto& line : lines)
+        {
+            const char* const lineEnd = line.data() + line.size();
+            for (const std::string_view piece : split(line, ' '))
+            {
+                length += piece.data() + piece.size() == lineEnd ? piece.size() : trimWord(piece).size();
+            }
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+BENCHMARK(Benchmark_TokenizeFind);
+BENCHMARK(Benchmark_TokenizeSplit);
+
+// ---------------
+
+/**
+ * @brief Return a record of fields (words) to join.
+ */
+const std::vector<std::string>& getRecord()
+{
+    static const std::vector<std::string> output(getWords().begin(), getWords().begin() + 24);
+    return output;
+}
+
+/**
+ * @brief Build a CSV record by appending fields and separators one by one.
+ */
+template<typename T>
+void Benchmark_JoinAppend(benchmark::State& aState)
+{
+    const auto& record = getRecord();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        T line;
+        for (std::size_t i = 0u; i < record.size(); ++i)
+        {
+            if (i != 0u)
+            {
+                line.append(",", 1u);
+            }
+            line.append(record[i].data(), record[i].size());
+        }
+        benchmark::DoNotOptimize(line.data());
+    }
+    reportAllocations(aState, start);
+}
+
+/**
+ * @brief Build a CSV record by NSSO::join: the total length is computed first, memory is allocated once.
+ */
+template<typename T>
+void Benchmark_Join(benchmark::State& aState)
+{
+    const auto& record = getRecord();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        const T line = join<T>(record, ',');
+        benchmark::DoNotOptimize(line.data());
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_JoinAppend, TCountedString);
+BENCHMARK_TEMPLATE(Benchmark_JoinAppend, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_JoinAppend, TCountedSimpleString);
+BENCHMARK_TEMPLATE(Benchmark_Join, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_Join, TCountedSimpleString);
+
+// ---------------
+
+/**
+ * @brief Replace every occurrence of aFrom by aTo by find and replace, one occurrence at a time.
+ */
+template<typename T>
+void replaceLoop(T& aStr, const char* aFrom, const char* aTo)
+{
+    const std::size_t fromLength = std::strlen(aFrom);
+    const std::size_t toLength = std::strlen(aTo);
+    for (std::size_t pos = aStr.find(aFrom, 0u); pos != T::npos; pos = aStr.find(aFrom, pos + toLength))
+    {
+        aStr.replace(pos, fromLength, aTo);
+    }
+}
+
+/**
+ * @brief Escape lines of the poem by find and replace in a loop.
+ */
+template<typename T>
+void Benchmark_ReplaceLoop(benchmark::State& aState)
+{
+    const auto& lines = getLines();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        std::size_t length = 0u;
+        for (const auto& line : lines)
+        {
+            T str{line.data(), line.size()};
+            for (std::size_t pos = str.find(' ', 0u); pos != T::npos; pos = str.find(' ', pos + 1u))
+            {
+                str[pos] = '_';
+            }
+            replaceLoop(str, "ie", "IE");
+            replaceLoop(str, "&", "&amp;");
+            replaceLoop(str, ",", "&#44;");
+            length += str.size();
+        }
+        benchmark::DoNotOptimize(length);
+    }
+    reportAllocations(aState, start);
+}
+
+/**
+ * @brief Escape lines of the poem by replace_all.
+ */
+template<typename T>
+void Benchmark_ReplaceAll(benchmark::State& aState)
+{
+    const auto& lines = getLines();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        std::size_t length = 0u;
+        for (const auto& line : lines)
+        {
+            T str{line.data(), line.size()};
+            str.replace_all(' ', '_');
+            str.replace_all("ie", "IE");
+            str.replace_all("&", "&amp;");
+            str.replace_all(",", "&#44;");
+            length += str.size();
+        }
+        benchmark::DoNotOptimize(length);
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_ReplaceLoop, TCountedString);
+BENCHMARK_TEMPLATE(Benchmark_ReplaceLoop, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_ReplaceLoop, TCountedSimpleString);
+BENCHMARK_TEMPLATE(Benchmark_ReplaceAll, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_ReplaceAll, TCountedSimpleString);
+
+// ---------------
+
+/**
+ * @brief Push 1M strings (words of the corpus, short and long ones) into the vector without reserving, so the vector
+ * reallocates about 20 times. std::vector moves strings to the new memory only if their move constructor is noexcept,
+ * otherwise they are copied and every long one is allocated again. CStringVector copies bytes of trivially
+ * relocatable strings.
+ */
+template<typename TVector>
+void Benchmark_VectorGrowth(benchmark::State& aState)
+{
+    using T = typename TVector::value_type;
+    const auto& words = getWords();
+    const std::size_t count = 1000000u;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        TVector strings;
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            const auto& word = words[i % words.size()];
+            strings.push_back(T{word.data(), word.size()});
+        }
+        benchmark::DoNotOptimize(strings.data());
+    }
+    reportAllocations(aState, start);
+}
+
+/**
+ * @brief Build a sorted index of 5000 words by inserting each one at its lower bound, so about half of the strings
+ * are shifted by every insertion.
+ */
+template<typename TVector>
+void Benchmark_SortedInsert(benchmark::State& aState)
+{
+    using T = typename TVector::value_type;
+    const auto& words = getWords();
+    const std::size_t count = std::min<std::size_t>(5000u, words.size());
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        TVector strings;
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            T str{words[i].data(), words[i].size()};
+            const auto pos = std::lower_bound(strings.begin(), strings.end(), str,
+                [](const T& aStr1, const T& aStr2)
+                {
+                    return std::lexicographical_compare(aStr1.data(), aStr1.data() + aStr1.size(),
+                        aStr2.data(), aStr2.data() + aStr2.size());
+                });
+            strings.insert(pos, std::move(str));
+        }
+        benchmark::DoNotOptimize(strings.data());
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, std::vector<TCountedString>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, std::vector<TCountedStringOpt10>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, std::vector<TCountedStringOpt20>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, std::vector<TCountedSimpleString>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, CStringVector<TCountedStringOpt10>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, CStringVector<TCountedStringOpt20>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_VectorGrowth, CStringVector<TCountedSimpleString>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_SortedInsert, std::vector<TCountedString>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_SortedInsert, std::vector<TCountedStringOpt20>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_SortedInsert, std::vector<TCountedSimpleString>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_SortedInsert, CStringVector<TCountedStringOpt20>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Benchmark_SortedInsert, CStringVector<TCountedSimpleString>)->Unit(benchmark::kMillisecond);
+
+// ---------------
+
+/**
+ * @brief Reverse 10000 words in place: std::reverse swaps strings by the swap function found by argument dependent
+ * lookup, std::swap (move construction and 2 move assignments) is used if there is none.
+ */
+template<typename T>
+void Benchmark_SwapReverse(benchmark::State& aState)
+{
+    const auto& words = getWords();
+    std::vector<T> strings;
+    for (std::size_t i = 0u; i < std::min<std::size_t>(10000u, words.size()); ++i)
+    {
+        strings.emplace_back(words[i].data(), words[i].size());
+    }
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        std::reverse(strings.begin(), strings.end());
+        benchmark::DoNotOptimize(strings.data());
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_SwapReverse, TCountedString);
+BENCHMARK_TEMPLATE(Benchmark_SwapReverse, TCountedStringOpt10);
+BENCHMARK_TEMPLATE(Benchmark_SwapReverse, TCountedStringOpt20);
+BENCHMARK_TEMPLATE(Benchmark_SwapReverse, TCountedSimpleString);
+
+// ---------------
+
+/**
+ * @brief Keywords the words of the corpus are dispatched against, as null terminated texts.
+ */
+const char* const gDispatchKeywords[] = {
+    "pan", "tadeusz", "litwo", "ojczyzno", "moja", "ty", "jestes", "jak", "zdrowie", "ile", "cie", "trzeba",
+    "cenic", "ten", "tylko", "sie", "dowie", "kto", "stracil", "dzis", "pieknosc", "twa", "calej", "ozdobie",
+    "widze", "opisuje", "bo", "tesknie", "po", "tobie", "panno", "swieta"};
+
+/**
+ * @brief The same keywords as literals with length and hash computed at compile time.
+ */
+constexpr CStaticString<char> gDispatchStaticKeywords[] = {
+    "pan"_sso, "tadeusz"_sso, "litwo"_sso, "ojczyzno"_sso, "moja"_sso, "ty"_sso, "jestes"_sso, "jak"_sso,
+    "zdrowie"_sso, "ile"_sso, "cie"_sso, "trzeba"_sso, "cenic"_sso, "ten"_sso, "tylko"_sso, "sie"_sso, "dowie"_sso,
+    "kto"_sso, "stracil"_sso, "dzis"_sso, "pieknosc"_sso, "twa"_sso, "calej"_sso, "ozdobie"_sso, "widze"_sso,
+    "opisuje"_sso, "bo"_sso, "tesknie"_sso, "po"_sso, "tobie"_sso, "panno"_sso, "swieta"_sso};
+
+/**
+ * @brief Return words of the corpus as CSmallStringOpt.
+ */
+const std::vector<CSmallStringOpt<20u>>& getDispatchWords()
+{
+    static const std::vector<CSmallStringOpt<20u>> words = []()
+    {
+        std::vector<CSmallStringOpt<20u>> output;
+        for (const auto& word : getWords())
+        {
+            output.emplace_back(word.data(), word.size());
+        }
+        return output;
+    }();
+    return words;
+}
+
+/**
+ * @brief Find the keyword of every word by operator== with a null terminated text (its length is counted each time).
+ */
+void Benchmark_DispatchCStr(benchmark::State& aState)
+{
+    const auto& words = getDispatchWords();
+    for (auto _ : aState)
+    {
+        std::size_t found = 0u;
+        for (const auto& word : words)
+        {
+            for (const char* keyword : gDispatchKeywords)
+            {
+                if (word == keyword)
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+/**
+ * @brief Find the keyword of every word by operator== with a literal of known length.
+ */
+void Benchmark_DispatchStatic(benchmark::State& aState)
+{
+    const auto& words = getDispatchWords();
+    for (auto _ : aState)
+    {
+        std::size_t found = 0u;
+        for (const auto& word : words)
+        {
+            for (const auto& keyword : gDispatchStaticKeywords)
+            {
+                if (word == keyword)
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+/**
+ * @brief Find the keyword of every word: the word is hashed once, then lengths and hashes are compared first.
+ */
+void Benchmark_DispatchStaticHash(benchmark::State& aState)
+{
+    const auto& words = getDispatchWords();
+    for (auto _ : aState)
+    {
+        std::size_t found = 0u;
+        for (const auto& word : words)
+        {
+            const std::uint64_t hash = hashOf(word);
+            for (const auto& keyword : gDispatchStaticKeywords)
+            {
+                if (keyword.equals(word.data(), word.size(), hash))
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK(Benchmark_DispatchCStr);
+BENCHMARK(Benchmark_DispatchStatic);
+BENCHMARK(Benchmark_DispatchStaticHash);
+
+// ---------------
+
+/**
+ * @brief Return lines of the corpus widened byte by byte to the given type of characters.
+ */
+template<typename TChar>
+const std::vector<std::basic_string<TChar>>& getWideLines()
+{
+    static const std::vector<std::basic_string<TChar>> lines = []()
+    {
+        std::vector<std::basic_string<TChar>> output;
+        for (const auto& line : getLines())
+        {
+            std::basic_string<TChar> wide;
+            for (const char c : line)
+            {
+                wide.push_back(static_cast<TChar>(static_cast<unsigned char>(c)));
+            }
+            output.push_back(std::move(wide));
+        }
+        return output;
+    }();
+    return lines;
+}
+
+/**
+ * @brief Count characters of null terminated lines: txtLength scans vectors of characters of every width,
+ * std::char_traits::length of char16_t and char32_t compares character by character.
+ */
+template<typename TChar, bool TVectorized>
+void Benchmark_Length(benchmark::State& aState)
+{
+    const auto& lines = getWideLines<TChar>();
+    for (auto _ : aState)
+    {
+        std::size_t length = 0u;
+        for (const auto& line : lines)
+        {
+            length += TVectorized ? txtLength(line.c_str()) : std::char_traits<TChar>::length(line.c_str());
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+/**
+ * @brief Construct strings of UTF-16 characters from null terminated lines, 32 bytes are kept inline.
+ */
+void Benchmark_ConstructUtf16(benchmark::State& aState)
+{
+    using TString = CSmallStringOptBytes<32u, char16_t, CCountingAllocator<char16_t>>;
+    const auto& lines = getWideLines<char16_t>();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        for (const auto& line : lines)
+        {
+            TString str{line.c_str()};
+            benchmark::DoNotOptimize(str.data());
+        }
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_Length, char16_t, false);
+BENCHMARK_TEMPLATE(Benchmark_Length, char16_t, true);
+BENCHMARK_TEMPLATE(Benchmark_Length, char32_t, false);
+BENCHMARK_TEMPLATE(Benchmark_Length, char32_t, true);
+BENCHMARK(Benchmark_ConstructUtf16);
+
+// ---------------
+
+/**
+ * @brief Validate lines of the poem (Polish text with many 2 byte code points) as UTF-8 and count their code points,
+ * with scalar (byte by byte) or vectorized kernels.
+ */
+template<typename TKernels>
+void Benchmark_Utf8Lines(benchmark::State& aState)
+{
+    using TUtf8 = CUtf8<char, TKernels>;
+    const auto& lines = getLines();
+    std::size_t bytes = 0u;
+    for (const auto& line : lines)
+    {
+        bytes += line.size();
+    }
+    for (auto _ : aState)
+    {
+        std::size_t valid = 0u;
+        std::size_t codePoints = 0u;
+        for (const auto& line : lines)
+        {
+            valid += TUtf8::isValid(line.data(), line.size()) ? 1u : 0u;
+            codePoints += TUtf8::countCodePoints(line.data(), line.size());
+        }
+        benchmark::DoNotOptimize(valid);
+        benchmark::DoNotOptimize(codePoints);
+    }
+    aState.SetBytesProcessed(static_cast<std::int64_t>(aState.iterations() * bytes));
+}
+
+/**
+ * @brief Validate the whole poem as one UTF-8 text and count its code points.
+ */
+template<typename TKernels>
+void Benchmark_Utf8Text(benchmark::State& aState)
+{
+    using TUtf8 = CUtf8<char, TKernels>;
+    std::string text;
+    for (const auto& line : getLines())
+    {
+        text += line;
+        text += '\n';
+    }
+    for (auto _ : aState)
+    {
+        benchmark::DoNotOptimize(TUtf8::isValid(text.data(), text.size()));
+        benchmark::DoNotOptimize(TUtf8::countCodePoints(text.data(), text.size()));
+    }
+    aState.SetBytesProcessed(static_cast<std::int64_t>(aState.iterations() * text.size()));
+}
+
+/**
+ * @brief Validate words of the poem, most of them are short: all-ASCII words are handled inline.
+ */
+void Benchmark_Utf8Words(benchmark::State& aState)
+{
+    const auto& words = getDispatchWords();
+    for (auto _ : aState)
+    {
+        std::size_t valid = 0u;
+        for (const auto& word : words)
+        {
+            valid += word.is_valid_utf8() ? 1u : 0u;
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+}
+
+BENCHMARK_TEMPLATE(Benchmark_Utf8Lines, CScalarUtf8);
+BENCHMARK_TEMPLATE(Benchmark_Utf8Lines, CSimdUtf8);
+BENCHMARK_TEMPLATE(Benchmark_Utf8Text, CScalarUtf8);
+BENCHMARK_TEMPLATE(Benchmark_Utf8Text, CSimdUtf8);
+BENCHMARK(Benchmark_Utf8Words);
+
+// ---------------
+
+/**
+ * @brief Return lines of the poem transcoded from UTF-8 to the given type of characters.
+ */
+template<typename TChar>
+const std::vector<CSimpleString<TChar>>& getTranscodedLines()
+{
+    static const std::vector<CSimpleString<TChar>> lines = []()
+    {
+        std::vector<CSimpleString<TChar>> output;
+        for (const auto& line : getLines())
+        {
+            output.push_back(transcode<CSimpleString<TChar>>(line));
+        }
+        return output;
+    }();
+    return lines;
+}
+
+/**
+ * @brief Transcode lines of the poem into CSmallStringOptBytes of 32 bytes by the scalar or SSE2 transcoder.
+ */
+template<typename TIn, typename TOut, template<typename, typename> class TTranscoder>
+void Benchmark_Transcode(benchmark::State& aState)
+{
+    using TString = CSmallStringOptBytes<32u, TOut, CCountingAllocator<TOut>>;
+    const auto& lines = getTranscodedLines<TIn>();
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (auto _ : aState)
+    {
+        for (const auto& line : lines)
+        {
+            TString str;
+            transcode_to<TString, CSimpleString<TIn>, TTranscoder<TIn, TOut>>(str, line);
+            benchmark::DoNotOptimize(str.data());
+        }
+    }
+    reportAllocations(aState, start);
+}
+
+BENCHMARK_TEMPLATE(Benchmark_Transcode, char, char16_t, CScalarTranscoder);
+BENCHMARK_TEMPLATE(Benchmark_Transcode, char, char16_t, CSimdTranscoder);
+BENCHMARK_TEMPLATE(Benchmark_Transcode, char16_t, char, CScalarTranscoder);
+BENCHMARK_TEMPLATE(Benchmark_Transcode, char16_t, char, CSimdTranscoder);
+BENCHMARK_TEMPLATE(Benchmark_Transcode, char16_t, char32_t, CScalarTranscoder);
+BENCHMARK_TEMPLATE(Benchmark_Transcode, char16_t, char32_t, CSimdTranscoder);
+
+// ---------------
+
+#if defined(__cpp_lib_format)
+
+/**
+ * @brief Format a short log message by std::format into std::string and copy it into CSmallStringOpt.
+ */
+void Benchmark_FormatCopy(benchmark::State& aState)
+{
+    int id = 0;
+    for (auto _ : aState)
+    {
+        const std::string message = std::format("req {} took {}ms", id++, 17);
+        const CSmallStringOpt<32> str{message.data(), message.size()};
+        benchmark::DoNotOptimize(str.data());
+    }
+}
+
+/**
+ * @brief Format a short log message directly into CSmallStringOpt.
+ */
+void Benchmark_FormatDirect(benchmark::State& aState)
+{
+    int id = 0;
+    for (auto _ : aState)
+    {
+        const auto str = NSSO::format<32>("req {} took {}ms", id++, 17);
+        benchmark::DoNotOptimize(str.data());
+    }
+}
+
+BENCHMARK(Benchmark_FormatCopy);
+BENCHMARK(Benchmark_FormatDirect);
+
+#endif // __cpp_lib_format
+
 BENCHMARK_MAIN();
 
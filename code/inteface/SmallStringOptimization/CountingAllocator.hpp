@@ -0,0 +1,384 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Allocator wrapper that gathers global allocation statistics.
+ */
+
+#ifndef COUNTING_ALLOCATOR_HPP_
+#define COUNTING_ALLOCATOR_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "Relocation.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Snapshot of allocation statistics. Two snapshots can be subtracted to get statistics of the code between them.
+ */
+struct CAllocationSnapshot
+{
+    /**
+     * @brief Number of histogram buckets. Bucket i counts allocations of [2^i, 2^(i+1)) bytes, the last one counts everything bigger.
+     */
+    static constexpr std::size_t sHistogramSize = 32u;
+
+    /**
+     * @brief Number of allocations.
+     */
+    std::uint64_t mAllocations = 0u;
+
+    /**
+     * @brief Number of deallocations.
+     */
+    std::uint64_t mDeallocations = 0u;
+
+    /**
+     * @brief Number of allocated bytes in total.
+     */
+    std::uint64_t mAllocatedBytes = 0u;
+
+    /**
+     * @brief Number of bytes allocated, but not deallocated yet.
+     */
+    std::int64_t mLiveBytes = 0;
+
+    /**
+     * @brief The highest value of mLiveBytes since the last reset.
+     */
+    std::int64_t mPeakBytes = 0;
+
+    /**
+     * @brief Histogram of allocation sizes.
+     */
+    std::array<std::uint64_t, sHistogramSize> mSizeHistogram{};
+
+    /**
+     * @brief Return statistics of operations done between the given snapshot and this one. Peak value is taken from this snapshot.
+     *
+     * @param aEarlier Snapshot taken earlier.
+     * @return Difference of snapshots.
+     */
+    CAllocationSnapshot operator-(const CAllocationSnapshot& aEarlier) const noexcept
+    {
+        CAllocationSnapshot output{*this};
+        output.mAllocations -= aEarlier.mAllocations;
+        output.mDeallocations -= aEarlier.mDeallocations;
+        output.mAllocatedBytes -= aEarlier.mAllocatedBytes;
+        output.mLiveBytes -= aEarlier.mLiveBytes;
+        for (std::size_t i = 0u; i < sHistogramSize; ++i)
+        {
+            output.mSizeHistogram[i] -= aEarlier.mSizeHistogram[i];
+        }
+        return output;
+    }
+};
+
+/**
+ * @brief Global allocation statistics shared by all CCountingAllocator instances. Thread safe.
+ */
+class CAllocationStatistics
+{
+private:
+
+    /**
+     * @brief Number of allocations.
+     */
+    std::atomic<std::uint64_t> mAllocations{0u};
+
+    /**
+     * @brief Number of deallocations.
+     */
+    std::atomic<std::uint64_t> mDeallocations{0u};
+
+    /**
+     * @brief Number of allocated bytes in total.
+     */
+    std::atomic<std::uint64_t> mAllocatedBytes{0u};
+
+    /**
+     * @brief Number of bytes allocated, but not deallocated yet.
+     */
+    std::atomic<std::int64_t> mLiveBytes{0};
+
+    /**
+     * @brief The highest value of mLiveBytes.
+     */
+    std::atomic<std::int64_t> mPeakBytes{0};
+
+    /**
+     * @brief Histogram of allocation sizes.
+     */
+    std::array<std::atomic<std::uint64_t>, CAllocationSnapshot::sHistogramSize> mSizeHistogram{};
+
+    /**
+     * @brief Return histogram bucket for the given size.
+     *
+     * @param aBytes Size in bytes.
+     * @return Index of bucket.
+     */
+    static std::size_t bucket(std::size_t aBytes) noexcept
+    {
+        std::size_t index = 0u;
+        while (aBytes > 1u && index + 1u < CAllocationSnapshot::sHistogramSize)
+        {
+            aBytes >>= 1u;
+            ++index;
+        }
+        return index;
+    }
+
+public:
+
+    /**
+     * @brief Return the global instance.
+     *
+     * @return The global instance.
+     */
+    static CAllocationStatistics& instance() noexcept
+    {
+        static CAllocationStatistics sInstance;
+        return sInstance;
+    }
+
+    /**
+     * @brief Record allocation.
+     *
+     * @param aBytes Number of allocated bytes.
+     */
+    void onAllocate(std::size_t aBytes) noexcept
+    {
+        mAllocations.fetch_add(1u, std::memory_order_relaxed);
+        mAllocatedBytes.fetch_add(aBytes, std::memory_order_relaxed);
+        mSizeHistogram[bucket(aBytes)].fetch_add(1u, std::memory_order_relaxed);
+        const std::int64_t live = mLiveBytes.fetch_add(static_cast<std::int64_t>(aBytes), std::memory_order_relaxed)
+            + static_cast<std::int64_t>(aBytes);
+        std::int64_t peak = mPeakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !mPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @brief Record deallocation.
+     *
+     * @param aBytes Number of deallocated bytes.
+     */
+    void onDeallocate(std::size_t aBytes) noexcept
+    {
+        mDeallocations.fetch_add(1u, std::memory_order_relaxed);
+        mLiveBytes.fetch_sub(static_cast<std::int64_t>(aBytes), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Return current statistics.
+     *
+     * @return Current statistics.
+     */
+    CAllocationSnapshot snapshot() const noexcept
+    {
+        CAllocationSnapshot output;
+        output.mAllocations = mAllocations.load(std::memory_order_relaxed);
+        output.mDeallocations = mDeallocations.load(std::memory_order_relaxed);
+        output.mAllocatedBytes = mAllocatedBytes.load(std::memory_order_relaxed);
+        output.mLiveBytes = mLiveBytes.load(std::memory_order_relaxed);
+        output.mPeakBytes = mPeakBytes.load(std::memory_order_relaxed);
+        for (std::size_t i = 0u; i < CAllocationSnapshot::sHistogramSize; ++i)
+        {
+            output.mSizeHistogram[i] = mSizeHistogram[i].load(std::memory_order_relaxed);
+        }
+        return output;
+    }
+
+    /**
+     * @brief Reset peak value to the current number of live bytes.
+     */
+    void resetPeak() noexcept
+    {
+        mPeakBytes.store(mLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Allocator that forwards to the inner allocator and records statistics in CAllocationStatistics.
+ *
+ * @tparam TChar Type of allocated elements.
+ * @tparam TInner Allocator that really allocates memory.
+ */
+template<typename TChar, typename TInner = std::allocator<TChar>>
+class CCountingAllocator
+{
+private:
+
+    /**
+     * @brief Inner allocator rebound to TChar.
+     */
+    using inner_type = typename std::allocator_traits<TInner>::template rebind_alloc<TChar>;
+
+    /**
+     * @brief Inner allocator traits.
+     */
+    using inner_traits = std::allocator_traits<inner_type>;
+
+    /**
+     * @brief Inner allocator.
+     */
+    inner_type mInner;
+
+    template<typename _TChar, typename _TInner>
+    friend class CCountingAllocator;
+
+public:
+
+    /**
+     * @brief Type of allocated elements.
+     */
+    using value_type = TChar;
+
+    /**
+     * @brief Size type.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Propagation is taken from the inner allocator.
+     */
+    using propagate_on_container_copy_assignment = typename inner_traits::propagate_on_container_copy_assignment;
+
+    /**
+     * @brief Propagation is taken from the inner allocator.
+     */
+    using propagate_on_container_move_assignment = typename inner_traits::propagate_on_container_move_assignment;
+
+    /**
+     * @brief Propagation is taken from the inner allocator.
+     */
+    using propagate_on_container_swap = typename inner_traits::propagate_on_container_swap;
+
+    /**
+     * @brief Equality is taken from the inner allocator.
+     */
+    using is_always_equal = typename inner_traits::is_always_equal;
+
+    /**
+     * @brief Rebind allocator to another type.
+     *
+     * @tparam TOther Other type.
+     */
+    template<typename TOther>
+    struct rebind
+    {
+        using other = CCountingAllocator<TOther, TInner>;
+    };
+
+    /**
+     * @brief Construct allocator.
+     */
+    CCountingAllocator() noexcept(noexcept(inner_type{}))
+        : mInner{}
+    {
+    }
+
+    /**
+     * @brief Construct allocator wrapping the given one.
+     *
+     * @param aInner Inner allocator.
+     */
+    explicit CCountingAllocator(const inner_type& aInner) noexcept
+        : mInner{aInner}
+    {
+    }
+
+    /**
+     * @brief Construct allocator from allocator of other type.
+     *
+     * @tparam TOther Other type.
+     * @tparam TOtherInner Inner allocator of the other allocator.
+     * @param aObj Allocator to copy.
+     */
+    template<typename TOther, typename TOtherInner>
+    CCountingAllocator(const CCountingAllocator<TOther, TOtherInner>& aObj) noexcept
+        : mInner{aObj.mInner}
+    {
+    }
+
+    /**
+     * @brief Allocate memory and record it.
+     *
+     * @param aLength Number of elements.
+     * @return Pointer to allocated memory.
+     */
+    TChar* allocate(size_type aLength)
+    {
+        TChar* ptr = inner_traits::allocate(mInner, aLength);
+        CAllocationStatistics::instance().onAllocate(aLength * sizeof(TChar));
+        return ptr;
+    }
+
+    /**
+     * @brief Deallocate memory and record it. Null pointers are not recorded.
+     *
+     * @param aPtr Pointer to memory to deallocate.
+     * @param aLength Number of elements.
+     */
+    void deallocate(TChar* aPtr, size_type aLength) noexcept
+    {
+        if (aPtr == nullptr)
+        {
+            return ;
+        }
+        CAllocationStatistics::instance().onDeallocate(aLength * sizeof(TChar));
+        inner_traits::deallocate(mInner, aPtr, aLength);
+    }
+
+    /**
+     * @brief Compare allocators.
+     *
+     * @tparam TOther Type of elements of the other allocator.
+     * @tparam TOtherInner Inner allocator of the other allocator.
+     * @param aObj Other allocator.
+     * @return true if memory allocated by one can be deallocated by the other one.
+     */
+    template<typename TOther, typename TOtherInner>
+    bool operator==(const CCountingAllocator<TOther, TOtherInner>& aObj) const noexcept
+    {
+        return mInner == aObj.mInner;
+    }
+
+    /**
+     * @brief Compare allocators.
+     *
+     * @tparam TOther Type of elements of the other allocator.
+     * @tparam TOtherInner Inner allocator of the other allocator.
+     * @param aObj Other allocator.
+     * @return true if memory allocated by one cannot be deallocated by the other one.
+     */
+    template<typename TOther, typename TOtherInner>
+    bool operator!=(const CCountingAllocator<TOther, TOtherInner>& aObj) const noexcept
+    {
+        return !(*this == aObj);
+    }
+};
+
+/**
+ * @brief CCountingAllocator is trivially relocatable if its inner allocator is.
+ *
+ * @tparam TChar Type of allocated elements.
+ * @tparam TInner Allocator that really allocates memory.
+ */
+template<typename TChar, typename TInner>
+struct CIsTriviallyRelocatable<CCountingAllocator<TChar, TInner>>
+    : CIsTriviallyRelocatable<typename std::allocator_traits<TInner>::template rebind_alloc<TChar>>
+{
+};
+
+} // namespace NSSO
+
+#endif // COUNTING_ALLOCATOR_HPP_
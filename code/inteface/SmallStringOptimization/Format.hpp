@@ -0,0 +1,213 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * std::format support: formatters of string types, formatting directly into CSmallStringOpt and CSimpleString.
+ * Available if the standard library provides std::format (C++20).
+ */
+
+#ifndef FORMAT_HPP_
+#define FORMAT_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#if defined(__has_include)
+#if __has_include(<format>)
+#include <format>
+#endif
+#endif
+#include "SmallStringOptimization.hpp"
+#include "SimpleString.hpp"
+
+#if defined(__cpp_lib_format)
+
+namespace NSSO
+{
+
+/**
+ * @brief Output iterator that appends characters to a string (like std::back_insert_iterator). Characters are written
+ * into the small string optimization array while they fit.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ */
+template<typename TString>
+class CAppendIterator
+{
+    /**
+     * @brief String to append to.
+     */
+    TString* mString;
+
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    /**
+     * @brief Construct iterator appending to the given string.
+     *
+     * @param aString String.
+     */
+    explicit CAppendIterator(TString& aString) noexcept
+        : mString{&aString}
+    {
+    }
+
+    /**
+     * @brief Append the given character.
+     *
+     * @param aChar Character.
+     * @return This iterator.
+     */
+    CAppendIterator& operator=(typename TString::value_type aChar)
+    {
+        *mString->grow_uninitialized(1u) = aChar;
+        mString->commit(mString->size() + 1u);
+        return *this;
+    }
+
+    CAppendIterator& operator*() noexcept
+    {
+        return *this;
+    }
+
+    CAppendIterator& operator++() noexcept
+    {
+        return *this;
+    }
+
+    CAppendIterator operator++(int) noexcept
+    {
+        return *this;
+    }
+};
+
+/**
+ * @brief Return iterator appending to the given string.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ * @param aString String.
+ * @return Append iterator.
+ */
+template<typename TString>
+CAppendIterator<TString> appender(TString& aString) noexcept
+{
+    return CAppendIterator<TString>{aString};
+}
+
+/**
+ * @brief Number of characters expected for each formatted argument if the string has no spare memory.
+ */
+constexpr std::size_t gFormatArgumentLength = 16u;
+
+/**
+ * @brief Append formatted text to the given string. The text is formatted once directly into spare memory of string
+ * (the small string optimization array for short strings), or into memory grown by an estimated length. Only if the
+ * text doesn't fit, memory grows once to the exact length and the text is formatted again.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ * @tparam TArgs Types of arguments.
+ * @param aString String to append to.
+ * @param aFormat Format string.
+ * @param aArgs Arguments.
+ */
+template<typename TString, typename... TArgs>
+void format_to(TString& aString,
+    std::basic_format_string<typename TString::value_type, std::type_identity_t<TArgs&>...> aFormat, TArgs&&... aArgs)
+{
+    using size_type = typename TString::size_type;
+    const size_type size = aString.size();
+    const size_type capacity = aString.capacity();
+    size_type estimate = capacity > size + 1u ? capacity - size - 1u : 0u;
+    if (estimate == 0u)
+    {
+        estimate = aFormat.get().size() + gFormatArgumentLength * sizeof...(TArgs);
+    }
+    auto* ptr = aString.grow_uninitialized(estimate);
+    // arguments are passed as lvalues, because they are formatted twice if the estimate is too small
+    const auto result = std::format_to_n(ptr, static_cast<std::ptrdiff_t>(estimate), aFormat, aArgs...);
+    const size_type length = static_cast<size_type>(result.size);
+    if (length > estimate)
+    {
+        ptr = aString.grow_uninitialized(length);
+        std::format_to(ptr, aFormat, aArgs...);
+    }
+    aString.commit(size + length);
+}
+
+/**
+ * @brief Format text into a new CSmallStringOpt.
+ *
+ * @tparam TSmallStringOptLength Number of characters of the small string optimization array.
+ * @tparam TArgs Types of arguments.
+ * @param aFormat Format string.
+ * @param aArgs Arguments.
+ * @return Formatted text.
+ */
+template<std::size_t TSmallStringOptLength, typename... TArgs>
+CSmallStringOpt<TSmallStringOptLength> format(std::format_string<TArgs&...> aFormat, TArgs&&... aArgs)
+{
+    CSmallStringOpt<TSmallStringOptLength> output;
+    NSSO::format_to(output, aFormat, aArgs...);
+    return output;
+}
+
+/**
+ * @brief Format text into a new CSmallStringOpt of wide characters.
+ *
+ * @tparam TSmallStringOptLength Number of characters of the small string optimization array.
+ * @tparam TArgs Types of arguments.
+ * @param aFormat Format string.
+ * @param aArgs Arguments.
+ * @return Formatted text.
+ */
+template<std::size_t TSmallStringOptLength, typename... TArgs>
+CSmallStringOpt<TSmallStringOptLength, wchar_t> format(std::wformat_string<TArgs&...> aFormat, TArgs&&... aArgs)
+{
+    CSmallStringOpt<TSmallStringOptLength, wchar_t> output;
+    NSSO::format_to(output, aFormat, aArgs...);
+    return output;
+}
+
+} // namespace NSSO
+
+/**
+ * @brief CSmallStringOpt is formatted like std::basic_string_view, with the same format specification.
+ */
+template<std::size_t TSmallStringOptLength, typename TChar, typename TAllocator, typename TPolicy>
+struct std::formatter<NSSO::CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>, TChar>
+    : std::formatter<std::basic_string_view<TChar>, TChar>
+{
+    template<typename TContext>
+    auto format(const NSSO::CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>& aString,
+        TContext& aContext) const
+    {
+        return std::formatter<std::basic_string_view<TChar>, TChar>::format(
+            std::basic_string_view<TChar>{aString.data(), aString.size()}, aContext);
+    }
+};
+
+/**
+ * @brief CSimpleString is formatted like std::basic_string_view, with the same format specification.
+ */
+template<typename TChar, typename TAllocator>
+struct std::formatter<NSSO::CSimpleString<TChar, TAllocator>, TChar>
+    : std::formatter<std::basic_string_view<TChar>, TChar>
+{
+    template<typename TContext>
+    auto format(const NSSO::CSimpleString<TChar, TAllocator>& aString, TContext& aContext) const
+    {
+        return std::formatter<std::basic_string_view<TChar>, TChar>::format(
+            std::basic_string_view<TChar>{aString.data(), aString.size()}, aContext);
+    }
+};
+
+#endif // __cpp_lib_format
+
+#endif // FORMAT_HPP_
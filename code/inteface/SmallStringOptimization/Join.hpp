@@ -0,0 +1,118 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Joining ranges of strings with a separator into CSmallStringOpt or CSimpleString.
+ */
+
+#ifndef JOIN_HPP_
+#define JOIN_HPP_
+
+#include <cstddef>
+#include <string_view>
+#include "internal/InternalHelper.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Append pieces of the given range separated by the given separator to the given string. Sizes of pieces are
+ * summed in the first pass, so memory of string grows at most once (characters stay in the small string optimization
+ * array if they fit), and pieces are copied by the fast memcpy in the second pass.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ * @tparam TRange Type of forward range of strings with data() and size(): CSmallStringOpt, CSimpleString,
+ * std::basic_string or std::basic_string_view.
+ * @param aOutput String to append to.
+ * @param aRange Range, iterated twice. Pieces must not be a part of aOutput.
+ * @param aSeparator Separator.
+ */
+template<typename TString, typename TRange>
+void join_to(TString& aOutput, const TRange& aRange, std::basic_string_view<typename TString::value_type> aSeparator)
+{
+    using TChar = typename TString::value_type;
+    using size_type = typename TString::size_type;
+    size_type length = 0u;
+    size_type count = 0u;
+    for (const auto& piece : aRange)
+    {
+        length += piece.size();
+        ++count;
+    }
+    if (count == 0u)
+    {
+        return ;
+    }
+    length += (count - 1u) * aSeparator.size();
+    TChar* const begin = aOutput.grow_uninitialized(length);
+    TChar* ptr = begin;
+    bool first = true;
+    for (const auto& piece : aRange)
+    {
+        if (false == first)
+        {
+            CFast<TChar>::memcpy(ptr, aSeparator.data(), aSeparator.size() * sizeof(TChar));
+            ptr += aSeparator.size();
+        }
+        first = false;
+        CFast<TChar>::memcpy(ptr, piece.data(), piece.size() * sizeof(TChar));
+        ptr += piece.size();
+    }
+    aOutput.commit(aOutput.size() + length);
+}
+
+/**
+ * @brief Append pieces of the given range separated by the given character to the given string, see join_to.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ * @tparam TRange Type of forward range of strings with data() and size().
+ * @param aOutput String to append to.
+ * @param aRange Range, iterated twice.
+ * @param aSeparator Separator.
+ */
+template<typename TString, typename TRange>
+void join_to(TString& aOutput, const TRange& aRange, typename TString::value_type aSeparator)
+{
+    join_to(aOutput, aRange, std::basic_string_view<typename TString::value_type>{&aSeparator, 1u});
+}
+
+/**
+ * @brief Join pieces of the given range separated by the given separator into a new string, see join_to.
+ *
+ * @tparam TString Type of result: CSmallStringOpt or CSimpleString.
+ * @tparam TRange Type of forward range of strings with data() and size().
+ * @param aRange Range, iterated twice.
+ * @param aSeparator Separator.
+ * @return Joined string.
+ */
+template<typename TString, typename TRange>
+TString join(const TRange& aRange, std::basic_string_view<typename TString::value_type> aSeparator)
+{
+    TString output;
+    join_to(output, aRange, aSeparator);
+    return output;
+}
+
+/**
+ * @brief Join pieces of the given range separated by the given character into a new string, see join_to.
+ *
+ * @tparam TString Type of result: CSmallStringOpt or CSimpleString.
+ * @tparam TRange Type of forward range of strings with data() and size().
+ * @param aRange Range, iterated twice.
+ * @param aSeparator Separator.
+ * @return Joined string.
+ */
+template<typename TString, typename TRange>
+TString join(const TRange& aRange, typename TString::value_type aSeparator)
+{
+    TString output;
+    join_to(output, aRange, aSeparator);
+    return output;
+}
+
+} // namespace NSSO
+
+#endif // JOIN_HPP_
@@ -0,0 +1,522 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Multi-pattern matcher (Aho-Corasick) compiled from a set of strings.
+ */
+
+#ifndef MULTI_MATCHER_HPP_
+#define MULTI_MATCHER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "internal/Search.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Aho-Corasick automaton that finds all occurrences of many patterns in a single pass over a text.
+ * The automaton is a flat deterministic table: characters are mapped to classes (characters that don't occur in any
+ * pattern share class 0), each state is a row of next states for all classes, so a single table lookup is done per
+ * character of text. Matches are reported via a callback, also across chunks of a stream (see CStreamState).
+ * Empty patterns are ignored.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar = char>
+class CMultiMatcher
+{
+public:
+    /**
+     * @brief Size type.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Single match.
+     */
+    struct CMatch
+    {
+        /**
+         * @brief Index of pattern in the order given to the constructor.
+         */
+        size_type mPattern;
+
+        /**
+         * @brief Index of the first character of match in text (in stream for streaming search).
+         */
+        size_type mPosition;
+    };
+
+    /**
+     * @brief State of streaming search, carried across chunks of text.
+     */
+    class CStreamState
+    {
+        friend class CMultiMatcher;
+
+        /**
+         * @brief State of automaton.
+         */
+        std::uint32_t mState = 0u;
+
+        /**
+         * @brief Number of characters already consumed.
+         */
+        size_type mPosition = 0u;
+
+    public:
+        /**
+         * @brief Return number of characters already consumed.
+         *
+         * @return Number of characters.
+         */
+        size_type position() const noexcept
+        {
+            return mPosition;
+        }
+
+        /**
+         * @brief Start a new stream.
+         */
+        void reset() noexcept
+        {
+            mState = 0u;
+            mPosition = 0u;
+        }
+    };
+
+private:
+    /**
+     * @brief Type of state index.
+     */
+    using TState = std::uint32_t;
+
+    /**
+     * @brief True if classes of characters are looked up in a table indexed by character.
+     */
+    static constexpr bool sByteChar = sizeof(TChar) == 1u;
+
+    /**
+     * @brief Number of classes of characters: characters that occur in patterns and class 0 for others.
+     */
+    size_type mClassCount = 1u;
+
+    /**
+     * @brief Class of each 1 byte character.
+     */
+    std::vector<std::uint16_t> mByteClasses;
+
+    /**
+     * @brief Sorted characters that occur in patterns (wider characters), class is index + 1.
+     */
+    std::vector<TChar> mChars;
+
+    /**
+     * @brief Transitions: mClassCount next states for each state. State 0 is root.
+     */
+    std::vector<TState> mTransitions;
+
+    /**
+     * @brief Non-zero if the state or any of its suffixes ends a pattern.
+     */
+    std::vector<std::uint8_t> mReport;
+
+    /**
+     * @brief Nearest proper suffix state that ends a pattern, 0 if there is none.
+     */
+    std::vector<TState> mOutputLink;
+
+    /**
+     * @brief Patterns ending in state s are mOutputs[mOutputBegin[s], mOutputBegin[s + 1]).
+     */
+    std::vector<TState> mOutputBegin;
+
+    /**
+     * @brief Indices of patterns.
+     */
+    std::vector<TState> mOutputs;
+
+    /**
+     * @brief Lengths of patterns.
+     */
+    std::vector<size_type> mPatternLengths;
+
+public:
+    /**
+     * @brief Compile automaton from the given patterns.
+     *
+     * @tparam TIterator Iterator of patterns: CSmallStringOpt, CSimpleString, std::basic_string or any string object
+     * with data() and size().
+     * @param aBegin Iterator to the first pattern.
+     * @param aEnd Iterator after the last pattern.
+     * @throw std::length_error if the automaton has too many states.
+     */
+    template<typename TIterator>
+    CMultiMatcher(TIterator aBegin, TIterator aEnd)
+    {
+        for (auto it = aBegin; it != aEnd; ++it)
+        {
+            mPatternLengths.push_back(static_cast<size_type>(it->size()));
+        }
+        buildClasses(aBegin, aEnd);
+
+        std::vector<std::pair<TState, TState>> ends; // (state, pattern)
+        mTransitions.assign(mClassCount, 0u);
+        TState pattern = 0u;
+        for (auto it = aBegin; it != aEnd; ++it, ++pattern)
+        {
+            const TChar* const chars = it->data();
+            const size_type length = static_cast<size_type>(it->size());
+            if (length == 0u)
+            {
+                continue;
+            }
+            TState state = 0u;
+            for (size_type i = 0u; i < length; ++i)
+            {
+                const size_type index = state * mClassCount + classOf(chars[i]);
+                if (mTransitions[index] == 0u)
+                {
+                    const size_type newState = mTransitions.size() / mClassCount;
+                    if (newState > std::numeric_limits<TState>::max())
+                    {
+                        throw std::length_error("CMultiMatcher: too many states");
+                    }
+                    mTransitions[index] = static_cast<TState>(newState);
+                    mTransitions.resize(mTransitions.size() + mClassCount, 0u);
+                }
+                state = mTransitions[index];
+            }
+            ends.emplace_back(state, pattern);
+        }
+
+        const size_type stateCount = mTransitions.size() / mClassCount;
+        mOutputBegin.assign(stateCount + 1u, 0u);
+        for (const auto& end : ends)
+        {
+            ++mOutputBegin[end.first + 1u];
+        }
+        for (size_type s = 0u; s < stateCount; ++s)
+        {
+            mOutputBegin[s + 1u] += mOutputBegin[s];
+        }
+        mOutputs.resize(ends.size());
+        std::vector<TState> fill(mOutputBegin.begin(), mOutputBegin.end() - 1);
+        for (const auto& end : ends)
+        {
+            mOutputs[fill[end.first]++] = end.second;
+        }
+
+        buildFailureLinks(stateCount);
+    }
+
+    /**
+     * @brief Compile automaton from the given patterns.
+     *
+     * @tparam TContainer Container of patterns, e.g. std::vector<CSmallStringOpt<20>>.
+     * @param aPatterns Patterns.
+     * @throw std::length_error if the automaton has too many states.
+     */
+    template<typename TContainer, typename = decltype(std::declval<const TContainer&>().begin())>
+    explicit CMultiMatcher(const TContainer& aPatterns)
+        : CMultiMatcher(aPatterns.begin(), aPatterns.end())
+    {
+    }
+
+    /**
+     * @brief Return number of patterns (including empty ones).
+     *
+     * @return Number of patterns.
+     */
+    size_type patternCount() const noexcept
+    {
+        return mPatternLengths.size();
+    }
+
+    /**
+     * @brief Return length of the given pattern.
+     *
+     * @param aPattern Index of pattern.
+     * @return Length of pattern.
+     */
+    size_type patternLength(size_type aPattern) const noexcept
+    {
+        return mPatternLengths[aPattern];
+    }
+
+    /**
+     * @brief Return number of states of automaton.
+     *
+     * @return Number of states.
+     */
+    size_type stateCount() const noexcept
+    {
+        return mTransitions.size() / mClassCount;
+    }
+
+    /**
+     * @brief Find all occurrences of all patterns. Overlapping occurrences are reported too, ordered by position
+     * of their last character.
+     *
+     * @tparam TCallback Type of callable with CMatch argument.
+     * @param aTxt Text.
+     * @param aLength Length of text.
+     * @param aCallback Callable called for each match.
+     */
+    template<typename TCallback>
+    void findAll(const TChar* aTxt, size_type aLength, TCallback&& aCallback) const
+    {
+        CStreamState state;
+        findAll(state, aTxt, aLength, aCallback);
+    }
+
+    /**
+     * @brief Find all occurrences of all patterns in the given string.
+     *
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @tparam TCallback Type of callable with CMatch argument.
+     * @param aStr String.
+     * @param aCallback Callable called for each match.
+     */
+    template<typename TString, typename TCallback, TEnableIfStringObject<TString, TChar> = 0>
+    void findAll(const TString& aStr, TCallback&& aCallback) const
+    {
+        findAll(aStr.data(), aStr.size(), aCallback);
+    }
+
+    /**
+     * @brief Find all occurrences of all patterns in the next chunk of a stream. Matches spanning chunks are reported
+     * with positions counted from the beginning of stream.
+     *
+     * @tparam TCallback Type of callable with CMatch argument.
+     * @param aState State of stream, updated.
+     * @param aChunk Chunk of text.
+     * @param aLength Length of chunk.
+     * @param aCallback Callable called for each match.
+     */
+    template<typename TCallback>
+    void findAll(CStreamState& aState, const TChar* aChunk, size_type aLength, TCallback&& aCallback) const
+    {
+        const TState* const transitions = mTransitions.data();
+        const std::uint8_t* const report = mReport.data();
+        TState state = aState.mState;
+        for (size_type i = 0u; i < aLength; ++i)
+        {
+            state = transitions[state * mClassCount + classOf(aChunk[i])];
+            if (report[state] != 0u)
+            {
+                reportMatches(state, aState.mPosition + i + 1u, aCallback);
+            }
+        }
+        aState.mState = state;
+        aState.mPosition += aLength;
+    }
+
+    /**
+     * @brief Find all occurrences of all patterns.
+     *
+     * @param aTxt Text.
+     * @param aLength Length of text.
+     * @return Matches ordered by position of their last character.
+     */
+    std::vector<CMatch> findAll(const TChar* aTxt, size_type aLength) const
+    {
+        std::vector<CMatch> output;
+        findAll(aTxt, aLength, [&output](const CMatch& aMatch) { output.push_back(aMatch); });
+        return output;
+    }
+
+    /**
+     * @brief Find all occurrences of all patterns in the given string.
+     *
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @return Matches ordered by position of their last character.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    std::vector<CMatch> findAll(const TString& aStr) const
+    {
+        return findAll(aStr.data(), aStr.size());
+    }
+
+    /**
+     * @brief Check if any pattern occurs in text. Stops at the first match.
+     *
+     * @param aTxt Text.
+     * @param aLength Length of text.
+     * @return True if any pattern occurs.
+     */
+    bool containsAny(const TChar* aTxt, size_type aLength) const noexcept
+    {
+        const TState* const transitions = mTransitions.data();
+        const std::uint8_t* const report = mReport.data();
+        TState state = 0u;
+        for (size_type i = 0u; i < aLength; ++i)
+        {
+            state = transitions[state * mClassCount + classOf(aTxt[i])];
+            if (report[state] != 0u)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check if any pattern occurs in the given string. Stops at the first match.
+     *
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @return True if any pattern occurs.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    bool containsAny(const TString& aStr) const noexcept
+    {
+        return containsAny(aStr.data(), aStr.size());
+    }
+
+private:
+    /**
+     * @brief Return class of the given character.
+     *
+     * @param aChar Character.
+     * @return Class of character.
+     */
+    size_type classOf(TChar aChar) const noexcept
+    {
+        if constexpr (sByteChar)
+        {
+            return mByteClasses[static_cast<unsigned char>(aChar)];
+        }
+        else
+        {
+            const auto it = std::lower_bound(mChars.begin(), mChars.end(), aChar);
+            return (it != mChars.end() && *it == aChar) ? static_cast<size_type>(it - mChars.begin()) + 1u : 0u;
+        }
+    }
+
+    /**
+     * @brief Assign classes to characters that occur in patterns.
+     *
+     * @tparam TIterator Iterator of patterns.
+     * @param aBegin Iterator to the first pattern.
+     * @param aEnd Iterator after the last pattern.
+     */
+    template<typename TIterator>
+    void buildClasses(TIterator aBegin, TIterator aEnd)
+    {
+        if constexpr (sByteChar)
+        {
+            mByteClasses.assign(256u, 0u);
+            for (auto it = aBegin; it != aEnd; ++it)
+            {
+                for (size_type i = 0u; i < static_cast<size_type>(it->size()); ++i)
+                {
+                    mByteClasses[static_cast<unsigned char>(it->data()[i])] = 1u;
+                }
+            }
+            for (auto& byteClass : mByteClasses)
+            {
+                if (byteClass != 0u)
+                {
+                    byteClass = static_cast<std::uint16_t>(mClassCount++);
+                }
+            }
+        }
+        else
+        {
+            for (auto it = aBegin; it != aEnd; ++it)
+            {
+                mChars.insert(mChars.end(), it->data(), it->data() + it->size());
+            }
+            std::sort(mChars.begin(), mChars.end());
+            mChars.erase(std::unique(mChars.begin(), mChars.end()), mChars.end());
+            mClassCount = mChars.size() + 1u;
+        }
+    }
+
+    /**
+     * @brief Compute failure links in breadth first order and replace missing transitions by transitions of failure
+     * states, so the trie becomes a deterministic automaton.
+     *
+     * @param aStateCount Number of states.
+     */
+    void buildFailureLinks(size_type aStateCount)
+    {
+        std::vector<TState> failure(aStateCount, 0u);
+        mOutputLink.assign(aStateCount, 0u);
+        mReport.assign(aStateCount, 0u);
+        std::vector<TState> queue;
+        queue.reserve(aStateCount);
+        queue.push_back(0u);
+        for (size_type head = 0u; head < queue.size(); ++head)
+        {
+            const TState state = queue[head];
+            TState* const row = &mTransitions[state * mClassCount];
+            const TState* const failureRow = &mTransitions[failure[state] * mClassCount];
+            for (size_type c = 0u; c < mClassCount; ++c)
+            {
+                // the row isn't modified before this point, so non-zero entries are children in the trie.
+                const TState child = row[c];
+                if (child != 0u)
+                {
+                    const TState childFailure = state == 0u ? 0u : failureRow[c];
+                    failure[child] = childFailure;
+                    mOutputLink[child] = hasOutputs(childFailure) ? childFailure : mOutputLink[childFailure];
+                    mReport[child] = (hasOutputs(child) || mOutputLink[child] != 0u) ? 1u : 0u;
+                    queue.push_back(child);
+                }
+                else if (state != 0u)
+                {
+                    row[c] = failureRow[c];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Check if any pattern ends in the given state.
+     *
+     * @param aState State.
+     * @return True if any pattern ends in the state.
+     */
+    bool hasOutputs(TState aState) const noexcept
+    {
+        return mOutputBegin[aState] != mOutputBegin[aState + 1u];
+    }
+
+    /**
+     * @brief Report patterns that end in the given state and its suffixes.
+     *
+     * @tparam TCallback Type of callable with CMatch argument.
+     * @param aState State.
+     * @param aEnd Index after the last character of matches.
+     * @param aCallback Callable called for each match.
+     */
+    template<typename TCallback>
+    void reportMatches(TState aState, size_type aEnd, TCallback& aCallback) const
+    {
+        for (TState state = hasOutputs(aState) ? aState : mOutputLink[aState]; state != 0u; state = mOutputLink[state])
+        {
+            for (TState i = mOutputBegin[state]; i < mOutputBegin[state + 1u]; ++i)
+            {
+                const TState pattern = mOutputs[i];
+                aCallback(CMatch{pattern, aEnd - mPatternLengths[pattern]});
+            }
+        }
+    }
+};
+
+} // namespace NSSO
+
+#endif // MULTI_MATCHER_HPP_
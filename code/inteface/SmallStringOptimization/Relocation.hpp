@@ -0,0 +1,88 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Trivially relocatable types: objects that can be moved to another memory by copying their bytes.
+ */
+
+#ifndef RELOCATION_HPP_
+#define RELOCATION_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace NSSO
+{
+
+/**
+ * @brief True if an object of the given type can be relocated (moved to another memory and the source ended without
+ * calling its destructor) by copying its bytes. It is the case for types that don't point to themselves, e.g.
+ * CSmallStringOpt and CSimpleString with trivially relocatable allocators, but not for std::string of libstdc++.
+ * Specialize it for own types.
+ *
+ * @tparam T Type.
+ */
+template<typename T>
+struct CIsTriviallyRelocatable : std::is_trivially_copyable<T>
+{
+};
+
+/**
+ * @brief std::allocator is stateless, so it is trivially relocatable.
+ *
+ * @tparam T Type of allocated elements.
+ */
+template<typename T>
+struct CIsTriviallyRelocatable<std::allocator<T>> : std::true_type
+{
+};
+
+/**
+ * @brief True if objects of the given type are trivially relocatable, see CIsTriviallyRelocatable.
+ *
+ * @tparam T Type.
+ */
+template<typename T>
+constexpr bool gIsTriviallyRelocatable = CIsTriviallyRelocatable<T>::value;
+
+/**
+ * @brief Relocate objects to not overlapping memory: bytes are copied for trivially relocatable types, otherwise
+ * objects are moved and destroyed one by one. After relocation the source memory contains no objects.
+ *
+ * @tparam T Type of objects.
+ * @param aDest Uninitialized memory for aCount objects.
+ * @param aSrc Objects to relocate.
+ * @param aCount Number of objects.
+ */
+template<typename T>
+void relocate(T* aDest, T* aSrc, std::size_t aCount) noexcept
+{
+    static_assert(gIsTriviallyRelocatable<T> || std::is_nothrow_move_constructible<T>::value,
+        "relocation of objects cannot throw");
+    if constexpr (gIsTriviallyRelocatable<T>)
+    {
+        if (aCount != 0u)
+        {
+            std::memcpy(static_cast<void*>(aDest), static_cast<const void*>(aSrc), aCount * sizeof(T));
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0u; i < aCount; ++i)
+        {
+            new (aDest + i) T(std::move(aSrc[i]));
+            aSrc[i].~T();
+        }
+    }
+}
+
+} // namespace NSSO
+
+#endif // RELOCATION_HPP_
@@ -0,0 +1,994 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Rope - string stored as a balanced tree of chunks. Designed for concatenation heavy and huge strings.
+ */
+
+#ifndef ROPE_HPP_
+#define ROPE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SimpleString.hpp"
+#include "internal/InternalHelper.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Rope: characters are stored in chunks kept in leaves of a balanced (AVL) binary tree. Nodes are immutable
+ * and shared between ropes, so copying a rope, concatenation, substring, insertion and erasure are O(log n) and don't
+ * copy characters. Characters appended in small pieces are gathered in a tail buffer and moved to the tree as
+ * a single chunk when the buffer is full.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TChunk Type of string stored in leaves. It must be constructible from (const TChar*, size_type) and have
+ * data() and size(), e.g. CSimpleString or CSmallStringOpt.
+ */
+template<typename TChar = char, typename TChunk = CSimpleString<TChar>>
+class CRope
+{
+public:
+    /**
+     * @brief Character type.
+     */
+    using value_type = TChar;
+
+    /**
+     * @brief Size type.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Type of string stored in leaves.
+     */
+    using chunk_type = TChunk;
+
+    /**
+     * @brief Type of chunk returned by chunk iterator.
+     */
+    using chunk_view = std::basic_string_view<TChar>;
+
+    /**
+     * @brief Value returned when no position is found / meaning "till the end".
+     */
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    /**
+     * @brief The maximum number of characters in a single leaf.
+     */
+    static constexpr size_type sLeafLength = 4096u;
+
+private:
+
+    struct CNode;
+
+    /**
+     * @brief Pointer to immutable node shared between ropes.
+     */
+    using TNodePtr = std::shared_ptr<const CNode>;
+
+    /**
+     * @brief Node of the tree. Inner nodes have both children, leaves are CLeaf objects without children.
+     */
+    struct CNode
+    {
+        /**
+         * @brief Left child. Null for leaves.
+         */
+        TNodePtr mLeft;
+
+        /**
+         * @brief Right child. Null for leaves.
+         */
+        TNodePtr mRight;
+
+        /**
+         * @brief Number of characters in the subtree.
+         */
+        size_type mLength;
+
+        /**
+         * @brief Height of the subtree. Leaves have height 1.
+         */
+        unsigned int mHeight;
+
+        /**
+         * @brief Construct inner node.
+         *
+         * @param aLeft Left child.
+         * @param aRight Right child.
+         */
+        CNode(TNodePtr aLeft, TNodePtr aRight)
+            : mLeft{std::move(aLeft)}
+            , mRight{std::move(aRight)}
+            , mLength{mLeft->mLength + mRight->mLength}
+            , mHeight{1u + std::max(mLeft->mHeight, mRight->mHeight)}
+        {
+        }
+
+        /**
+         * @brief Check if node is a leaf.
+         *
+         * @return true if leaf.
+         */
+        bool isLeaf() const noexcept
+        {
+            return !mLeft;
+        }
+
+    protected:
+
+        /**
+         * @brief Construct node of leaf.
+         *
+         * @param aLength Number of characters.
+         */
+        explicit CNode(size_type aLength) noexcept
+            : mLeft{}
+            , mRight{}
+            , mLength{aLength}
+            , mHeight{1u}
+        {
+        }
+    };
+
+    /**
+     * @brief Leaf of the tree holding characters. Only leaves have chunks, so inner nodes don't carry the small string
+     * optimization array of TChunk. It is destroyed as CLeaf by the deleter created by std::make_shared.
+     */
+    struct CLeaf : CNode
+    {
+        /**
+         * @brief Characters of leaf.
+         */
+        TChunk mChunk;
+
+        /**
+         * @brief Construct leaf.
+         *
+         * @param aTxt Characters.
+         * @param aLength Number of characters.
+         */
+        CLeaf(const TChar* aTxt, size_type aLength)
+            : CNode(aLength)
+            , mChunk(aTxt, aLength)
+        {
+        }
+    };
+
+    /**
+     * @brief Return characters of the given leaf.
+     *
+     * @param aLeaf Leaf.
+     * @return Pointer to the first character.
+     */
+    static const TChar* chars(const CNode* aLeaf) noexcept
+    {
+        return static_cast<const CLeaf*>(aLeaf)->mChunk.data();
+    }
+
+    /**
+     * @brief Root of the tree. Null if the tree is empty.
+     */
+    TNodePtr mRoot;
+
+    /**
+     * @brief Characters appended after the tree, not moved to the tree yet.
+     */
+    std::vector<TChar> mTail;
+
+public:
+
+    /**
+     * @brief Forward iterator over chunks of contiguous characters.
+     */
+    class CChunkIterator
+    {
+    private:
+
+        friend class CRope;
+
+        /**
+         * @brief Nodes to visit.
+         */
+        std::vector<const CNode*> mStack;
+
+        /**
+         * @brief Tail of the rope, visited after the tree.
+         */
+        chunk_view mTail;
+
+        /**
+         * @brief Current chunk.
+         */
+        chunk_view mCurrent;
+
+        /**
+         * @brief True if iterator points after the last chunk.
+         */
+        bool mEnd;
+
+        /**
+         * @brief Construct iterator.
+         *
+         * @param aRoot Root of the tree.
+         * @param aTail Characters of the tail.
+         */
+        CChunkIterator(const CNode* aRoot, chunk_view aTail)
+            : mStack{}
+            , mTail{aTail}
+            , mCurrent{}
+            , mEnd{false}
+        {
+            if (aRoot != nullptr)
+            {
+                mStack.push_back(aRoot);
+            }
+            next();
+        }
+
+        /**
+         * @brief Move to the next chunk.
+         */
+        void next()
+        {
+            if (false == mStack.empty())
+            {
+                const CNode* node = mStack.back();
+                mStack.pop_back();
+                while (false == node->isLeaf())
+                {
+                    mStack.push_back(node->mRight.get());
+                    node = node->mLeft.get();
+                }
+                mCurrent = chunk_view{chars(node), node->mLength};
+            }
+            else if (false == mTail.empty())
+            {
+                mCurrent = mTail;
+                mTail = chunk_view{};
+            }
+            else
+            {
+                mCurrent = chunk_view{};
+                mEnd = true;
+            }
+        }
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = chunk_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const chunk_view*;
+        using reference = const chunk_view&;
+
+        /**
+         * @brief Construct end iterator.
+         */
+        CChunkIterator()
+            : mStack{}
+            , mTail{}
+            , mCurrent{}
+            , mEnd{true}
+        {
+        }
+
+        /**
+         * @brief Return current chunk.
+         *
+         * @return Current chunk.
+         */
+        const chunk_view& operator*() const noexcept
+        {
+            return mCurrent;
+        }
+
+        /**
+         * @brief Return current chunk.
+         *
+         * @return Current chunk.
+         */
+        const chunk_view* operator->() const noexcept
+        {
+            return &mCurrent;
+        }
+
+        /**
+         * @brief Move iterator to the next chunk.
+         *
+         * @return This iterator.
+         */
+        CChunkIterator& operator++()
+        {
+            next();
+            return *this;
+        }
+
+        /**
+         * @brief Move iterator to the next chunk, but return an iterator instance before moving.
+         *
+         * @return Iterator instance before moving.
+         */
+        CChunkIterator operator++(int)
+        {
+            CChunkIterator output{*this};
+            next();
+            return output;
+        }
+
+        /**
+         * @brief Check if iterators point to the same chunk.
+         *
+         * @param aIter Iterator to compare.
+         * @return true if they point to the same chunk.
+         */
+        bool operator==(const CChunkIterator& aIter) const noexcept
+        {
+            if (mEnd || aIter.mEnd)
+            {
+                return mEnd == aIter.mEnd;
+            }
+            return mCurrent.data() == aIter.mCurrent.data() && mStack.size() == aIter.mStack.size();
+        }
+
+        /**
+         * @brief Check if iterators point to different chunks.
+         *
+         * @param aIter Iterator to compare.
+         * @return true if they point to different chunks.
+         */
+        bool operator!=(const CChunkIterator& aIter) const noexcept
+        {
+            return !(*this == aIter);
+        }
+    };
+
+    /**
+     * @brief Chunk iterator type.
+     */
+    using chunk_iterator = CChunkIterator;
+
+    /**
+     * @brief Construct empty rope.
+     */
+    CRope() noexcept
+        : mRoot{}
+        , mTail{}
+    {
+    }
+
+    /**
+     * @brief Construct rope by copying the given characters.
+     *
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aLength Number of characters.
+     */
+    CRope(const TChar* aTxt, size_type aLength)
+        : mRoot{build(aTxt, aLength)}
+        , mTail{}
+    {
+    }
+
+    /**
+     * @brief Construct rope by copying the given string.
+     *
+     * @param aTxt Null terminated string.
+     */
+    explicit CRope(const TChar* aTxt)
+        : CRope(aTxt, txtLength(aTxt))
+    {
+    }
+
+    /**
+     * @brief Construct rope from std::string.
+     *
+     * @param aStr std::string object.
+     */
+    explicit CRope(const std::basic_string<TChar>& aStr)
+        : CRope(aStr.data(), aStr.size())
+    {
+    }
+
+    /**
+     * @brief Return number of characters.
+     *
+     * @return Number of characters.
+     */
+    size_type size() const noexcept
+    {
+        return treeLength() + mTail.size();
+    }
+
+    /**
+     * @brief Indicate if rope is empty.
+     *
+     * @return true if empty.
+     */
+    bool empty() const noexcept
+    {
+        return size() == 0u;
+    }
+
+    /**
+     * @brief Return height of the tree. O(log n) operations depend on it.
+     *
+     * @return Height of the tree.
+     */
+    unsigned int depth() const noexcept
+    {
+        return height(mRoot);
+    }
+
+    /**
+     * @brief Return character on the given position. O(log n).
+     *
+     * @param aIndex Index.
+     * @return Character on the given position.
+     */
+    const TChar& operator[](size_type aIndex) const noexcept
+    {
+        const size_type length = treeLength();
+        if (aIndex >= length)
+        {
+            return mTail[aIndex - length];
+        }
+        const CNode* node = mRoot.get();
+        while (false == node->isLeaf())
+        {
+            const size_type leftLength = node->mLeft->mLength;
+            if (aIndex < leftLength)
+            {
+                node = node->mLeft.get();
+            }
+            else
+            {
+                aIndex -= leftLength;
+                node = node->mRight.get();
+            }
+        }
+        return chars(node)[aIndex];
+    }
+
+    /**
+     * @brief Return character on the given position.
+     *
+     * @param aIndex Index.
+     * @return Character on the given position.
+     * @throw std::out_of_range if index is out of range.
+     */
+    const TChar& at(size_type aIndex) const
+    {
+        if (aIndex >= size())
+        {
+            throw std::out_of_range("CRope::at");
+        }
+        return (*this)[aIndex];
+    }
+
+    /**
+     * @brief Append the given characters. Amortized O(1) for small pieces.
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     */
+    void append(const TChar* aTxt, size_type aLength)
+    {
+        if (mTail.size() + aLength <= sLeafLength)
+        {
+            if (mTail.capacity() < sLeafLength)
+            {
+                mTail.reserve(sLeafLength);
+            }
+            mTail.insert(mTail.end(), aTxt, aTxt + aLength);
+            return ;
+        }
+        flush();
+        if (aLength < sLeafLength)
+        {
+            mTail.insert(mTail.end(), aTxt, aTxt + aLength);
+        }
+        else
+        {
+            mRoot = join(std::move(mRoot), build(aTxt, aLength));
+        }
+    }
+
+    /**
+     * @brief Append the given string.
+     *
+     * @param aTxt Null terminated string.
+     */
+    void append(const TChar* aTxt)
+    {
+        append(aTxt, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Append the given rope. O(log n), characters are not copied.
+     *
+     * @param aRope Rope to append.
+     */
+    void append(const CRope& aRope)
+    {
+        flush();
+        mRoot = join(std::move(mRoot), aRope.fullRoot());
+    }
+
+    /**
+     * @brief Append the given string.
+     *
+     * @param aTxt String.
+     * @return This rope.
+     */
+    CRope& operator+=(const TChar* aTxt)
+    {
+        append(aTxt);
+        return *this;
+    }
+
+    /**
+     * @brief Append the given rope.
+     *
+     * @param aRope Rope to append.
+     * @return This rope.
+     */
+    CRope& operator+=(const CRope& aRope)
+    {
+        append(aRope);
+        return *this;
+    }
+
+    /**
+     * @brief Insert the given rope before the given position. O(log n).
+     *
+     * @param aPos Position.
+     * @param aRope Rope to insert.
+     */
+    void insert(size_type aPos, const CRope& aRope)
+    {
+        flush();
+        auto parts = split(mRoot, aPos);
+        mRoot = join(join(std::move(parts.first), aRope.fullRoot()), std::move(parts.second));
+    }
+
+    /**
+     * @brief Insert the given characters before the given position. O(log n + aLength).
+     *
+     * @param aPos Position.
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     */
+    void insert(size_type aPos, const TChar* aTxt, size_type aLength)
+    {
+        if (aPos >= size())
+        {
+            append(aTxt, aLength);
+            return ;
+        }
+        flush();
+        auto parts = split(mRoot, aPos);
+        mRoot = join(join(std::move(parts.first), build(aTxt, aLength)), std::move(parts.second));
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     *
+     * @param aPos Position.
+     * @param aTxt Null terminated string.
+     */
+    void insert(size_type aPos, const TChar* aTxt)
+    {
+        insert(aPos, aTxt, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Remove characters. O(log n).
+     *
+     * @param aPos Position of the first removed character.
+     * @param aLength Number of characters to remove.
+     */
+    void erase(size_type aPos, size_type aLength = npos)
+    {
+        flush();
+        auto parts = split(mRoot, aPos);
+        auto rest = split(parts.second, aLength);
+        mRoot = join(std::move(parts.first), std::move(rest.second));
+    }
+
+    /**
+     * @brief Return substring. O(log n), characters are not copied.
+     *
+     * @param aPos Position of the first character.
+     * @param aLength Number of characters.
+     * @return Substring.
+     */
+    CRope substr(size_type aPos, size_type aLength = npos) const
+    {
+        auto parts = split(fullRoot(), aPos);
+        CRope output;
+        output.mRoot = split(parts.second, aLength).first;
+        return output;
+    }
+
+    /**
+     * @brief Copy characters to the given array.
+     *
+     * @param aDest Destination array.
+     * @param aCount The maximum number of characters to copy.
+     * @param aPos Position of the first character to copy.
+     * @return Number of copied characters.
+     */
+    size_type copy(TChar* aDest, size_type aCount, size_type aPos = 0u) const
+    {
+        size_type copied = 0u;
+        for (auto it = chunk_begin(); it != chunk_end() && copied < aCount; ++it)
+        {
+            chunk_view chunk = *it;
+            if (aPos >= chunk.size())
+            {
+                aPos -= chunk.size();
+                continue;
+            }
+            chunk.remove_prefix(aPos);
+            aPos = 0u;
+            const size_type length = std::min(chunk.size(), aCount - copied);
+            CFast<TChar>::memcpy(aDest + copied, chunk.data(), length * sizeof(TChar));
+            copied += length;
+        }
+        return copied;
+    }
+
+    /**
+     * @brief Copy all characters to a contiguous string. The string is sized once and chunks are copied straight into
+     * it: CSmallStringOpt and CSimpleString by grow_uninitialized and commit, other strings by resize.
+     *
+     * @tparam TString Type of output string. It must be constructible from (const TChar*, size_type) and have either
+     * grow_uninitialized and commit or resize and operator[].
+     * @return Contiguous string.
+     */
+    template<typename TString = std::basic_string<TChar>>
+    TString flatten() const
+    {
+        if (mRoot && mRoot->isLeaf() && mTail.empty())
+        {
+            return TString(chars(mRoot.get()), mRoot->mLength);
+        }
+        TString output;
+        if (false == empty())
+        {
+            copyInto(output, 0);
+        }
+        return output;
+    }
+
+    /**
+     * @brief Return iterator to the first chunk.
+     *
+     * @return Iterator to the first chunk.
+     */
+    chunk_iterator chunk_begin() const
+    {
+        return chunk_iterator{mRoot.get(), chunk_view{mTail.data(), mTail.size()}};
+    }
+
+    /**
+     * @brief Return iterator after the last chunk.
+     *
+     * @return Iterator after the last chunk.
+     */
+    chunk_iterator chunk_end() const noexcept
+    {
+        return chunk_iterator{};
+    }
+
+private:
+
+    /**
+     * @brief Return number of characters in the tree.
+     *
+     * @return Number of characters in the tree.
+     */
+    size_type treeLength() const noexcept
+    {
+        return mRoot ? mRoot->mLength : 0u;
+    }
+
+    /**
+     * @brief Copy all characters to memory returned by grow_uninitialized of the given string.
+     *
+     * @tparam TString Type of output string.
+     * @param aOutput Empty string.
+     */
+    template<typename TString>
+    auto copyInto(TString& aOutput, int) const -> decltype(aOutput.grow_uninitialized(0u), void())
+    {
+        const size_type length = size();
+        copy(aOutput.grow_uninitialized(length), length);
+        aOutput.commit(length);
+    }
+
+    /**
+     * @brief Copy all characters to the given string resized to the length of rope.
+     *
+     * @tparam TString Type of output string.
+     * @param aOutput Empty string.
+     */
+    template<typename TString>
+    void copyInto(TString& aOutput, long) const
+    {
+        aOutput.resize(size());
+        copy(&aOutput[0], aOutput.size());
+    }
+
+    /**
+     * @brief Create leaf of the given characters.
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @return Leaf.
+     */
+    static TNodePtr makeLeaf(const TChar* aTxt, size_type aLength)
+    {
+        return std::make_shared<const CLeaf>(aTxt, aLength);
+    }
+
+    /**
+     * @brief Return tree with the tail added.
+     *
+     * @return Root of the tree.
+     */
+    TNodePtr fullRoot() const
+    {
+        if (mTail.empty())
+        {
+            return mRoot;
+        }
+        return join(mRoot, makeLeaf(mTail.data(), mTail.size()));
+    }
+
+    /**
+     * @brief Move the tail to the tree.
+     */
+    void flush()
+    {
+        if (false == mTail.empty())
+        {
+            mRoot = fullRoot();
+            mTail.clear();
+        }
+    }
+
+    /**
+     * @brief Return height of the given subtree.
+     *
+     * @param aNode Subtree.
+     * @return Height, 0 for empty subtree.
+     */
+    static unsigned int height(const TNodePtr& aNode) noexcept
+    {
+        return aNode ? aNode->mHeight : 0u;
+    }
+
+    /**
+     * @brief Build balanced tree of the given characters.
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @return Root of the tree.
+     */
+    static TNodePtr build(const TChar* aTxt, size_type aLength)
+    {
+        if (aLength == 0u)
+        {
+            return {};
+        }
+        if (aLength <= sLeafLength)
+        {
+            return makeLeaf(aTxt, aLength);
+        }
+        const size_type leaves = (aLength + sLeafLength - 1u) / sLeafLength;
+        const size_type half = (leaves / 2u) * sLeafLength;
+        return std::make_shared<const CNode>(build(aTxt, half), build(aTxt + half, aLength - half));
+    }
+
+    /**
+     * @brief Create node of the given subtrees, whose heights differ by 2 at most, and rotate it if needed.
+     *
+     * @param aLeft Left subtree.
+     * @param aRight Right subtree.
+     * @return Balanced tree.
+     */
+    static TNodePtr balance(TNodePtr aLeft, TNodePtr aRight)
+    {
+        const unsigned int leftHeight = height(aLeft);
+        const unsigned int rightHeight = height(aRight);
+        if (leftHeight > rightHeight + 1u)
+        {
+            if (height(aLeft->mLeft) >= height(aLeft->mRight))
+            {
+                return std::make_shared<const CNode>(aLeft->mLeft,
+                    std::make_shared<const CNode>(aLeft->mRight, std::move(aRight)));
+            }
+            const auto& middle = aLeft->mRight;
+            return std::make_shared<const CNode>(
+                std::make_shared<const CNode>(aLeft->mLeft, middle->mLeft),
+                std::make_shared<const CNode>(middle->mRight, std::move(aRight)));
+        }
+        if (rightHeight > leftHeight + 1u)
+        {
+            if (height(aRight->mRight) >= height(aRight->mLeft))
+            {
+                return std::make_shared<const CNode>(
+                    std::make_shared<const CNode>(std::move(aLeft), aRight->mLeft), aRight->mRight);
+            }
+            const auto& middle = aRight->mLeft;
+            return std::make_shared<const CNode>(
+                std::make_shared<const CNode>(std::move(aLeft), middle->mLeft),
+                std::make_shared<const CNode>(middle->mRight, aRight->mRight));
+        }
+        return std::make_shared<const CNode>(std::move(aLeft), std::move(aRight));
+    }
+
+    /**
+     * @brief Concatenate trees. O(|height(aLeft) - height(aRight)|).
+     *
+     * @param aLeft Left tree.
+     * @param aRight Right tree.
+     * @return Concatenated tree.
+     */
+    static TNodePtr join(TNodePtr aLeft, TNodePtr aRight)
+    {
+        if (!aLeft)
+        {
+            return aRight;
+        }
+        if (!aRight)
+        {
+            return aLeft;
+        }
+        const unsigned int leftHeight = aLeft->mHeight;
+        const unsigned int rightHeight = aRight->mHeight;
+        if (leftHeight > rightHeight + 1u)
+        {
+            return balance(aLeft->mLeft, join(aLeft->mRight, std::move(aRight)));
+        }
+        if (rightHeight > leftHeight + 1u)
+        {
+            return balance(join(std::move(aLeft), aRight->mLeft), aRight->mRight);
+        }
+        if (aLeft->isLeaf() && aRight->isLeaf() && aLeft->mLength + aRight->mLength <= sLeafLength / 4u)
+        {
+            // merge small leaves, so many small insertions don't create deep trees of tiny chunks
+            std::vector<TChar> buffer(chars(aLeft.get()), chars(aLeft.get()) + aLeft->mLength);
+            buffer.insert(buffer.end(), chars(aRight.get()), chars(aRight.get()) + aRight->mLength);
+            return makeLeaf(buffer.data(), buffer.size());
+        }
+        return std::make_shared<const CNode>(std::move(aLeft), std::move(aRight));
+    }
+
+    /**
+     * @brief Split tree into characters before the given position and the rest. O(log n).
+     *
+     * @param aNode Tree.
+     * @param aPos Position.
+     * @return Pair of trees.
+     */
+    static std::pair<TNodePtr, TNodePtr> split(const TNodePtr& aNode, size_type aPos)
+    {
+        if (!aNode || aPos == 0u)
+        {
+            return {TNodePtr{}, aNode};
+        }
+        if (aPos >= aNode->mLength)
+        {
+            return {aNode, TNodePtr{}};
+        }
+        if (aNode->isLeaf())
+        {
+            const TChar* txt = chars(aNode.get());
+            return {makeLeaf(txt, aPos), makeLeaf(txt + aPos, aNode->mLength - aPos)};
+        }
+        const size_type leftLength = aNode->mLeft->mLength;
+        if (aPos < leftLength)
+        {
+            auto parts = split(aNode->mLeft, aPos);
+            return {std::move(parts.first), join(std::move(parts.second), aNode->mRight)};
+        }
+        auto parts = split(aNode->mRight, aPos - leftLength);
+        return {join(aNode->mLeft, std::move(parts.first)), std::move(parts.second)};
+    }
+};
+
+/**
+ * @brief Concatenate ropes. O(log n), characters are not copied.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TChunk Type of string stored in leaves.
+ * @param aRope1 First rope.
+ * @param aRope2 Second rope.
+ * @return Concatenated rope.
+ */
+template<typename TChar, typename TChunk>
+CRope<TChar, TChunk> operator+(const CRope<TChar, TChunk>& aRope1, const CRope<TChar, TChunk>& aRope2)
+{
+    CRope<TChar, TChunk> output{aRope1};
+    output.append(aRope2);
+    return output;
+}
+
+/**
+ * @brief Compare ropes.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TChunk Type of string stored in leaves.
+ * @param aRope1 First rope.
+ * @param aRope2 Second rope.
+ * @return true if ropes contain the same characters.
+ */
+template<typename TChar, typename TChunk>
+bool operator==(const CRope<TChar, TChunk>& aRope1, const CRope<TChar, TChunk>& aRope2)
+{
+    if (aRope1.size() != aRope2.size())
+    {
+        return false;
+    }
+    auto it1 = aRope1.chunk_begin();
+    auto it2 = aRope2.chunk_begin();
+    std::basic_string_view<TChar> chunk1;
+    std::basic_string_view<TChar> chunk2;
+    while (true)
+    {
+        if (chunk1.empty())
+        {
+            if (it1 == aRope1.chunk_end())
+            {
+                return true;
+            }
+            chunk1 = *it1++;
+        }
+        if (chunk2.empty())
+        {
+            chunk2 = *it2++;
+        }
+        const std::size_t length = std::min(chunk1.size(), chunk2.size());
+        if (chunk1.substr(0u, length) != chunk2.substr(0u, length))
+        {
+            return false;
+        }
+        chunk1.remove_prefix(length);
+        chunk2.remove_prefix(length);
+    }
+}
+
+/**
+ * @brief Compare ropes.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TChunk Type of string stored in leaves.
+ * @param aRope1 First rope.
+ * @param aRope2 Second rope.
+ * @return true if ropes don't contain the same characters.
+ */
+template<typename TChar, typename TChunk>
+bool operator!=(const CRope<TChar, TChunk>& aRope1, const CRope<TChar, TChunk>& aRope2)
+{
+    return !(aRope1 == aRope2);
+}
+
+} // namespace NSSO
+
+#endif // ROPE_HPP_
@@ -0,0 +1,140 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Searcher of a fixed needle with precomputed tables, reusable for many texts.
+ */
+
+#ifndef SEARCHER_HPP_
+#define SEARCHER_HPP_
+
+#include <vector>
+#include "internal/InternalHelper.hpp"
+#include "internal/Search.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Searcher of a fixed needle. Boyer-Moore-Horspool table is built once in the constructor, so searching
+ * many texts (or one text many times) for the same needle doesn't pay for it again. Needles up to
+ * sShortNeedleLength characters are searched with SIMD first/last character filter instead.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TKernels Search kernels.
+ */
+template<typename TChar = char, typename TKernels = CSimdSearch<TChar>>
+class CSearcher
+{
+public:
+    /**
+     * @brief Size type.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Needles up to this length are searched with first/last character filter.
+     */
+    static constexpr size_type sShortNeedleLength = CStringSearch<TChar, TKernels>::sLongNeedleLength;
+
+private:
+
+    /**
+     * @brief Copy of needle.
+     */
+    std::vector<TChar> mNeedle;
+
+    /**
+     * @brief Shift table of needle.
+     */
+    CHorspoolTable<TChar> mTable;
+
+public:
+
+    /**
+     * @brief Construct searcher of the given needle.
+     *
+     * @param aNeedle Needle, doesn't need to be null terminated.
+     * @param aLength Length of needle.
+     */
+    CSearcher(const TChar* aNeedle, size_type aLength)
+        : mNeedle(aNeedle, aNeedle + aLength)
+        , mTable{aNeedle, aLength}
+    {
+    }
+
+    /**
+     * @brief Construct searcher of the given needle.
+     *
+     * @param aNeedle Null terminated needle.
+     */
+    explicit CSearcher(const TChar* aNeedle)
+        : CSearcher(aNeedle, txtLength(aNeedle))
+    {
+    }
+
+    /**
+     * @brief Construct searcher of the given needle.
+     *
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aNeedle Needle.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    explicit CSearcher(const TString& aNeedle)
+        : CSearcher(aNeedle.data(), aNeedle.size())
+    {
+    }
+
+    /**
+     * @brief Return length of needle.
+     *
+     * @return Length of needle.
+     */
+    size_type size() const noexcept
+    {
+        return mNeedle.size();
+    }
+
+    /**
+     * @brief Find needle in the given text.
+     *
+     * @param aTxt Text.
+     * @param aLength Length of text.
+     * @param aPos Position where search starts.
+     * @return Index of the found needle or gNpos.
+     */
+    size_type find(const TChar* aTxt, size_type aLength, size_type aPos = 0u) const noexcept
+    {
+        const size_type needleLength = mNeedle.size();
+        if (needleLength <= 1u || aPos >= aLength || aLength - aPos < needleLength)
+        {
+            return CStringSearch<TChar, TKernels>::find(aTxt, aLength, mNeedle.data(), needleLength, aPos);
+        }
+        if (needleLength <= sShortNeedleLength)
+        {
+            return CStringSearch<TChar, TKernels>::findShort(aTxt, aLength, mNeedle.data(), needleLength, aPos);
+        }
+        return mTable.find(aTxt, aLength, mNeedle.data(), needleLength, aPos);
+    }
+
+    /**
+     * @brief Find needle in the given string.
+     *
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found needle or gNpos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find(aStr.data(), aStr.size(), aPos);
+    }
+};
+
+} // namespace NSSO
+
+#endif // SEARCHER_HPP_
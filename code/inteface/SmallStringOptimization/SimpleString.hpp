@@ -14,9 +14,17 @@
 #include <map>
 #include <iterator>
 #include <algorithm>
+#include <functional>
 #include <array>
+#include <memory>
 #include <type_traits>
 #include "internal/InternalHelper.hpp"
+#include "internal/Search.hpp"
+#include "internal/Utf8.hpp"
+#include "internal/StreamRead.hpp"
+#include "Relocation.hpp"
+#include "Searcher.hpp"
+#include "StaticString.hpp"
 
 namespace NSSO
 {
@@ -283,6 +291,11 @@ public:
      */
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    /**
+     * @brief Value returned by search functions if nothing is found.
+     */
+    static constexpr size_type npos = gNpos;
+
 
 
 private:
@@ -307,6 +320,21 @@ private:
      */
     value_type* mDynamicArray;
 
+    /**
+     * @brief True if move assignment can take over dynamic memory of the given string without allocating, because
+     * the allocator is propagated on move assignment or all its instances are equal.
+     */
+    static constexpr bool sMoveTakesMemory =
+        std::allocator_traits<TAllocator>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<TAllocator>::is_always_equal::value;
+
+    /**
+     * @brief True if swap can exchange dynamic memory without allocating, because the allocator is propagated on swap
+     * or all its instances are equal.
+     */
+    static constexpr bool sSwapTakesMemory =
+        std::allocator_traits<TAllocator>::propagate_on_container_swap::value
+        || std::allocator_traits<TAllocator>::is_always_equal::value;
 
 
     void internalMemcpy(TChar* aDest, const TChar* aSrc, size_type aLength)
@@ -337,14 +365,20 @@ public:
     {
     }
 
-    CSimpleString(CSimpleString<TChar, TAllocator>&& aObj) noexcept(noexcept(mAllocator.allocate(0u)))
-        : mAllocator{} 
+    /**
+     * @brief Construct string. It never allocates, so std::vector relocates strings by moving them instead of copying.
+     * 
+     * @param aObj String to move. It is left empty.
+     */
+    CSimpleString(CSimpleString<TChar, TAllocator>&& aObj) noexcept
+        : mAllocator{aObj.mAllocator} 
         , mLength{aObj.mLength}
         , mAllocatedLength{aObj.mAllocatedLength}
         , mDynamicArray{aObj.mDynamicArray}
     {
         aObj.mDynamicArray = nullptr;
         aObj.mAllocatedLength = 0u;
+        aObj.mLength = 0u;
     }
 
     /**
@@ -398,15 +432,26 @@ public:
 	}
 
     /**
-     * @brief Move assignment operator. 
+     * @brief Move assignment operator. Dynamic memory is swapped, so it doesn't allocate unless the allocator isn't
+     * propagated on move assignment and the allocators differ.
      * 
-     * @tparam TObjNoChar Number of characters used for small string optimization in the given object.
-     * @param aObj Object to copy/move its character to this string.
+     * @param aObj Object to move its character to this string.
      * @return CSmallStringOpt& This object.
      */
-    CSimpleString& operator=(CSimpleString<TChar, TAllocator>&& aObj) 
-        noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
+    CSimpleString& operator=(CSimpleString<TChar, TAllocator>&& aObj) noexcept(sMoveTakesMemory)
     {
+        if constexpr (false == sMoveTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                assign(aObj);
+                return *this;
+            }
+        }
+        if constexpr (std::allocator_traits<TAllocator>::propagate_on_container_move_assignment::value)
+        {
+            std::swap(mAllocator, aObj.mAllocator);
+        }
         std::swap(mDynamicArray, aObj.mDynamicArray);
         std::swap(mAllocatedLength, aObj.mAllocatedLength);
         std::swap(mLength, aObj.mLength);
@@ -419,7 +464,7 @@ public:
      * @param aTxt String array to copy.
      * @return CSmallStringOpt& This object.
      */
-    CSimpleString& operator=(const TChar* aTxt) noexcept(this->assign(nullptr, 0))
+    CSimpleString& operator=(const TChar* aTxt) noexcept(noexcept(assign(nullptr, 0u)))
     {
         const size_type len = txtLength(aTxt);
         assign(aTxt, len);
@@ -432,12 +477,39 @@ public:
      * @param aTxt std::string to copy.
      * @return CSmallStringOpt& This object.
      */
-    CSimpleString& operator=(const std::basic_string<TChar>& aTxt) noexcept(this->assign(nullptr, 0))
+    CSimpleString& operator=(const std::basic_string<TChar>& aTxt) noexcept(noexcept(assign(nullptr, 0u)))
     {
         assign(aTxt.c_str(), aTxt.size());
         return *this;
     }
 
+    /**
+     * @brief Swap characters of strings by swapping pointers to dynamic memory. Nothing is allocated unless
+     * the allocator isn't propagated on swap and the allocators differ, then characters are copied.
+     * 
+     * @param aObj String to swap with.
+     */
+    void swap(CSimpleString<TChar, TAllocator>& aObj) noexcept(sSwapTakesMemory)
+    {
+        if constexpr (false == sSwapTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                CSimpleString<TChar, TAllocator> tmp{std::move(aObj)};
+                aObj = std::move(*this);
+                *this = std::move(tmp);
+                return ;
+            }
+        }
+        if constexpr (std::allocator_traits<TAllocator>::propagate_on_container_swap::value)
+        {
+            std::swap(mAllocator, aObj.mAllocator);
+        }
+        std::swap(mDynamicArray, aObj.mDynamicArray);
+        std::swap(mAllocatedLength, aObj.mAllocatedLength);
+        std::swap(mLength, aObj.mLength);
+    }
+
     ~CSimpleString() 
     {
         mAllocator.deallocate(mDynamicArray, mAllocatedLength);
@@ -492,7 +564,9 @@ public:
     {
         if (empty())
         {
-            return "";
+            // empty string of every type of characters
+            static constexpr TChar sEmpty{};
+            return &sEmpty;
         }
         return mDynamicArray;
     }
@@ -638,10 +712,10 @@ public:
         const auto fullLength = mLength + aLen + 1u;
         if (mAllocatedLength <= fullLength)
         {
-            mAllocatedLength = fullLength;
             auto ptr = mAllocator.allocate(fullLength);
             internalMemcpy(ptr, mDynamicArray, mLength);
             mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+            mAllocatedLength = fullLength;
             mDynamicArray = ptr;
         }
         internalMemcpy(mDynamicArray + mLength, aTxt, aLen);
@@ -654,6 +728,345 @@ public:
     {
         append(aTxt.data(), aTxt.size());
     }
+
+    /**
+     * @brief Make room for the given number of characters after the current ones and return pointer to it, so the
+     * caller can write characters directly instead of using a side buffer. Size doesn't change until commit is
+     * called. Dynamic memory grows at least twice.
+     * 
+     * @param aCount Number of characters the caller can write.
+     * @return Pointer to the character after the last one. [ptr, ptr + aCount] is writable.
+     */
+    TChar* grow_uninitialized(size_type aCount)
+        noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
+    {
+        const auto fullLength = mLength + aCount + 1u;
+        if (mAllocatedLength < fullLength)
+        {
+            const size_type newLength = std::max(fullLength, 2u * mAllocatedLength);
+            auto ptr = mAllocator.allocate(newLength);
+            internalMemcpy(ptr, mDynamicArray, mLength);
+            mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+            mAllocatedLength = newLength;
+            mDynamicArray = ptr;
+        }
+        return mDynamicArray + mLength;
+    }
+
+    /**
+     * @brief Set length of string after characters were written to memory returned by grow_uninitialized.
+     * 
+     * @param aLength New length, not bigger than size() + the number of characters given to grow_uninitialized.
+     */
+    void commit(size_type aLength) noexcept
+    {
+        mDynamicArray[aLength] = '\0';
+        mLength = aLength;
+    }
+
+    /**
+     * @brief Resize string to the given length and let the given operation overwrite characters, like
+     * std::basic_string::resize_and_overwrite. The first min(size(), aCount) characters are kept, the others are
+     * uninitialized.
+     * 
+     * @tparam TOperation Type of callable: size_type(TChar* aBuffer, size_type aCount).
+     * @param aCount Number of characters the operation can write.
+     * @param aOperation Operation that writes characters and returns the final length (not bigger than aCount).
+     */
+    template<typename TOperation>
+    void resize_and_overwrite(size_type aCount, TOperation aOperation)
+    {
+        TChar* ptr = grow_uninitialized(aCount > mLength ? aCount - mLength : 0u) - mLength;
+        commit(static_cast<size_type>(aOperation(ptr, aCount)));
+    }
+
+    /**
+     * @brief Insert the given characters before the given position. The tail is shifted by one move.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aTxt Characters, can be a part of this string.
+     * @param aLength Number of characters.
+     */
+    void insert(size_type aPos, const TChar* aTxt, size_type aLength)
+    {
+        replace(aPos, 0u, aTxt, aLength);
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aTxt Null terminated string.
+     */
+    void insert(size_type aPos, const TChar* aTxt)
+    {
+        insert(aPos, aTxt, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aObj String, can be this string.
+     */
+    void insert(size_type aPos, const CSimpleString<TChar, TAllocator>& aObj)
+    {
+        insert(aPos, aObj.mDynamicArray, aObj.mLength);
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aTxt String.
+     */
+    void insert(size_type aPos, const std::basic_string<TChar>& aTxt)
+    {
+        insert(aPos, aTxt.data(), aTxt.size());
+    }
+
+    /**
+     * @brief Insert the given number of copies of the given character before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aCount Number of characters.
+     * @param aChar Character.
+     */
+    void insert(size_type aPos, size_type aCount, TChar aChar)
+    {
+        replace(aPos, 0u, aCount, aChar);
+    }
+
+    /**
+     * @brief Remove characters. The tail is shifted by one move, memory is kept.
+     * 
+     * @param aPos Position of the first removed character.
+     * @param aCount Number of removed characters, up to the end of string if too big.
+     */
+    void erase(size_type aPos = 0u, size_type aCount = npos)
+    {
+        makeRoom(aPos, aCount, 0u);
+    }
+
+    /**
+     * @brief Replace characters by the given characters. The tail is shifted by one move.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aTxt Characters, can be a part of this string.
+     * @param aLength Number of characters.
+     */
+    void replace(size_type aPos, size_type aCount, const TChar* aTxt, size_type aLength)
+    {
+        const std::less<const TChar*> less;
+        if (aLength != 0u && less(aTxt, endPtr()) && less(beginPtr(), aTxt + aLength))
+        {
+            // characters of this string are overwritten or moved
+            const CSimpleString<TChar, TAllocator> copy{aTxt, aLength};
+            replace(aPos, aCount, copy.mDynamicArray, aLength);
+            return ;
+        }
+        TChar* ptr = makeRoom(aPos, aCount, aLength);
+        std::char_traits<TChar>::copy(ptr, aTxt, aLength);
+    }
+
+    /**
+     * @brief Replace characters by the given string.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aTxt Null terminated string.
+     */
+    void replace(size_type aPos, size_type aCount, const TChar* aTxt)
+    {
+        replace(aPos, aCount, aTxt, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Replace characters by the given string.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aObj String, can be this string.
+     */
+    void replace(size_type aPos, size_type aCount, const CSimpleString<TChar, TAllocator>& aObj)
+    {
+        replace(aPos, aCount, aObj.mDynamicArray, aObj.mLength);
+    }
+
+    /**
+     * @brief Replace characters by the given string.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aTxt String.
+     */
+    void replace(size_type aPos, size_type aCount, const std::basic_string<TChar>& aTxt)
+    {
+        replace(aPos, aCount, aTxt.data(), aTxt.size());
+    }
+
+    /**
+     * @brief Replace characters by the given number of copies of the given character.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aLength Number of characters.
+     * @param aChar Character.
+     */
+    void replace(size_type aPos, size_type aCount, size_type aLength, TChar aChar)
+    {
+        TChar* ptr = makeRoom(aPos, aCount, aLength);
+        std::fill_n(ptr, aLength, aChar);
+    }
+
+    /**
+     * @brief Append the given character.
+     * 
+     * @param aChar Character.
+     */
+    void push_back(TChar aChar)
+    {
+        *grow_uninitialized(1u) = aChar;
+        commit(mLength + 1u);
+    }
+
+    /**
+     * @brief Append the given character.
+     * 
+     * @param aChar Character.
+     * @return This object.
+     */
+    CSimpleString<TChar, TAllocator>& operator+=(TChar aChar)
+    {
+        push_back(aChar);
+        return *this;
+    }
+
+    /**
+     * @brief Remove the last character. Does nothing if string is empty.
+     */
+    void pop_back()
+    {
+        if (mLength != 0u)
+        {
+            makeRoom(mLength - 1u, 1u, 0u);
+        }
+    }
+
+    /**
+     * @brief Change length of string. New characters are set to the given character.
+     * 
+     * @param aLength New length.
+     * @param aChar Character of new characters.
+     */
+    void resize(size_type aLength, TChar aChar = TChar())
+    {
+        if (aLength > mLength)
+        {
+            replace(mLength, 0u, aLength - mLength, aChar);
+        }
+        else
+        {
+            makeRoom(aLength, mLength - aLength, 0u);
+        }
+    }
+
+    /**
+     * @brief Remove all characters, memory is kept.
+     */
+    void clear()
+    {
+        makeRoom(0u, mLength, 0u);
+    }
+
+    /**
+     * @brief Replace every occurrence of the given character by the other one, in place (SIMD for 1 byte characters).
+     * 
+     * @param aFrom Replaced character.
+     * @param aTo New character.
+     */
+    void replace_all(TChar aFrom, TChar aTo) noexcept
+    {
+        CSimdSearch<TChar>::replaceChar(mDynamicArray, mDynamicArray + mLength, aFrom, aTo);
+    }
+
+    /**
+     * @brief Replace every occurrence of the given characters by the other ones, found by the SIMD search. If the text
+     * doesn't grow it is replaced in place in one pass. Otherwise occurrences are counted first (positions of the first
+     * ones are remembered) and segments are copied into memory allocated once.
+     * 
+     * @param aFrom Replaced characters, nothing is replaced if empty.
+     * @param aFromLength Number of replaced characters.
+     * @param aTo New characters.
+     * @param aToLength Number of new characters.
+     */
+    void replace_all(const TChar* aFrom, size_type aFromLength, const TChar* aTo, size_type aToLength)
+    {
+        if (aFromLength == 0u)
+        {
+            return ;
+        }
+        const std::less<const TChar*> less;
+        if ((less(aFrom, endPtr()) && less(beginPtr(), aFrom + aFromLength))
+            || (aToLength != 0u && less(aTo, endPtr()) && less(beginPtr(), aTo + aToLength)))
+        {
+            const CSimpleString<TChar, TAllocator> from{aFrom, aFromLength};
+            const CSimpleString<TChar, TAllocator> to{aTo, aToLength};
+            replace_all(from.mDynamicArray, aFromLength, to.mDynamicArray, aToLength);
+            return ;
+        }
+        std::array<size_type, sMatchCacheLength> positions;
+        size_type count = 0u;
+        for (size_type pos = CStringSearch<TChar>::find(mDynamicArray, mLength, aFrom, aFromLength, 0u); pos != gNpos;
+            pos = CStringSearch<TChar>::find(mDynamicArray, mLength, aFrom, aFromLength, pos + aFromLength))
+        {
+            if (count < positions.size())
+            {
+                positions[count] = pos;
+            }
+            ++count;
+            if (aToLength <= aFromLength)
+            {
+                // the result is not longer, the rest is found while characters are moved towards the beginning
+                commit(copyReplaced(mDynamicArray, positions.data(), 1u, aFrom, aFromLength, aTo, aToLength));
+                return ;
+            }
+        }
+        if (count == 0u)
+        {
+            return ;
+        }
+        CSimpleString<TChar, TAllocator> output;
+        const size_type length = mLength + count * (aToLength - aFromLength);
+        output.grow_uninitialized(length);
+        copyReplaced(output.mDynamicArray, positions.data(), std::min(count, positions.size()),
+            aFrom, aFromLength, aTo, aToLength);
+        output.commit(length);
+        *this = std::move(output);
+    }
+
+    /**
+     * @brief Replace every occurrence of the given string by the other one.
+     * 
+     * @param aFrom Replaced null terminated string.
+     * @param aTo New null terminated string.
+     */
+    void replace_all(const TChar* aFrom, const TChar* aTo)
+    {
+        replace_all(aFrom, txtLength(aFrom), aTo, txtLength(aTo));
+    }
+
+    /**
+     * @brief Replace every occurrence of the given string by the other one.
+     * 
+     * @param aFrom Replaced string.
+     * @param aTo New string.
+     */
+    void replace_all(const std::basic_string<TChar>& aFrom, const std::basic_string<TChar>& aTo)
+    {
+        replace_all(aFrom.data(), aFrom.size(), aTo.data(), aTo.size());
+    }
     
     /**
      * @brief Append the given string to this object.
@@ -840,7 +1253,7 @@ public:
      */
     const_reverse_iterator rbegin() const noexcept
     {
-       return std::make_reverse_iterator(&mDynamicArray[mLength]);
+       return const_reverse_iterator{const_iterator{&mDynamicArray[mLength]}};
     }
 
     /**
@@ -850,7 +1263,7 @@ public:
      */
     reverse_iterator rbegin() noexcept
     {
-       return std::make_reverse_iterator(&mDynamicArray[mLength]);
+       return reverse_iterator{iterator{&mDynamicArray[mLength]}};
     }
 
     /**
@@ -870,7 +1283,7 @@ public:
      */
     const_reverse_iterator rend() const noexcept
     {
-       return std::make_reverse_iterator(&mDynamicArray[0]);
+       return const_reverse_iterator{const_iterator{&mDynamicArray[0]}};
     }
 
     /**
@@ -880,7 +1293,7 @@ public:
      */
     reverse_iterator rend() noexcept
     {
-       return std::make_reverse_iterator(&mDynamicArray[0]);
+       return reverse_iterator{iterator{&mDynamicArray[0]}};
     }
 
     /**
@@ -892,10 +1305,491 @@ public:
     {
         return rend();
     }
-   
+
+    /**
+     * @brief Find the first occurrence of the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find(TChar aChar, size_type aPos = 0u) const noexcept
+    {
+        return CStringSearch<TChar>::find(beginPtr(), mLength, aChar, aPos);
+    }
+
+    /**
+     * @brief Find the first occurrence of the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::find(beginPtr(), mLength, aTxt, aLength, aPos);
+    }
+
+    /**
+     * @brief Find the first occurrence of the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find(const TChar* aTxt, size_type aPos = 0u) const noexcept
+    {
+        return find(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the first occurrence of the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the first occurrence of needle of the given searcher.
+     * 
+     * @tparam TKernels Search kernels of the searcher.
+     * @param aSearcher Searcher with precomputed tables.
+     * @param aPos Position where search starts.
+     * @return Index of the found needle or npos.
+     */
+    template<typename TKernels>
+    size_type find(const CSearcher<TChar, TKernels>& aSearcher, size_type aPos = 0u) const noexcept
+    {
+        return aSearcher.find(beginPtr(), mLength, aPos);
+    }
+
+    /**
+     * @brief Find the last occurrence of the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type rfind(TChar aChar, size_type aPos = npos) const noexcept
+    {
+        return CStringSearch<TChar>::rfind(beginPtr(), mLength, aChar, aPos);
+    }
+
+    /**
+     * @brief Find the last occurrence of the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where backward search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type rfind(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::rfind(beginPtr(), mLength, aTxt, aLength, aPos);
+    }
+
+    /**
+     * @brief Find the last occurrence of the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type rfind(const TChar* aTxt, size_type aPos = npos) const noexcept
+    {
+        return rfind(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the last occurrence of the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type rfind(const TString& aStr, size_type aPos = npos) const noexcept
+    {
+        return rfind(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the first character equal to the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_of(TChar aChar, size_type aPos = 0u) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, &aChar, 1u, aPos, true);
+    }
+
+    /**
+     * @brief Find the first character equal to one of characters in the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, aTxt, aLength, aPos, true);
+    }
+
+    /**
+     * @brief Find the first character equal to one of characters in the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_of(const TChar* aTxt, size_type aPos = 0u) const noexcept
+    {
+        return find_first_of(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the first character equal to one of characters in the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_first_of(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find_first_of(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the first character not equal to the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_not_of(TChar aChar, size_type aPos = 0u) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, &aChar, 1u, aPos, false);
+    }
+
+    /**
+     * @brief Find the first character not equal to any of characters in the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_not_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, aTxt, aLength, aPos, false);
+    }
+
+    /**
+     * @brief Find the first character not equal to any of characters in the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_not_of(const TChar* aTxt, size_type aPos = 0u) const noexcept
+    {
+        return find_first_not_of(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the first character not equal to any of characters in the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_first_not_of(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find_first_not_of(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the last character equal to the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_last_of(TChar aChar, size_type aPos = npos) const noexcept
+    {
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, &aChar, 1u, aPos, true);
+    }
+
+    /**
+     * @brief Find the last character equal to one of characters in the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where backward search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find_last_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, aTxt, aLength, aPos, true);
+    }
+
+    /**
+     * @brief Find the last character equal to one of characters in the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_last_of(const TChar* aTxt, size_type aPos = npos) const noexcept
+    {
+        return find_last_of(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the last character equal to one of characters in the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_last_of(const TString& aStr, size_type aPos = npos) const noexcept
+    {
+        return find_last_of(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the last character not equal to the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_last_not_of(TChar aChar, size_type aPos = npos) const noexcept
+    {
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, &aChar, 1u, aPos, false);
+    }
+
+    /**
+     * @brief Find the last character not equal to any of characters in the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where backward search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find_last_not_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, aTxt, aLength, aPos, false);
+    }
+
+    /**
+     * @brief Find the last character not equal to any of characters in the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_last_not_of(const TChar* aTxt, size_type aPos = npos) const noexcept
+    {
+        return find_last_not_of(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the last character not equal to any of characters in the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_last_not_of(const TString& aStr, size_type aPos = npos) const noexcept
+    {
+        return find_last_not_of(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Check if characters are valid UTF-8: no overlong encodings, surrogates, code points above U+10FFFF,
+     * unexpected continuation bytes or truncated code points. Only for 1 byte characters (char, char8_t).
+     * 
+     * @return true if valid.
+     */
+    bool is_valid_utf8() const noexcept
+    {
+        return CUtf8<TChar>::isValid(beginPtr(), mLength);
+    }
+
+    /**
+     * @brief Return number of UTF-8 code points. Characters are expected to be valid UTF-8 (see is_valid_utf8),
+     * otherwise bytes that aren't continuation bytes are counted.
+     * 
+     * @return Number of code points.
+     */
+    size_type count_code_points() const noexcept
+    {
+        return CUtf8<TChar>::countCodePoints(beginPtr(), mLength);
+    }
+
+    /**
+     * @brief Return number of characters of the longest prefix of at most the given number of UTF-8 code points, so
+     * truncating the string to it never splits a code point: str.resize(str.utf8_prefix_of_width(20u)).
+     * 
+     * @param aWidth Maximal number of code points.
+     * @return Number of characters (bytes) of the prefix.
+     */
+    size_type utf8_prefix_of_width(size_type aWidth) const noexcept
+    {
+        return CUtf8<TChar>::prefixOfWidth(beginPtr(), mLength, aWidth);
+    }
+
+private:
+
+    /**
+     * @brief Number of positions of matches remembered by replace_all, so they are not searched again.
+     */
+    static constexpr size_type sMatchCacheLength = 32u;
+
+    /**
+     * @brief Copy characters of this string to aDest replacing every occurrence of aFrom by aTo. aDest can be the
+     * memory of this string if the result is not longer.
+     * 
+     * @param aDest Destination.
+     * @param aPositions Positions of the first matches, the next ones are searched.
+     * @param aPositionCount Number of positions, at least 1.
+     * @param aFrom Replaced characters.
+     * @param aFromLength Number of replaced characters, not 0.
+     * @param aTo New characters.
+     * @param aToLength Number of new characters.
+     * @return Number of characters of the result.
+     */
+    size_type copyReplaced(TChar* aDest, const size_type* aPositions, size_type aPositionCount,
+        const TChar* aFrom, size_type aFromLength, const TChar* aTo, size_type aToLength) noexcept
+    {
+        const TChar* const src = mDynamicArray;
+        TChar* dest = aDest;
+        size_type begin = 0u;
+        for (size_type i = 0u, pos = aPositions[0]; pos != gNpos; ++i)
+        {
+            std::char_traits<TChar>::move(dest, src + begin, pos - begin);
+            dest += pos - begin;
+            std::char_traits<TChar>::copy(dest, aTo, aToLength);
+            dest += aToLength;
+            begin = pos + aFromLength;
+            pos = i + 1u < aPositionCount
+                ? aPositions[i + 1u]
+                : CStringSearch<TChar>::find(src, mLength, aFrom, aFromLength, begin);
+        }
+        std::char_traits<TChar>::move(dest, src + begin, mLength - begin);
+        return static_cast<size_type>(dest - aDest) + mLength - begin;
+    }
+
+    /**
+     * @brief Replace aRemoved characters at aPos by aInserted uninitialized characters. Characters after the replaced
+     * ones are moved once: within the current memory, or to new memory that grows at least twice.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aRemoved Number of removed characters, up to the end of string if too big.
+     * @param aInserted Number of inserted characters.
+     * @return Pointer to the first inserted character.
+     */
+    TChar* makeRoom(size_type aPos, size_type aRemoved, size_type aInserted)
+    {
+        aPos = std::min(aPos, mLength);
+        aRemoved = std::min(aRemoved, mLength - aPos);
+        const size_type tailPos = aPos + aRemoved;
+        const size_type tailLength = mLength - tailPos;
+        const size_type newLength = mLength - aRemoved + aInserted;
+        const size_type fullLength = newLength + 1u;
+        if (mDynamicArray == nullptr && newLength == 0u)
+        {
+            // empty string without memory
+            return mDynamicArray;
+        }
+        if (mAllocatedLength >= fullLength)
+        {
+            std::char_traits<TChar>::move(mDynamicArray + aPos + aInserted, mDynamicArray + tailPos, tailLength);
+        }
+        else
+        {
+            const size_type newAllocatedLength = std::max(fullLength, 2u * mAllocatedLength);
+            auto ptr = mAllocator.allocate(newAllocatedLength);
+            internalMemcpy(ptr, mDynamicArray, aPos);
+            internalMemcpy(ptr + aPos + aInserted, mDynamicArray + tailPos, tailLength);
+            mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+            mAllocatedLength = newAllocatedLength;
+            mDynamicArray = ptr;
+        }
+        mLength = newLength;
+        mDynamicArray[newLength] = '\0';
+        return mDynamicArray + aPos;
+    }
+
+    /**
+     * @brief Return pointer to the first character in string.
+     * 
+     * @return Pointer to the first character in string.
+     */
+    const TChar* beginPtr() const noexcept
+    {
+        return mDynamicArray;
+    }
+
+    /**
+     * @brief Return pointer to the character after the last.
+     * 
+     * @return Pointer to the character after the last.
+     */
+    const TChar* endPtr() const noexcept
+    {
+        return mDynamicArray + mLength;
+    }
+};
+
+/**
+ * @brief CSimpleString is a pointer to dynamic memory with lengths, so it is trivially relocatable if its allocator is.
+ *
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ */
+template<typename TChar, typename TAllocator>
+struct CIsTriviallyRelocatable<CSimpleString<TChar, TAllocator>> : CIsTriviallyRelocatable<TAllocator>
+{
 };
 
 
+/**
+ * @brief Swap characters of strings, see CSimpleString::swap.
+ *
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @param aObj1 First string.
+ * @param aObj2 Second string.
+ */
+template<typename TChar, typename TAllocator>
+void swap(CSimpleString<TChar, TAllocator>& aObj1, CSimpleString<TChar, TAllocator>& aObj2)
+    noexcept(noexcept(aObj1.swap(aObj2)))
+{
+    aObj1.swap(aObj2);
+}
+
 /**
  * @brief Compare strings.
  * 
@@ -1015,6 +1909,68 @@ bool operator==(
 }
 
 
+/**
+ * @brief Compare string with a literal of known length: no characters are counted, lengths are compared before
+ * characters.
+ * 
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @param aObj String to compare.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @return true if there are equal.
+ */
+template<typename TChar, typename TAllocator>
+bool operator==(const CSimpleString<TChar, TAllocator>& aObj, const CStaticString<TChar>& aLiteral) noexcept
+{
+    return aObj.size() == aLiteral.size() && aLiteral.equals(aObj.data());
+}
+
+/**
+ * @brief Compare string with a literal of known length, see the other operator.
+ * 
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @param aObj String to compare.
+ * @return true if there are equal.
+ */
+template<typename TChar, typename TAllocator>
+bool operator==(const CStaticString<TChar>& aLiteral, const CSimpleString<TChar, TAllocator>& aObj) noexcept
+{
+    return aObj == aLiteral;
+}
+
+/**
+ * @brief Compare string with a literal of known length.
+ * 
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @param aObj String to compare.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @return true if there are not equal.
+ */
+template<typename TChar, typename TAllocator>
+bool operator!=(const CSimpleString<TChar, TAllocator>& aObj, const CStaticString<TChar>& aLiteral) noexcept
+{
+    return !(aObj == aLiteral);
+}
+
+/**
+ * @brief Compare string with a literal of known length.
+ * 
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @param aObj String to compare.
+ * @return true if there are not equal.
+ */
+template<typename TChar, typename TAllocator>
+bool operator!=(const CStaticString<TChar>& aLiteral, const CSimpleString<TChar, TAllocator>& aObj) noexcept
+{
+    return !(aObj == aLiteral);
+}
+
+
 //////////////////////////////////// !=
 
 
@@ -1568,6 +2524,56 @@ std::basic_ostream<TCharStream, std::char_traits<TCharStream>>&
     return aStream;
 }
 
+/**
+ * @brief Read characters up to the delimiter into the string (its memory is reused), like std::getline.
+ * 
+ * @tparam TChar type of characters in the string.
+ * @tparam TAllocator Allocator type.
+ * @param aStream Stream
+ * @param aString String
+ * @param aDelim Delimiter, extracted but not stored.
+ * 
+ * @return Stream.
+ */
+template<typename TChar, typename TAllocator>
+std::basic_istream<TChar>& getline(std::basic_istream<TChar>& aStream, CSimpleString<TChar, TAllocator>& aString,
+    TChar aDelim)
+{
+    return CStreamRead<TChar>::getline(aStream, aString, aDelim);
+}
+
+/**
+ * @brief Read a line into the string (its memory is reused), like std::getline.
+ * 
+ * @tparam TChar type of characters in the string.
+ * @tparam TAllocator Allocator type.
+ * @param aStream Stream
+ * @param aString String
+ * 
+ * @return Stream.
+ */
+template<typename TChar, typename TAllocator>
+std::basic_istream<TChar>& getline(std::basic_istream<TChar>& aStream, CSimpleString<TChar, TAllocator>& aString)
+{
+    return CStreamRead<TChar>::getline(aStream, aString, aStream.widen('\n'));
+}
+
+/**
+ * @brief Read a word (characters up to a whitespace) into the string, like operator>> of std::basic_string.
+ * 
+ * @tparam TChar type of characters in the string.
+ * @tparam TAllocator Allocator type.
+ * @param aStream Stream
+ * @param aString String
+ * 
+ * @return Stream.
+ */
+template<typename TChar, typename TAllocator>
+std::basic_istream<TChar>& operator>>(std::basic_istream<TChar>& aStream, CSimpleString<TChar, TAllocator>& aString)
+{
+    return CStreamRead<TChar>::readWord(aStream, aString);
+}
+
 } // namespace NSSO
 
 #endif // SIMPLE_STRING_HPP_
@@ -17,8 +17,25 @@
 #include <iterator>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <charconv>
+#include <limits>
+#include <memory>
+#include <new>
 #include <type_traits>
+#include <vector>
 #include "internal/InternalHelper.hpp"
+#include "internal/Search.hpp"
+#include "internal/Utf8.hpp"
+#include "internal/StreamRead.hpp"
+#include "Relocation.hpp"
+#include "Searcher.hpp"
+#include "SsoProfiler.hpp"
+#include "StaticString.hpp"
+#include "StringPolicy.hpp"
 
 namespace NSSO
 {
@@ -238,7 +255,7 @@ public:
     }
 };
 
-template<std::size_t TSmallStringOptLength, typename TChar, typename TAllocator>
+template<std::size_t TSmallStringOptLength, typename TChar, typename TAllocator, typename TPolicy>
 class CSmallStringOpt;
 
 /**
@@ -247,8 +264,13 @@ class CSmallStringOpt;
  * @tparam TSmallStringOptLength The size of characters array, that holds small strings.
  * @tparam TChar Type of character.
  * @tparam TAllocator Allocator.
+ * @tparam TPolicy Memory management policy, see StringPolicy.hpp.
  */
-template<std::size_t TSmallStringOptLength, typename TChar = char, typename TAllocator = std::allocator<TChar>>
+template<
+    std::size_t TSmallStringOptLength,
+    typename TChar = char,
+    typename TAllocator = std::allocator<TChar>,
+    typename TPolicy = CDefaultStringPolicy>
 class CSmallStringOpt
 {
 public:
@@ -302,12 +324,17 @@ public:
      */
     static constexpr size_type sSmallStringOptLength = TSmallStringOptLength;
 
+    /**
+     * @brief Value returned by search functions if nothing is found.
+     */
+    static constexpr size_type npos = gNpos;
+
 private:
 
     /**
      * @brief Type use for casts.
      */
-    using this_const_pointer = const CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator>* ;
+    using this_const_pointer = const CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>* ;
     
 private:
 
@@ -342,7 +369,7 @@ private:
     allocator_type mAllocator;
 
 
-    template<std::size_t _TSmallStringOptLength, typename _TChar, typename _TAllocator>
+    template<std::size_t _TSmallStringOptLength, typename _TChar, typename _TAllocator, typename _TPolicy>
     friend class CSmallStringOpt;
 
     /**
@@ -352,17 +379,218 @@ private:
      * @param aSrc  Source address.
      * @param aLength Number of characters to copy
      */
-    void internalMemcpy(TChar* aDest, const TChar* aSrc, size_type aLength)
+    NSSO_CONSTEXPR20 void internalMemcpy(TChar* aDest, const TChar* aSrc, size_type aLength)
     {
         CFast<TChar>::memcpy(aDest, aSrc,  aLength * sizeof(TChar));
     }
 
+    /**
+     * @brief Record the given operation in the profiler. Does nothing if NSSO_ENABLE_PROFILER is not defined.
+     * 
+     * @param aOperation Operation.
+     * @param aWasInline True if characters were in the small string optimization array before the operation.
+     */
+    NSSO_CONSTEXPR20 void profile(ESsoOperation aOperation, bool aWasInline) const noexcept
+    {
+        if (isConstantEvaluated())
+        {
+            return ;
+        }
+        ESsoPlacement placement = ESsoPlacement::eInline;
+        if (false == mSmallStringOptEnable)
+        {
+            placement = aWasInline ? ESsoPlacement::eSpill : ESsoPlacement::eHeap;
+        }
+        CSsoProfilerHook<TSmallStringOptLength, TChar>::record(aOperation, placement, mLength);
+    }
+
+    /**
+     * @brief Type of reference counter placed before characters in dynamic memory if copy on write is enabled.
+     */
+    using TRefCount = std::atomic<size_type>;
+
+    /**
+     * @brief Number of characters occupied by the reference counter in dynamic memory.
+     */
+    static constexpr size_type sRefCountLength = TPolicy::sCopyOnWrite
+        ? (sizeof(TRefCount) + sizeof(TChar) - 1u) / sizeof(TChar)
+        : 0u;
+
+    /**
+     * @brief Value of reference counter of dynamic memory that cannot be shared, because a non-constant reference
+     * to its characters was returned.
+     */
+    static constexpr size_type sUnshareable = std::numeric_limits<size_type>::max();
+
+    /**
+     * @brief True if move assignment can take over dynamic memory of the given string without allocating, because
+     * the allocator is propagated on move assignment or all its instances are equal.
+     */
+    static constexpr bool sMoveTakesMemory =
+        std::allocator_traits<TAllocator>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<TAllocator>::is_always_equal::value;
+
+    /**
+     * @brief True if swap can exchange dynamic memory without allocating, because the allocator is propagated on swap
+     * or all its instances are equal.
+     */
+    static constexpr bool sSwapTakesMemory =
+        std::allocator_traits<TAllocator>::propagate_on_container_swap::value
+        || std::allocator_traits<TAllocator>::is_always_equal::value;
+
+    /**
+     * @brief Return reference counter of the given dynamic memory. Used only if copy on write is enabled.
+     * 
+     * @param aPtr Pointer returned by allocateBuffer.
+     * @return Reference counter.
+     */
+    static TRefCount& refCount(const TChar* aPtr) noexcept
+    {
+        return *reinterpret_cast<TRefCount*>(const_cast<TChar*>(aPtr) - sRefCountLength);
+    }
+
+    /**
+     * @brief Allocate dynamic memory for the given number of characters. If copy on write is enabled the reference
+     * counter set to 1 is placed before characters.
+     * 
+     * @param aLength Number of characters.
+     * @return Pointer to the first character.
+     */
+    TChar* allocateBuffer(size_type aLength) noexcept(noexcept(mAllocator.allocate(0u)))
+    {
+        TChar* ptr = mAllocator.allocate(aLength + sRefCountLength);
+        if constexpr (TPolicy::sCopyOnWrite)
+        {
+            new (ptr) TRefCount{1u};
+            ptr += sRefCountLength;
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief Release dynamic memory. If copy on write is enabled memory is deallocated only by the last owner.
+     * 
+     * @param aPtr Pointer returned by allocateBuffer or nullptr.
+     * @param aLength Number of characters given to allocateBuffer.
+     */
+    NSSO_CONSTEXPR20 void deallocateBuffer(TChar* aPtr, size_type aLength) noexcept
+    {
+        if (aPtr == nullptr)
+        {
+            return ;
+        }
+        if constexpr (TPolicy::sCopyOnWrite)
+        {
+            TRefCount& counter = refCount(aPtr);
+            // unshareable memory has only one owner
+            if (counter.load(std::memory_order_acquire) != sUnshareable
+                && counter.fetch_sub(1u, std::memory_order_acq_rel) != 1u)
+            {
+                return ;
+            }
+            counter.~TRefCount();
+            aPtr -= sRefCountLength;
+        }
+        mAllocator.deallocate(aPtr, aLength + sRefCountLength);
+    }
+
+    /**
+     * @brief Check if dynamic memory is shared with another string.
+     * 
+     * @return true if dynamic memory is shared.
+     */
+    bool isShared() const noexcept
+    {
+        if constexpr (TPolicy::sCopyOnWrite)
+        {
+            if (mDynamicArray != nullptr)
+            {
+                const size_type count = refCount(mDynamicArray).load(std::memory_order_acquire);
+                return count != 1u && count != sUnshareable;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check if the given string's dynamic memory can be shared with this string instead of copying.
+     * 
+     * @tparam TObjNoChar Number of characters used for small string optimization in the given object.
+     * @param aObj String to copy.
+     * @return true if dynamic memory can be shared.
+     */
+    template<size_type TObjNoChar>
+    bool canShare(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj) const noexcept
+    {
+        if constexpr (TPolicy::sCopyOnWrite)
+        {
+            return false == aObj.mSmallStringOptEnable
+                && aObj.mLength + 1u > sSmallStringOptLength
+                && refCount(aObj.mDynamicArray).load(std::memory_order_acquire) != sUnshareable;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Share dynamic memory of the given string. Own dynamic memory has to be released before.
+     * 
+     * @tparam TObjNoChar Number of characters used for small string optimization in the given object.
+     * @param aObj String to share dynamic memory with.
+     */
+    template<size_type TObjNoChar>
+    void shareBuffer(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj) noexcept
+    {
+        refCount(aObj.mDynamicArray).fetch_add(1u, std::memory_order_relaxed);
+        mDynamicArray = aObj.mDynamicArray;
+        mAllocatedLength = aObj.mAllocatedLength;
+        mSmallStringOptEnable = false;
+    }
+
+    /**
+     * @brief Clone shared dynamic memory and mark it as unshareable, because a non-constant reference to characters
+     * is going to be returned. Does nothing if copy on write is disabled.
+     */
+    void unshare() noexcept(!TPolicy::sCopyOnWrite)
+    {
+        if constexpr (TPolicy::sCopyOnWrite)
+        {
+            if (false == mSmallStringOptEnable)
+            {
+                if (isShared())
+                {
+                    TChar* ptr = allocateBuffer(mAllocatedLength);
+                    internalMemcpy(ptr, mDynamicArray, mLength + 1u);
+                    deallocateBuffer(mDynamicArray, mAllocatedLength);
+                    mDynamicArray = ptr;
+                }
+                refCount(mDynamicArray).store(sUnshareable, std::memory_order_release);
+            }
+        }
+    }
+
+    /**
+     * @brief Let dynamic memory marked as unshareable by unshare be shared again. Called by modifications that reuse
+     * dynamic memory, because they invalidate references to characters. Does nothing if copy on write is disabled.
+     */
+    NSSO_CONSTEXPR20 void resetShareable() noexcept
+    {
+        if constexpr (TPolicy::sCopyOnWrite)
+        {
+            if (mDynamicArray != nullptr
+                && refCount(mDynamicArray).load(std::memory_order_acquire) == sUnshareable)
+            {
+                // unshareable memory has only one owner
+                refCount(mDynamicArray).store(1u, std::memory_order_release);
+            }
+        }
+    }
+
 public:
 
     /**
      * @brief Construct empy string.
      */
-    CSmallStringOpt() noexcept
+    NSSO_CONSTEXPR20 CSmallStringOpt() noexcept
         : mSmallStringOptEnable{ true }
         , mLength{0u}
         , mArray{}
@@ -379,27 +607,33 @@ public:
      * @param aObj String to copy.
      */
     template<size_type TObjNoChar>
-    explicit CSmallStringOpt(const CSmallStringOpt<TObjNoChar, TChar, TAllocator>& aObj)  noexcept(noexcept(mAllocator.allocate(0u)))
+    explicit CSmallStringOpt(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj)  noexcept(noexcept(mAllocator.allocate(0u)))
         : mSmallStringOptEnable{ true }
-        , mLength{0u}
+        , mLength{aObj.mLength}
         , mArray{}
         , mDynamicArray{nullptr}
         , mAllocatedLength{ 0 }
         , mAllocator{} 
     {
-        const size_type lengthToCopy = mLength + 1u;
-        TChar* ptr = nullptr;
-        if (sSmallStringOptLength < lengthToCopy)
+        if (canShare(aObj))
         {
-            mAllocatedLength = lengthToCopy;
-            mDynamicArray = mAllocator.allocate(lengthToCopy);
-            mSmallStringOptEnable = false;
+            shareBuffer(aObj);
         }
-        internalMemcpy(
-            beginPtr(),
-            aObj.beginPtr(), 
-            lengthToCopy);
-
+        else
+        {
+            const size_type lengthToCopy = mLength + 1u;
+            if (sSmallStringOptLength < lengthToCopy)
+            {
+                mAllocatedLength = lengthToCopy;
+                mDynamicArray = allocateBuffer(lengthToCopy);
+                mSmallStringOptEnable = false;
+            }
+            internalMemcpy(
+                beginPtr(),
+                aObj.beginPtr(), 
+                lengthToCopy);
+        }
+        profile(ESsoOperation::eConstruct, true);
     }
 
     /**
@@ -407,78 +641,108 @@ public:
      * 
      * @param aObj string to copy.
      */
-    explicit CSmallStringOpt(const CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator>& aObj) noexcept(noexcept(mAllocator.allocate(0u)))
-        : mSmallStringOptEnable{ aObj.mSmallStringOptEnable }
+    explicit CSmallStringOpt(const CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept(noexcept(mAllocator.allocate(0u)))
+        : mSmallStringOptEnable{ true }
         , mLength{aObj.mLength}
         , mArray{}
         , mDynamicArray{nullptr}
         , mAllocatedLength{ 0 }
         , mAllocator{} 
     {
-        const size_type lengthToCopy = mLength + 1u;
-        if (lengthToCopy > sSmallStringOptLength)
+        if (canShare(aObj))
         {
-            mAllocatedLength = lengthToCopy;
-            mDynamicArray = mAllocator.allocate(lengthToCopy);
-            mSmallStringOptEnable = false;
+            shareBuffer(aObj);
         }
-        internalMemcpy(
-            beginPtr(),
-            aObj.beginPtr(), 
-            lengthToCopy);
+        else
+        {
+            const size_type lengthToCopy = mLength + 1u;
+            if (lengthToCopy > sSmallStringOptLength)
+            {
+                mAllocatedLength = lengthToCopy;
+                mDynamicArray = allocateBuffer(lengthToCopy);
+                mSmallStringOptEnable = false;
+            }
+            internalMemcpy(
+                beginPtr(),
+                aObj.beginPtr(), 
+                lengthToCopy);
+        }
+        profile(ESsoOperation::eConstruct, true);
     }
 
     /**
-     * @brief Construct string
+     * @brief Construct string. Unlike the move constructor it may allocate: characters that fit into the bigger small
+     * string optimization array of the given object are copied to dynamic memory, so it is noexcept only if the
+     * allocator doesn't throw.
      * 
      * @tparam TObjNoChar Number of characters used for small string optimization in the given object.
      * @param aObj String to move.
      */
     template<size_type TObjNoChar>
-    CSmallStringOpt(CSmallStringOpt<TObjNoChar>&& aObj) noexcept(noexcept(mAllocator.allocate(0u)))
+    CSmallStringOpt(CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>&& aObj) noexcept(noexcept(mAllocator.allocate(0u)))
         : mSmallStringOptEnable(true)
         , mLength(aObj.mLength)
         , mArray{}
         , mDynamicArray{ nullptr }
         , mAllocatedLength{ 0u }
-        , mAllocator{}
+        , mAllocator{ aObj.mAllocator }
     {
         const auto lengthToCopy = mLength + 1u;
-        if (lengthToCopy > sSmallStringOptLength)
+        if (lengthToCopy <= sSmallStringOptLength)
+        {
+            internalMemcpy(mArray.data(), aObj.beginPtr(), lengthToCopy);
+        }
+        else if (false == aObj.mSmallStringOptEnable)
         {
             std::swap(mAllocatedLength, aObj.mAllocatedLength);
             std::swap(mDynamicArray, aObj.mDynamicArray);
             mSmallStringOptEnable = false;
+            // the given object is left empty
+            aObj.mSmallStringOptEnable = true;
+            aObj.mLength = 0u;
+            aObj.mArray[0] = '\0';
         }
         else
         {
-            internalMemcpy(mArray.data(), aObj.beginPtr(), lengthToCopy);
+            // characters are in the bigger small string optimization array of the given object
+            mAllocatedLength = lengthToCopy;
+            mDynamicArray = allocateBuffer(lengthToCopy);
+            internalMemcpy(mDynamicArray, aObj.mArray.data(), lengthToCopy);
+            mSmallStringOptEnable = false;
         }
     }
 
     /**
      * @brief Construct string. Move constructor required even there is template based constructor. Move constructor needs to be declared.
+     * It never allocates, so std::vector relocates strings by moving them instead of copying.
      * 
-     * @param aObj String to move.
+     * @param aObj String to move. It is left empty if its dynamic memory is taken over.
      */
-    CSmallStringOpt(CSmallStringOpt<TSmallStringOptLength>&& aObj) noexcept(noexcept(mAllocator.allocate(0u)))
+    NSSO_CONSTEXPR20 CSmallStringOpt(CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>&& aObj) noexcept
         : mSmallStringOptEnable(true)
         , mLength(aObj.mLength)
         , mArray{}
         , mDynamicArray{ nullptr }
         , mAllocatedLength{ 0u }
-        , mAllocator{}
+        , mAllocator{ aObj.mAllocator }
     {
         const auto lengthToCopy = mLength + 1u;
-        if (lengthToCopy > sSmallStringOptLength)
+        if (lengthToCopy <= sSmallStringOptLength)
         {
-            std::swap(mAllocatedLength, aObj.mAllocatedLength);
-            std::swap(mDynamicArray, aObj.mDynamicArray);
-            mSmallStringOptEnable = false;
+            // the same array size, so characters of the given object always fit here
+            internalMemcpy(mArray.data(), aObj.beginPtr(), lengthToCopy);
         }
         else
         {
-            internalMemcpy(mArray.data(), aObj.beginPtr(), lengthToCopy);
+            mDynamicArray = aObj.mDynamicArray;
+            mAllocatedLength = aObj.mAllocatedLength;
+            mSmallStringOptEnable = false;
+            // the given object is left empty
+            aObj.mDynamicArray = nullptr;
+            aObj.mAllocatedLength = 0u;
+            aObj.mSmallStringOptEnable = true;
+            aObj.mLength = 0u;
+            aObj.mArray[0] = '\0';
         }
     }
 
@@ -487,7 +751,7 @@ public:
      * 
      * @param aTxt String array.
      */
-    explicit CSmallStringOpt(const TChar* aTxt) noexcept(noexcept(CSmallStringOpt(nullptr, 0u)))
+    NSSO_CONSTEXPR20 explicit CSmallStringOpt(const TChar* aTxt) noexcept(noexcept(CSmallStringOpt(nullptr, 0u)))
         : CSmallStringOpt(aTxt, txtLength(aTxt))
     {}
 
@@ -497,7 +761,7 @@ public:
      * @param aTxt String array.
      * @param aLength Length of string. Don't need to be null terminated.
      */
-    CSmallStringOpt(const TChar* aTxt, size_type aLength) noexcept(noexcept(mAllocator.allocate(0u)))
+    NSSO_CONSTEXPR20 CSmallStringOpt(const TChar* aTxt, size_type aLength) noexcept(noexcept(mAllocator.allocate(0u)))
         : mSmallStringOptEnable(true)
         , mLength(aLength)
         , mArray{}
@@ -511,7 +775,7 @@ public:
         {
             mSmallStringOptEnable = false;
             mAllocatedLength = lengthToCopy;
-            mDynamicArray = mAllocator.allocate(mAllocatedLength);
+            mDynamicArray = allocateBuffer(mAllocatedLength);
             ptr = mDynamicArray;
         }
         internalMemcpy(
@@ -519,6 +783,7 @@ public:
             aTxt,
             aLength);
         ptr[aLength] = '\0';
+        profile(ESsoOperation::eConstruct, true);
     }
 
     /**
@@ -536,7 +801,7 @@ public:
      * @param aObj Object to copy its character to this string.
      * @return CSmallStringOpt& This object.
      */
-    CSmallStringOpt& operator=(const CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator>& aObj) 
+    CSmallStringOpt& operator=(const CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) 
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
         assign(aObj);
@@ -551,13 +816,64 @@ public:
      * @return CSmallStringOpt& This object.
      */
     template<size_type TObjNoChar>
-    CSmallStringOpt& operator=(const CSmallStringOpt<TObjNoChar, TChar, TAllocator>& aObj) 
+    CSmallStringOpt& operator=(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj) 
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
         assign(aObj);
         return *this;
     }
 
+    /**
+     * @brief Move assignment operator. Dynamic memory of the given object is taken over, so it doesn't allocate unless
+     * the allocator isn't propagated on move assignment and the allocators differ.
+     * 
+     * @param aObj Object to move its character to this string. It is left empty if its dynamic memory is taken over.
+     * @return CSmallStringOpt& This object.
+     */
+    CSmallStringOpt& operator=(CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>&& aObj)
+        noexcept(sMoveTakesMemory)
+    {
+        if (this == &aObj)
+        {
+            return *this;
+        }
+        if constexpr (false == sMoveTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                assign(aObj);
+                return *this;
+            }
+        }
+        const bool wasInline = mSmallStringOptEnable;
+        if (aObj.mSmallStringOptEnable)
+        {
+            internalMemcpy(mArray.data(), aObj.mArray.data(), aObj.mLength + 1u);
+            mSmallStringOptEnable = true;
+            mLength = aObj.mLength;
+        }
+        else
+        {
+            deallocateBuffer(mDynamicArray, mAllocatedLength);
+            if constexpr (std::allocator_traits<TAllocator>::propagate_on_container_move_assignment::value)
+            {
+                mAllocator = aObj.mAllocator;
+            }
+            mDynamicArray = aObj.mDynamicArray;
+            mAllocatedLength = aObj.mAllocatedLength;
+            mSmallStringOptEnable = false;
+            mLength = aObj.mLength;
+            // the given object is left empty
+            aObj.mDynamicArray = nullptr;
+            aObj.mAllocatedLength = 0u;
+            aObj.mSmallStringOptEnable = true;
+            aObj.mLength = 0u;
+            aObj.mArray[0] = '\0';
+        }
+        profile(ESsoOperation::eAssign, wasInline);
+        return *this;
+    }
+
     /**
      * @brief Move assignment operator. 
      * 
@@ -566,9 +882,18 @@ public:
      * @return CSmallStringOpt& This object.
      */
     template<size_type TObjNoChar>
-    CSmallStringOpt& operator=(CSmallStringOpt<TObjNoChar>&& aObj) 
+    CSmallStringOpt& operator=(CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>&& aObj) 
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
+        if constexpr (false == sMoveTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                assign(aObj);
+                return *this;
+            }
+        }
+        const bool wasInline = mSmallStringOptEnable;
         const auto requiredLength = aObj.mLength + 1u;
         if (aObj.mSmallStringOptEnable)
         {
@@ -579,15 +904,16 @@ public:
             }
             else
             {
-                if (requiredLength <= mAllocatedLength)
+                if (requiredLength <= mAllocatedLength && false == isShared())
                 {
                     internalMemcpy(mDynamicArray, aObj.mArray.data(), requiredLength);
+                    resetShareable();
                 }
                 else
                 {
-                    mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+                    deallocateBuffer(mDynamicArray, mAllocatedLength);
                     mAllocatedLength = requiredLength;
-                    mDynamicArray = mAllocator.allocate(requiredLength);
+                    mDynamicArray = allocateBuffer(requiredLength);
                     internalMemcpy(mDynamicArray, aObj.mArray.data(), requiredLength);
                 }
                 mSmallStringOptEnable = false;
@@ -595,13 +921,28 @@ public:
         }
         else
         {
+            if constexpr (std::allocator_traits<TAllocator>::propagate_on_container_move_assignment::value)
+            {
+                // the previous dynamic memory of this string may come from a different allocator, so it is released
+                deallocateBuffer(mDynamicArray, mAllocatedLength);
+                mDynamicArray = nullptr;
+                mAllocatedLength = 0u;
+                mAllocator = aObj.mAllocator;
+            }
             std::swap(mDynamicArray, aObj.mDynamicArray);
             std::swap(mAllocatedLength, aObj.mAllocatedLength);
-            aObj.mSmallStringOptEnable = mSmallStringOptEnable;
             mSmallStringOptEnable = false;
+            mLength = aObj.mLength;
+            // the given object gets the previous dynamic memory of this string (if any) and is left empty
+            aObj.mSmallStringOptEnable = true;
+            aObj.mLength = 0u;
+            aObj.mArray[0] = '\0';
+            profile(ESsoOperation::eAssign, wasInline);
+            return *this;
         }
         
         mLength = aObj.mLength;
+        profile(ESsoOperation::eAssign, wasInline);
         
         return *this;
     }
@@ -612,7 +953,7 @@ public:
      * @param aTxt String array to copy.
      * @return CSmallStringOpt& This object.
      */
-    CSmallStringOpt& operator=(const TChar* aTxt) noexcept(this->assign(nullptr, 0))
+    CSmallStringOpt& operator=(const TChar* aTxt) noexcept(noexcept(assign(nullptr, 0u)))
     {
         assign(aTxt);
         return *this;
@@ -624,19 +965,56 @@ public:
      * @param aTxt std::string to copy.
      * @return CSmallStringOpt& This object.
      */
-    CSmallStringOpt& operator=(const std::basic_string<TChar>& aTxt) noexcept(this->assign(nullptr, 0))
+    CSmallStringOpt& operator=(const std::basic_string<TChar>& aTxt) noexcept(noexcept(assign(nullptr, 0u)))
     {
         assign(aTxt);
         return *this;
     }
 
+    /**
+     * @brief Swap characters of strings. Small string optimization arrays are swapped directly if any of strings keeps
+     * characters there, otherwise only pointers to dynamic memory are swapped. Nothing is allocated unless
+     * the allocator isn't propagated on swap and the allocators differ, then characters are copied.
+     * 
+     * @param aObj String to swap with.
+     */
+    void swap(CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept(sSwapTakesMemory)
+    {
+        if (this == &aObj)
+        {
+            return ;
+        }
+        if constexpr (false == sSwapTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                CSmallStringOpt<TSmallStringOptLength, TChar, TAllocator, TPolicy> tmp{std::move(aObj)};
+                aObj = std::move(*this);
+                *this = std::move(tmp);
+                return ;
+            }
+        }
+        if constexpr (std::allocator_traits<TAllocator>::propagate_on_container_swap::value)
+        {
+            std::swap(mAllocator, aObj.mAllocator);
+        }
+        if (mSmallStringOptEnable || aObj.mSmallStringOptEnable)
+        {
+            std::swap(mArray, aObj.mArray);
+        }
+        std::swap(mSmallStringOptEnable, aObj.mSmallStringOptEnable);
+        std::swap(mLength, aObj.mLength);
+        std::swap(mDynamicArray, aObj.mDynamicArray);
+        std::swap(mAllocatedLength, aObj.mAllocatedLength);
+    }
+
     /**
      * @brief Destroy the instance. Deallocates memory if required.
      * 
      */
-    ~CSmallStringOpt() 
+    NSSO_CONSTEXPR20 ~CSmallStringOpt() 
     {
-        mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+        deallocateBuffer(mDynamicArray, mAllocatedLength);
     }
 
     /**
@@ -644,7 +1022,7 @@ public:
      * 
      * @return true if empty.
      */
-    bool empty() const noexcept
+    NSSO_CONSTEXPR20 bool empty() const noexcept
     {
         return mLength == 0u;
     }
@@ -659,18 +1037,19 @@ public:
         {
             if (true == mSmallStringOptEnable)
             {
-                mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+                deallocateBuffer(mDynamicArray, mAllocatedLength);
                 mDynamicArray = nullptr;
+                mAllocatedLength = 0u;
             }
             else if (mAllocatedLength > mLength + 1u)
             {
                 const size_type lengthToCopy = mLength + 1u;
-                pointer ptr = mAllocator.allocate(lengthToCopy);
+                pointer ptr = allocateBuffer(lengthToCopy);
                 internalMemcpy(
                     ptr,
                     mDynamicArray,
                     lengthToCopy);
-                mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+                deallocateBuffer(mDynamicArray, mAllocatedLength);
                 mDynamicArray = ptr;
                 mAllocatedLength = lengthToCopy;
             }
@@ -680,7 +1059,7 @@ public:
     /**
      * @brief Length of string.
      */
-    size_type size() const noexcept
+    NSSO_CONSTEXPR20 size_type size() const noexcept
     {
         return mLength;
     }
@@ -690,7 +1069,7 @@ public:
      * 
      * @return Pointer to string array.
      */
-    const TChar* data() const noexcept
+    NSSO_CONSTEXPR20 const TChar* data() const noexcept
     {
         if (true == mSmallStringOptEnable)
         {
@@ -705,7 +1084,7 @@ public:
      * @param aIndex Index
      * @return Character on the given position.
      */
-    const TChar& operator[](size_type aIndex) const noexcept
+    NSSO_CONSTEXPR20 const TChar& operator[](size_type aIndex) const noexcept
     {
         if (true == mSmallStringOptEnable)
         {
@@ -720,8 +1099,9 @@ public:
      * @param aIndex Index
      * @return Character on the given position.
      */
-    TChar& operator[](size_type aIndex) noexcept
+    TChar& operator[](size_type aIndex) noexcept(!TPolicy::sCopyOnWrite)
     {
+        unshare();
         if (true == mSmallStringOptEnable)
         {
             return mArray[aIndex];
@@ -738,11 +1118,13 @@ public:
     {
         if (aSize > sSmallStringOptLength && aSize > mAllocatedLength)
         {
-            value_type* ptr = mAllocator.allocate(aSize);
-            internalMemcpy(ptr, mDynamicArray, mLength + 1u);
-            mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+            value_type* ptr = allocateBuffer(aSize);
+            internalMemcpy(ptr, beginPtr(), mLength + 1u);
+            deallocateBuffer(mDynamicArray, mAllocatedLength);
             mAllocatedLength = aSize;
             mDynamicArray = ptr;
+            CSsoProfilerHook<TSmallStringOptLength, TChar>::record(ESsoOperation::eReserve,
+                mSmallStringOptEnable ? ESsoPlacement::eSpill : ESsoPlacement::eHeap, mLength);
         }
     }
 
@@ -751,7 +1133,7 @@ public:
      * 
      * @return Size of the buffer dynamic or compilation time array  
      */
-    size_type capacity() const noexcept
+    NSSO_CONSTEXPR20 size_type capacity() const noexcept
     {
         return std::max(sSmallStringOptLength, mAllocatedLength);
     }
@@ -763,13 +1145,26 @@ public:
      * @param aObj Object to assign.
      */
     template<size_type TObjNoChar>
-    void assign(const CSmallStringOpt<TObjNoChar, TChar, TAllocator>& aObj) 
+    void assign(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj) 
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
-		if (this == &aObj)
+		if (reinterpret_cast<const void*>(this) == reinterpret_cast<const void*>(&aObj))
 		{
 			return ;
 		}
+        if (canShare(aObj))
+        {
+            const bool wasInline = mSmallStringOptEnable;
+            if (mDynamicArray != aObj.mDynamicArray)
+            {
+                deallocateBuffer(mDynamicArray, mAllocatedLength);
+                shareBuffer(aObj);
+            }
+            mSmallStringOptEnable = false;
+            mLength = aObj.mLength;
+            profile(ESsoOperation::eAssign, wasInline);
+            return ;
+        }
         assign(aObj.beginPtr(), aObj.mLength);
     }
 	
@@ -782,6 +1177,7 @@ public:
     void assign(const TChar* aTxt, size_type aLength)
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
+        const bool wasInline = mSmallStringOptEnable;
         const size_type lengthToCopy = aLength + 1u;
         TChar* ptr = nullptr;
         if (lengthToCopy < sSmallStringOptLength)
@@ -791,12 +1187,13 @@ public:
         }
         else
         {
-            if (mAllocatedLength < lengthToCopy)
+            if (mAllocatedLength < lengthToCopy || isShared())
             {
-                mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+                deallocateBuffer(mDynamicArray, mAllocatedLength);
                 mAllocatedLength = lengthToCopy;
-                mDynamicArray = mAllocator.allocate(mAllocatedLength);
+                mDynamicArray = allocateBuffer(mAllocatedLength);
             }
+            resetShareable();
             ptr = mDynamicArray;
             mSmallStringOptEnable = false;
         }
@@ -807,6 +1204,7 @@ public:
             aLength);
         ptr[aLength] = '\0';
         mLength = aLength;
+        profile(ESsoOperation::eAssign, wasInline);
     }
 
     /**
@@ -838,7 +1236,7 @@ public:
      * @param aObj String object to append.
      */
     template<size_type TObjNoChar>
-    void append(const CSmallStringOpt<TObjNoChar, TChar, TAllocator>& aObj)
+    NSSO_CONSTEXPR20 void append(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj)
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
         append(aObj.beginPtr(), aObj.mLength);
@@ -850,7 +1248,7 @@ public:
      * 
      * @param aTxt String.
      */
-    void append(const TChar* aTxt)
+    NSSO_CONSTEXPR20 void append(const TChar* aTxt)
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
         const auto len = NSSO::txtLength(aTxt);
@@ -863,28 +1261,38 @@ public:
      * @param aTxt String to append.
      * @param aLen Lenght of string to append. 
      */
-    void append(const TChar* aTxt, size_type aLen)
+    NSSO_CONSTEXPR20 void append(const TChar* aTxt, size_type aLen)
         noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
+        const bool wasInline = mSmallStringOptEnable;
         const auto fullLength = mLength + aLen + 1u;
         TChar* ptr = nullptr;
-        if (fullLength <= sSmallStringOptLength)
+        if (wasInline && fullLength <= sSmallStringOptLength)
         {
             ptr = &mArray[mLength];
         }
         else
         {
-            if (mAllocatedLength < fullLength)
+            if (mAllocatedLength < fullLength || isShared())
             {
-                auto buf = mAllocator.allocate(fullLength);
+                auto buf = allocateBuffer(fullLength);
                 internalMemcpy(
                     buf,
                     beginPtr(),
                     mLength);
-                mAllocator.deallocate(mDynamicArray, mAllocatedLength);
+                deallocateBuffer(mDynamicArray, mAllocatedLength);
                 mAllocatedLength = fullLength;
                 mDynamicArray = buf;
             }
+            else if (wasInline)
+            {
+                // memory was reserved before, but characters are still in the array
+                internalMemcpy(
+                    mDynamicArray,
+                    mArray.data(),
+                    mLength);
+            }
+            resetShareable();
             ptr = mDynamicArray + mLength;
             mSmallStringOptEnable = false;
         }
@@ -895,6 +1303,7 @@ public:
             aTxt,
             aLen);
         ptr[aLen] = '\0';
+        profile(ESsoOperation::eAppend, wasInline);
     }
     
     /**
@@ -907,272 +1316,1311 @@ public:
     {
         append(aTxt.data(), aTxt.size());
     }
-    
+
     /**
-     * @brief Append the given string to this object.
+     * @brief Make room for the given number of characters after the current ones and return pointer to it, so the
+     * caller can write characters directly (e.g. by read(2), recv or a decoder) instead of using a side buffer. Size
+     * doesn't change until commit is called. Characters stay in the small string optimization array if they fit,
+     * otherwise dynamic memory grows at least twice, so repeated calls are amortized O(1) per character.
+     * Shared dynamic memory (copy on write) is cloned.
      * 
-     * @tparam TObjNoChar 
-     * @param aObj Stirng to append.
-     * @return This object with a concatenated string.
+     * @param aCount Number of characters the caller can write.
+     * @return Pointer to the character after the last one. [ptr, ptr + aCount] is writable.
      */
-    template<size_type TObjNoChar>
-    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& operator+=(const CSmallStringOpt<TObjNoChar, TChar, TAllocator>& aObj)
+    TChar* grow_uninitialized(size_type aCount)
+        noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
-        append(aObj);
-        return *this;
+        const bool wasInline = mSmallStringOptEnable;
+        const size_type allocatedLength = mAllocatedLength;
+        TChar* const ptr = growUninitialized(aCount);
+        if (wasInline != mSmallStringOptEnable || allocatedLength != mAllocatedLength)
+        {
+            profile(ESsoOperation::eReserve, wasInline);
+        }
+        return ptr;
     }
-    
+
     /**
-     * @brief Append the given string to this object.
+     * @brief Set length of string after characters were written to memory returned by grow_uninitialized.
      * 
-     * @param aTxt String to append.
-     * @return This object with a concatenated string.
+     * @param aLength New length, not bigger than size() + the number of characters given to grow_uninitialized.
      */
-    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& operator+=(const TChar* aTxt)
+    void commit(size_type aLength) noexcept
     {
-        append(aTxt);
-        return *this;
+        assert(aLength < (mSmallStringOptEnable ? sSmallStringOptLength : mAllocatedLength));
+        beginPtr()[aLength] = '\0';
+        mLength = aLength;
     }
 
     /**
-     * @brief Append the given string to this object.
+     * @brief Resize string to the given length and let the given operation overwrite characters, like
+     * std::basic_string::resize_and_overwrite. The first min(size(), aCount) characters are kept, the others are
+     * uninitialized.
      * 
-     * @param aTxt String to append.
-     * @return This object with a concatenated string.
+     * @tparam TOperation Type of callable: size_type(TChar* aBuffer, size_type aCount).
+     * @param aCount Number of characters the operation can write.
+     * @param aOperation Operation that writes characters and returns the final length (not bigger than aCount).
      */
-    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& operator+=(const std::basic_string<TChar>& aTxt)
+    template<typename TOperation>
+    void resize_and_overwrite(size_type aCount, TOperation aOperation)
     {
-        append(aTxt);
-        return *this;
+        const bool wasInline = mSmallStringOptEnable;
+        growUninitialized(aCount > mLength ? aCount - mLength : 0u);
+        TChar* ptr = beginPtr();
+        commit(static_cast<size_type>(aOperation(ptr, aCount)));
+        profile(ESsoOperation::eAssign, wasInline);
     }
-    
-    
+
     /**
-     * @brief Add the given string.
+     * @brief Append the given integer formatted by std::to_chars directly into spare memory of string (the small
+     * string optimization array if the number fits), without a temporary string.
      * 
-     * @tparam TObjNoChar 
-     * @param aObj String to add.
-     * @return This object with a concatenated string.
+     * @tparam TNumber Type of integer.
+     * @param aValue Number.
+     * @param aBase Base from 2 to 36.
      */
-    template<size_type TObjNoChar>
-    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator> operator+(const CSmallStringOpt<TObjNoChar, TChar, TAllocator>& aObj)
+    template<typename TNumber, TEnableIfInteger<TNumber> = 0>
+    void append_number(TNumber aValue, int aBase = 10)
     {
-        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator> output;
-        output.resever(mLength + aObj.mLength + 1u);
-        output.append(*this);
-        output.append(aObj);
-        return output;
+        appendFormatted([aValue, aBase](char* aFirst, char* aLast)
+            {
+                return std::to_chars(aFirst, aLast, aValue, aBase);
+            });
     }
-    
+
+#if defined(__cpp_lib_to_chars)
     /**
-     * @brief Add the given string.
+     * @brief Append the given floating point number in the shortest representation that reads back the same value.
+     * 
+     * @tparam TNumber Type of floating point number.
+     * @param aValue Number.
+     */
+    template<typename TNumber, TEnableIfFloatingPoint<TNumber> = 0>
+    void append_number(TNumber aValue)
+    {
+        appendFormatted([aValue](char* aFirst, char* aLast)
+            {
+                return std::to_chars(aFirst, aLast, aValue);
+            });
+    }
+
+    /**
+     * @brief Append the given floating point number in the given format, shortest representation.
+     * 
+     * @tparam TNumber Type of floating point number.
+     * @param aValue Number.
+     * @param aFormat Format: scientific, fixed, hex or general.
+     */
+    template<typename TNumber, TEnableIfFloatingPoint<TNumber> = 0>
+    void append_number(TNumber aValue, std::chars_format aFormat)
+    {
+        appendFormatted([aValue, aFormat](char* aFirst, char* aLast)
+            {
+                return std::to_chars(aFirst, aLast, aValue, aFormat);
+            });
+    }
+
+    /**
+     * @brief Append the given floating point number in the given format and precision.
+     * 
+     * @tparam TNumber Type of floating point number.
+     * @param aValue Number.
+     * @param aFormat Format: scientific, fixed, hex or general.
+     * @param aPrecision Precision like in printf.
+     */
+    template<typename TNumber, TEnableIfFloatingPoint<TNumber> = 0>
+    void append_number(TNumber aValue, std::chars_format aFormat, int aPrecision)
+    {
+        appendFormatted([aValue, aFormat, aPrecision](char* aFirst, char* aLast)
+            {
+                return std::to_chars(aFirst, aLast, aValue, aFormat, aPrecision);
+            });
+    }
+#endif // __cpp_lib_to_chars
+
+    /**
+     * @brief Insert the given characters before the given position. The tail is shifted by one move.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aTxt Characters, can be a part of this string.
+     * @param aLength Number of characters.
+     */
+    void insert(size_type aPos, const TChar* aTxt, size_type aLength)
+    {
+        replace(aPos, 0u, aTxt, aLength);
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aTxt Null terminated string.
+     */
+    void insert(size_type aPos, const TChar* aTxt)
+    {
+        insert(aPos, aTxt, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     * 
+     * @tparam TObjNoChar Number of characters used for small string optimization in the given object.
+     * @param aPos Position, size() if bigger.
+     * @param aObj String, can be this string.
+     */
+    template<size_type TObjNoChar>
+    void insert(size_type aPos, const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj)
+    {
+        insert(aPos, aObj.beginPtr(), aObj.mLength);
+    }
+
+    /**
+     * @brief Insert the given string before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aTxt String.
+     */
+    void insert(size_type aPos, const std::basic_string<TChar>& aTxt)
+    {
+        insert(aPos, aTxt.data(), aTxt.size());
+    }
+
+    /**
+     * @brief Insert the given number of copies of the given character before the given position.
+     * 
+     * @param aPos Position, size() if bigger.
+     * @param aCount Number of characters.
+     * @param aChar Character.
+     */
+    void insert(size_type aPos, size_type aCount, TChar aChar)
+    {
+        replace(aPos, 0u, aCount, aChar);
+    }
+
+    /**
+     * @brief Remove characters. The tail is shifted by one move.
+     * 
+     * @param aPos Position of the first removed character.
+     * @param aCount Number of removed characters, up to the end of string if too big.
+     */
+    void erase(size_type aPos = 0u, size_type aCount = npos)
+    {
+        makeRoom(aPos, aCount, 0u);
+    }
+
+    /**
+     * @brief Replace characters by the given characters. The tail is shifted by one move.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aTxt Characters, can be a part of this string.
+     * @param aLength Number of characters.
+     */
+    void replace(size_type aPos, size_type aCount, const TChar* aTxt, size_type aLength)
+    {
+        if (overlaps(aTxt, aLength))
+        {
+            const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> copy{aTxt, aLength};
+            replace(aPos, aCount, copy.data(), aLength);
+            return ;
+        }
+        TChar* ptr = makeRoom(aPos, aCount, aLength);
+        std::char_traits<TChar>::copy(ptr, aTxt, aLength);
+    }
+
+    /**
+     * @brief Replace characters by the given string.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aTxt Null terminated string.
+     */
+    void replace(size_type aPos, size_type aCount, const TChar* aTxt)
+    {
+        replace(aPos, aCount, aTxt, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Replace characters by the given string.
+     * 
+     * @tparam TObjNoChar Number of characters used for small string optimization in the given object.
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aObj String, can be this string.
+     */
+    template<size_type TObjNoChar>
+    void replace(size_type aPos, size_type aCount, const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj)
+    {
+        replace(aPos, aCount, aObj.beginPtr(), aObj.mLength);
+    }
+
+    /**
+     * @brief Replace characters by the given string.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aTxt String.
+     */
+    void replace(size_type aPos, size_type aCount, const std::basic_string<TChar>& aTxt)
+    {
+        replace(aPos, aCount, aTxt.data(), aTxt.size());
+    }
+
+    /**
+     * @brief Replace characters by the given number of copies of the given character.
+     * 
+     * @param aPos Position of the first replaced character, size() if bigger.
+     * @param aCount Number of replaced characters, up to the end of string if too big.
+     * @param aLength Number of characters.
+     * @param aChar Character.
+     */
+    void replace(size_type aPos, size_type aCount, size_type aLength, TChar aChar)
+    {
+        TChar* ptr = makeRoom(aPos, aCount, aLength);
+        std::fill_n(ptr, aLength, aChar);
+    }
+
+    /**
+     * @brief Append the given character.
+     * 
+     * @param aChar Character.
+     */
+    NSSO_CONSTEXPR20 void push_back(TChar aChar)
+    {
+        if (mSmallStringOptEnable && mLength + 2u <= sSmallStringOptLength)
+        {
+            mArray[mLength] = aChar;
+            mArray[++mLength] = '\0';
+            return ;
+        }
+        *grow_uninitialized(1u) = aChar;
+        commit(mLength + 1u);
+    }
+
+    /**
+     * @brief Append the given character.
+     * 
+     * @param aChar Character.
+     * @return This object.
+     */
+    NSSO_CONSTEXPR20 CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& operator+=(TChar aChar)
+    {
+        push_back(aChar);
+        return *this;
+    }
+
+    /**
+     * @brief Remove the last character. Does nothing if string is empty.
+     */
+    void pop_back()
+    {
+        if (mLength != 0u)
+        {
+            truncate(mLength - 1u);
+        }
+    }
+
+    /**
+     * @brief Change length of string. New characters are set to the given character.
+     * 
+     * @param aLength New length.
+     * @param aChar Character of new characters.
+     */
+    void resize(size_type aLength, TChar aChar = TChar())
+    {
+        if (aLength > mLength)
+        {
+            replace(mLength, 0u, aLength - mLength, aChar);
+        }
+        else
+        {
+            truncate(aLength);
+        }
+    }
+
+    /**
+     * @brief Remove all characters. Dynamic memory is kept or released according to TPolicy::sKeepHeapOnShrink.
+     */
+    void clear()
+    {
+        truncate(0u);
+    }
+
+    /**
+     * @brief Replace every occurrence of the given character by the other one, in place (SIMD for 1 byte characters).
+     * 
+     * @param aFrom Replaced character.
+     * @param aTo New character.
+     */
+    void replace_all(TChar aFrom, TChar aTo)
+    {
+        const size_type pos = CStringSearch<TChar>::find(beginPtr(), mLength, aFrom, 0u);
+        if (pos == gNpos)
+        {
+            return ;
+        }
+        TChar* const ptr = grow_uninitialized(0u) - mLength;
+        CSimdSearch<TChar>::replaceChar(ptr + pos, ptr + mLength, aFrom, aTo);
+    }
+
+    /**
+     * @brief Replace every occurrence of the given characters by the other ones, found by the SIMD search. If the text
+     * doesn't grow it is replaced in place in one pass. Otherwise occurrences are counted first (positions of the first
+     * ones are remembered) and segments are copied into memory allocated once (or in the small string optimization array if it fits).
+     * 
+     * @param aFrom Replaced characters, nothing is replaced if empty.
+     * @param aFromLength Number of replaced characters.
+     * @param aTo New characters.
+     * @param aToLength Number of new characters.
+     */
+    void replace_all(const TChar* aFrom, size_type aFromLength, const TChar* aTo, size_type aToLength)
+    {
+        if (aFromLength == 0u)
+        {
+            return ;
+        }
+        if (overlaps(aFrom, aFromLength) || overlaps(aTo, aToLength))
+        {
+            const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> from{aFrom, aFromLength};
+            const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> to{aTo, aToLength};
+            replace_all(from.beginPtr(), aFromLength, to.beginPtr(), aToLength);
+            return ;
+        }
+        const TChar* const src = beginPtr();
+        std::array<size_type, sMatchCacheLength> positions;
+        size_type count = 0u;
+        for (size_type pos = CStringSearch<TChar>::find(src, mLength, aFrom, aFromLength, 0u); pos != gNpos;
+            pos = CStringSearch<TChar>::find(src, mLength, aFrom, aFromLength, pos + aFromLength))
+        {
+            if (count < positions.size())
+            {
+                positions[count] = pos;
+            }
+            ++count;
+            if (aToLength <= aFromLength)
+            {
+                // the result is not longer, the rest is found while characters are moved towards the beginning
+                TChar* const ptr = grow_uninitialized(0u) - mLength;
+                truncate(copyReplaced(ptr, ptr, positions.data(), 1u, aFrom, aFromLength, aTo, aToLength));
+                return ;
+            }
+        }
+        if (count == 0u)
+        {
+            return ;
+        }
+        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> output;
+        const size_type length = mLength + count * (aToLength - aFromLength);
+        copyReplaced(output.grow_uninitialized(length), src, positions.data(), std::min(count, positions.size()),
+            aFrom, aFromLength, aTo, aToLength);
+        output.commit(length);
+        *this = std::move(output);
+    }
+
+    /**
+     * @brief Replace every occurrence of the given string by the other one.
+     * 
+     * @param aFrom Replaced null terminated string.
+     * @param aTo New null terminated string.
+     */
+    void replace_all(const TChar* aFrom, const TChar* aTo)
+    {
+        replace_all(aFrom, txtLength(aFrom), aTo, txtLength(aTo));
+    }
+
+    /**
+     * @brief Replace every occurrence of the given string by the other one.
+     * 
+     * @param aFrom Replaced string.
+     * @param aTo New string.
+     */
+    void replace_all(const std::basic_string<TChar>& aFrom, const std::basic_string<TChar>& aTo)
+    {
+        replace_all(aFrom.data(), aFrom.size(), aTo.data(), aTo.size());
+    }
+    
+    /**
+     * @brief Append the given string to this object.
+     * 
+     * @tparam TObjNoChar 
+     * @param aObj Stirng to append.
+     * @return This object with a concatenated string.
+     */
+    template<size_type TObjNoChar>
+    NSSO_CONSTEXPR20 CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& operator+=(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj)
+    {
+        append(aObj);
+        return *this;
+    }
+    
+    /**
+     * @brief Append the given string to this object.
+     * 
+     * @param aTxt String to append.
+     * @return This object with a concatenated string.
+     */
+    NSSO_CONSTEXPR20 CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& operator+=(const TChar* aTxt)
+    {
+        append(aTxt);
+        return *this;
+    }
+
+    /**
+     * @brief Append the given string to this object.
+     * 
+     * @param aTxt String to append.
+     * @return This object with a concatenated string.
+     */
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& operator+=(const std::basic_string<TChar>& aTxt)
+    {
+        append(aTxt);
+        return *this;
+    }
+
+    /**
+     * @brief Append the given number in decimal (integers) or the shortest (floating point) representation.
+     * Characters are appended by other overloads.
+     * 
+     * @tparam TNumber Type of number.
+     * @param aValue Number.
+     * @return This object with the appended number.
+     */
+    template<typename TNumber, TEnableIfNumber<TNumber> = 0>
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& operator+=(TNumber aValue)
+    {
+        append_number(aValue);
+        return *this;
+    }
+    
+    
+    /**
+     * @brief Add the given string.
+     * 
+     * @tparam TObjNoChar 
+     * @param aObj String to add.
+     * @return This object with a concatenated string.
+     */
+    template<size_type TObjNoChar>
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> operator+(const CSmallStringOpt<TObjNoChar, TChar, TAllocator, TPolicy>& aObj)
+    {
+        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> output;
+        output.resever(mLength + aObj.mLength + 1u);
+        output.append(*this);
+        output.append(aObj);
+        return output;
+    }
+    
+    /**
+     * @brief Add the given string.
+     * 
+     * @param aTxt String to add.
+     * @return This object with a concatenated string.
+     */
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& operator+(const TChar* aTxt)
+    {
+        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> output;
+        const auto len = NSSO::txtLength(aTxt);
+        output.resever(mLength + len + 1u);
+        output.append(*this);
+        output.append(aTxt, len);
+        return output;
+    }
+    
+    /**
+     * @brief Add string.
+     * 
+     * @param aTxt String to add.
+     * @return This object with a concatenated string.
+     */
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> operator+(const std::basic_string<TChar>& aTxt)
+    {
+        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy> output;
+        output.resever(mLength + aTxt.size() + 1u);
+        output.append(*this);
+        output.append(aTxt);
+        return output;
+    }
+    
+    /**
+     * @brief Return the first character in string.
+     * 
+     * @return The first character in string.
+     */
+    TChar& front() noexcept(!TPolicy::sCopyOnWrite)
+    {
+        unshare();
+        // effective C++
+        return const_cast<TChar&>((static_cast<this_const_pointer>(this))->front());
+    }
+    
+    /**
+     * @brief Return the first character in string.
+     * 
+     * @return The first character in string.
+     */
+    const TChar& front() const noexcept
+    {
+        if (true == mSmallStringOptEnable)
+        {
+            return mArray[0];
+        }
+        return mDynamicArray[0];
+    }
+    
+    /**
+     * @brief Return the last character in string.
+     * 
+     * @return The last character in string.
+     */
+    TChar& back() noexcept(!TPolicy::sCopyOnWrite)
+    {
+        unshare();
+        // effective C++
+        return const_cast<TChar&>((static_cast<this_const_pointer>(this))->back());
+    }
+
+    /**
+     * @brief Return the last character in string.
+     * 
+     * @return The last character in string.
+     */
+    const TChar& back() const noexcept
+    {
+        if (true == mSmallStringOptEnable)
+        {
+            return mArray[mLength - 1];
+        }
+        return mDynamicArray[mLength - 1];
+    }
+    
+    /**
+     * @brief Return an iterator to the beginning of the string.
+     * 
+     * @return Iterator to the beginning of the string.
+     */
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{beginPtr()};
+    }
+
+    /**
+     * @brief Return an iterator to the beginning of the string.
+     * 
+     * @return Iterator to the beginning of the string.
+     */
+    iterator begin() noexcept(!TPolicy::sCopyOnWrite)
+    {
+        unshare();
+        return iterator{beginPtr()};
+    }
+
+    /**
+     * @brief Return an iterator to the beginning of the string.
+     * 
+     * @return Iterator to the beginning of the string.
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    /**
+     * @brief Return an iterator to the beginning of the string.
+     * 
+     * @return Iterator to the beginning of the string.
+     */
+    const_iterator end() const noexcept
+    {
+        return const_iterator{endPtr()};
+    }
+
+    /**
+     * @brief Return an iterator to the character after the last one.
+     * 
+     * @return Iterator to the character after the last one.
+     */
+    iterator end() noexcept(!TPolicy::sCopyOnWrite)
+    {
+        unshare();
+        return iterator{endPtr()};
+    }
+
+    /**
+     * @brief Return an iterator to the character after the last one.
+     * 
+     * @return Iterator to the character after the last one.
+     */
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    /**
+     * @brief Return a reverse iterator to iterate from the last character to the first one.
+     * 
+     * @return Teverse iterator to iterate from the last character to the first one.
+     */
+    const_reverse_iterator rbegin() const noexcept
+    {
+       return const_reverse_iterator{const_iterator{endPtr()}};
+    }
+
+    /**
+     * @brief Return a reverse iterator to iterate from the last character to the first one.
+     * 
+     * @return Teverse iterator to iterate from the last character to the first one.
+     */
+    reverse_iterator rbegin() noexcept(!TPolicy::sCopyOnWrite)
+    {
+       unshare();
+       return reverse_iterator{iterator{endPtr()}};
+    }
+
+    /**
+     * @brief Return a reverse iterator to iterate from the last character to the first one.
+     * 
+     * @return Teverse iterator to iterate from the last character to the first one.
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return rbegin();
+    }
+
+    /**
+     * @brief Ruturn a reverse iterator that points before the first character.
+     * 
+     * @return Iterator that points before the first character. 
+     */
+    const_reverse_iterator rend() const noexcept
+    {
+       return const_reverse_iterator{const_iterator{beginPtr()}};
+    }
+
+    /**
+     * @brief Ruturn a reverse iterator that points before the first character.
+     * 
+     * @return Iterator that points before the first character. 
+     */
+    reverse_iterator rend() noexcept(!TPolicy::sCopyOnWrite)
+    {
+       unshare();
+       return reverse_iterator{iterator{beginPtr()}};
+    }
+
+    /**
+     * @brief Ruturn a reverse iterator that points before the first character.
+     * 
+     * @return Iterator that points before the first character. 
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+        return rend();
+    }
+
+    /**
+     * @brief Find the first occurrence of the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find(TChar aChar, size_type aPos = 0u) const noexcept
+    {
+        return CStringSearch<TChar>::find(beginPtr(), mLength, aChar, aPos);
+    }
+
+    /**
+     * @brief Find the first occurrence of the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::find(beginPtr(), mLength, aTxt, aLength, aPos);
+    }
+
+    /**
+     * @brief Find the first occurrence of the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find(const TChar* aTxt, size_type aPos = 0u) const noexcept
+    {
+        return find(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the first occurrence of the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the first occurrence of needle of the given searcher.
+     * 
+     * @tparam TKernels Search kernels of the searcher.
+     * @param aSearcher Searcher with precomputed tables.
+     * @param aPos Position where search starts.
+     * @return Index of the found needle or npos.
+     */
+    template<typename TKernels>
+    size_type find(const CSearcher<TChar, TKernels>& aSearcher, size_type aPos = 0u) const noexcept
+    {
+        return aSearcher.find(beginPtr(), mLength, aPos);
+    }
+
+    /**
+     * @brief Find the last occurrence of the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type rfind(TChar aChar, size_type aPos = npos) const noexcept
+    {
+        return CStringSearch<TChar>::rfind(beginPtr(), mLength, aChar, aPos);
+    }
+
+    /**
+     * @brief Find the last occurrence of the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where backward search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type rfind(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::rfind(beginPtr(), mLength, aTxt, aLength, aPos);
+    }
+
+    /**
+     * @brief Find the last occurrence of the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type rfind(const TChar* aTxt, size_type aPos = npos) const noexcept
+    {
+        return rfind(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the last occurrence of the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type rfind(const TString& aStr, size_type aPos = npos) const noexcept
+    {
+        return rfind(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the first character equal to the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_of(TChar aChar, size_type aPos = 0u) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, &aChar, 1u, aPos, true);
+    }
+
+    /**
+     * @brief Find the first character equal to one of characters in the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, aTxt, aLength, aPos, true);
+    }
+
+    /**
+     * @brief Find the first character equal to one of characters in the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_of(const TChar* aTxt, size_type aPos = 0u) const noexcept
+    {
+        return find_first_of(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the first character equal to one of characters in the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_first_of(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find_first_of(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the first character not equal to the given character.
+     * 
+     * @param aChar Character.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_not_of(TChar aChar, size_type aPos = 0u) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, &aChar, 1u, aPos, false);
+    }
+
+    /**
+     * @brief Find the first character not equal to any of characters in the given characters.
+     * 
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_not_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
+    {
+        return CStringSearch<TChar>::findFirstOf(beginPtr(), mLength, aTxt, aLength, aPos, false);
+    }
+
+    /**
+     * @brief Find the first character not equal to any of characters in the given string.
+     * 
+     * @param aTxt Null terminated string.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    size_type find_first_not_of(const TChar* aTxt, size_type aPos = 0u) const noexcept
+    {
+        return find_first_not_of(aTxt, aPos, txtLength(aTxt));
+    }
+
+    /**
+     * @brief Find the first character not equal to any of characters in the given string.
+     * 
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where search starts.
+     * @return Index of the found character or npos.
+     */
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_first_not_of(const TString& aStr, size_type aPos = 0u) const noexcept
+    {
+        return find_first_not_of(aStr.data(), aPos, aStr.size());
+    }
+
+    /**
+     * @brief Find the last character equal to the given character.
      * 
-     * @param aTxt String to add.
-     * @return This object with a concatenated string.
+     * @param aChar Character.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
      */
-    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& operator+(const TChar* aTxt)
+    size_type find_last_of(TChar aChar, size_type aPos = npos) const noexcept
     {
-        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator> output;
-        const auto len = NSSO::txtLength(aTxt);
-        output.resever(mLength + len + 1u);
-        output.append(*this);
-        output.append(aTxt, len);
-        return output;
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, &aChar, 1u, aPos, true);
     }
-    
+
     /**
-     * @brief Add string.
+     * @brief Find the last character equal to one of characters in the given characters.
      * 
-     * @param aTxt String to add.
-     * @return This object with a concatenated string.
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where backward search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
      */
-    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator> operator+(const std::basic_string<TChar>& aTxt)
+    size_type find_last_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
     {
-        CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator> output;
-        output.resever(mLength + aTxt.size() + 1u);
-        output.append(*this);
-        output.append(aTxt);
-        return output;
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, aTxt, aLength, aPos, true);
     }
-    
+
     /**
-     * @brief Return the first character in string.
+     * @brief Find the last character equal to one of characters in the given string.
      * 
-     * @return The first character in string.
+     * @param aTxt Null terminated string.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
      */
-    TChar& front() noexcept
+    size_type find_last_of(const TChar* aTxt, size_type aPos = npos) const noexcept
     {
-        // effective C++
-        return const_cast<TChar&>((static_cast<this_const_pointer>(this))->front());
+        return find_last_of(aTxt, aPos, txtLength(aTxt));
     }
-    
+
     /**
-     * @brief Return the first character in string.
+     * @brief Find the last character equal to one of characters in the given string.
      * 
-     * @return The first character in string.
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
      */
-    const TChar& front() const noexcept
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_last_of(const TString& aStr, size_type aPos = npos) const noexcept
     {
-        if (true == mSmallStringOptEnable)
-        {
-            return mArray[0];
-        }
-        return mDynamicArray[0];
+        return find_last_of(aStr.data(), aPos, aStr.size());
     }
-    
+
     /**
-     * @brief Return the last character in string.
+     * @brief Find the last character not equal to the given character.
      * 
-     * @return The last character in string.
+     * @param aChar Character.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
      */
-    TChar& back() noexcept
+    size_type find_last_not_of(TChar aChar, size_type aPos = npos) const noexcept
     {
-        // effective C++
-        return const_cast<TChar&>((static_cast<this_const_pointer>(this))->back());
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, &aChar, 1u, aPos, false);
     }
 
     /**
-     * @brief Return the last character in string.
+     * @brief Find the last character not equal to any of characters in the given characters.
      * 
-     * @return The last character in string.
+     * @param aTxt Characters, don't need to be null terminated.
+     * @param aPos Position where backward search starts.
+     * @param aLength Number of characters.
+     * @return Index of the found character or npos.
      */
-    const TChar& back() const noexcept
+    size_type find_last_not_of(const TChar* aTxt, size_type aPos, size_type aLength) const noexcept
     {
-        if (true == mSmallStringOptEnable)
-        {
-            return mArray[mLength - 1];
-        }
-        return mDynamicArray[mLength - 1];
+        return CStringSearch<TChar>::findLastOf(beginPtr(), mLength, aTxt, aLength, aPos, false);
     }
-    
+
     /**
-     * @brief Return an iterator to the beginning of the string.
+     * @brief Find the last character not equal to any of characters in the given string.
      * 
-     * @return Iterator to the beginning of the string.
+     * @param aTxt Null terminated string.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
      */
-    const_iterator begin() const noexcept
+    size_type find_last_not_of(const TChar* aTxt, size_type aPos = npos) const noexcept
     {
-        return const_iterator{beginPtr()};
+        return find_last_not_of(aTxt, aPos, txtLength(aTxt));
     }
 
     /**
-     * @brief Return an iterator to the beginning of the string.
+     * @brief Find the last character not equal to any of characters in the given string.
      * 
-     * @return Iterator to the beginning of the string.
+     * @tparam TString Type of string, e.g. CSmallStringOpt, CSimpleString or std::basic_string.
+     * @param aStr String.
+     * @param aPos Position where backward search starts.
+     * @return Index of the found character or npos.
      */
-    iterator begin() noexcept
+    template<typename TString, TEnableIfStringObject<TString, TChar> = 0>
+    size_type find_last_not_of(const TString& aStr, size_type aPos = npos) const noexcept
     {
-        return iterator{beginPtr()};
+        return find_last_not_of(aStr.data(), aPos, aStr.size());
     }
 
     /**
-     * @brief Return an iterator to the beginning of the string.
+     * @brief Check if characters are valid UTF-8: no overlong encodings, surrogates, code points above U+10FFFF,
+     * unexpected continuation bytes or truncated code points. Only for 1 byte characters (char, char8_t).
      * 
-     * @return Iterator to the beginning of the string.
+     * @return true if valid.
      */
-    const_iterator cbegin() const noexcept
+    bool is_valid_utf8() const noexcept
     {
-        return begin();
+        return CUtf8<TChar>::isValid(beginPtr(), mLength);
     }
 
     /**
-     * @brief Return an iterator to the beginning of the string.
+     * @brief Return number of UTF-8 code points. Characters are expected to be valid UTF-8 (see is_valid_utf8),
+     * otherwise bytes that aren't continuation bytes are counted.
      * 
-     * @return Iterator to the beginning of the string.
+     * @return Number of code points.
      */
-    const_iterator end() const noexcept
+    size_type count_code_points() const noexcept
     {
-        return const_iterator{endPtr()};
+        return CUtf8<TChar>::countCodePoints(beginPtr(), mLength);
     }
 
     /**
-     * @brief Return an iterator to the character after the last one.
+     * @brief Return number of characters of the longest prefix of at most the given number of UTF-8 code points, so
+     * truncating the string to it never splits a code point: str.resize(str.utf8_prefix_of_width(20u)).
      * 
-     * @return Iterator to the character after the last one.
+     * @param aWidth Maximal number of code points.
+     * @return Number of characters (bytes) of the prefix.
      */
-    iterator end() noexcept
+    size_type utf8_prefix_of_width(size_type aWidth) const noexcept
     {
-        return iterator{endPtr()};
+        return CUtf8<TChar>::prefixOfWidth(beginPtr(), mLength, aWidth);
     }
+   
+private:
 
     /**
-     * @brief Return an iterator to the character after the last one.
+     * @brief Check if the given characters are a part of this string.
      * 
-     * @return Iterator to the character after the last one.
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @return true if characters overlap characters of this string.
      */
-    const_iterator cend() const noexcept
+    bool overlaps(const TChar* aTxt, size_type aLength) const noexcept
     {
-        return end();
+        const std::less<const TChar*> less;
+        const TChar* const begin = beginPtr();
+        return aLength != 0u && less(aTxt, begin + mLength) && less(begin, aTxt + aLength);
     }
 
     /**
-     * @brief Return a reverse iterator to iterate from the last character to the first one.
+     * @brief Number of positions of matches remembered by replace_all, so they are not searched again.
+     */
+    static constexpr size_type sMatchCacheLength = 32u;
+
+    /**
+     * @brief Copy characters of this string to aDest replacing every occurrence of aFrom by aTo. aDest can be the
+     * memory of this string if the result is not longer.
      * 
-     * @return Teverse iterator to iterate from the last character to the first one.
+     * @param aDest Destination.
+     * @param aSrc Characters of this string.
+     * @param aPositions Positions of the first matches, the next ones are searched.
+     * @param aPositionCount Number of positions, at least 1.
+     * @param aFrom Replaced characters.
+     * @param aFromLength Number of replaced characters, not 0.
+     * @param aTo New characters.
+     * @param aToLength Number of new characters.
+     * @return Number of characters of the result.
      */
-    const_reverse_iterator rbegin() const noexcept
+    size_type copyReplaced(TChar* aDest, const TChar* aSrc, const size_type* aPositions, size_type aPositionCount,
+        const TChar* aFrom, size_type aFromLength, const TChar* aTo, size_type aToLength) noexcept
     {
-       return std::make_reverse_iterator(endPtr());
+        TChar* dest = aDest;
+        size_type begin = 0u;
+        for (size_type i = 0u, pos = aPositions[0]; pos != gNpos; ++i)
+        {
+            std::char_traits<TChar>::move(dest, aSrc + begin, pos - begin);
+            dest += pos - begin;
+            std::char_traits<TChar>::copy(dest, aTo, aToLength);
+            dest += aToLength;
+            begin = pos + aFromLength;
+            pos = i + 1u < aPositionCount
+                ? aPositions[i + 1u]
+                : CStringSearch<TChar>::find(aSrc, mLength, aFrom, aFromLength, begin);
+        }
+        std::char_traits<TChar>::move(dest, aSrc + begin, mLength - begin);
+        return static_cast<size_type>(dest - aDest) + mLength - begin;
     }
 
     /**
-     * @brief Return a reverse iterator to iterate from the last character to the first one.
+     * @brief Remove characters after the given length. Characters stay where they are unless dynamic memory
+     * is shared or should be released.
      * 
-     * @return Teverse iterator to iterate from the last character to the first one.
+     * @param aLength New length, not bigger than size().
      */
-    reverse_iterator rbegin() noexcept
+    void truncate(size_type aLength)
     {
-       return std::make_reverse_iterator(endPtr());
+        if (mSmallStringOptEnable
+            || (false == isShared() && (TPolicy::sKeepHeapOnShrink || aLength + 1u > sSmallStringOptLength)))
+        {
+            if (false == mSmallStringOptEnable)
+            {
+                resetShareable();
+            }
+            mLength = aLength;
+            beginPtr()[aLength] = '\0';
+        }
+        else
+        {
+            makeRoom(aLength, mLength - aLength, 0u);
+        }
     }
 
     /**
-     * @brief Return a reverse iterator to iterate from the last character to the first one.
+     * @brief Replace aRemoved characters at aPos by aInserted uninitialized characters. Characters after the replaced
+     * ones are moved once: within the current memory, or to the array/new dynamic memory if string crosses
+     * the small string optimization length. Dynamic memory grows at least twice.
      * 
-     * @return Teverse iterator to iterate from the last character to the first one.
+     * @param aPos Position, size() if bigger.
+     * @param aRemoved Number of removed characters, up to the end of string if too big.
+     * @param aInserted Number of inserted characters.
+     * @return Pointer to the first inserted character.
      */
-    const_reverse_iterator crbegin() const noexcept
+    TChar* makeRoom(size_type aPos, size_type aRemoved, size_type aInserted)
     {
-        return rbegin();
+        const bool wasInline = mSmallStringOptEnable;
+        aPos = std::min(aPos, mLength);
+        aRemoved = std::min(aRemoved, mLength - aPos);
+        const size_type tailPos = aPos + aRemoved;
+        const size_type tailLength = mLength - tailPos;
+        const size_type newLength = mLength - aRemoved + aInserted;
+        const size_type fullLength = newLength + 1u;
+        const bool fitsInline = fullLength <= sSmallStringOptLength;
+        TChar* const src = beginPtr();
+        TChar* dest = nullptr;
+        if (wasInline && fitsInline)
+        {
+            dest = src;
+            std::char_traits<TChar>::move(dest + aPos + aInserted, src + tailPos, tailLength);
+        }
+        else if (false == wasInline && fitsInline
+            && (false == TPolicy::sKeepHeapOnShrink || isShared() || mAllocatedLength < fullLength))
+        {
+            // back to the array
+            dest = mArray.data();
+            internalMemcpy(dest, src, aPos);
+            internalMemcpy(dest + aPos + aInserted, src + tailPos, tailLength);
+            deallocateBuffer(mDynamicArray, mAllocatedLength);
+            mDynamicArray = nullptr;
+            mAllocatedLength = 0u;
+            mSmallStringOptEnable = true;
+        }
+        else if (mAllocatedLength >= fullLength && false == isShared())
+        {
+            dest = mDynamicArray;
+            if (wasInline)
+            {
+                // memory was reserved before, but characters are still in the array
+                internalMemcpy(dest, src, aPos);
+                internalMemcpy(dest + aPos + aInserted, src + tailPos, tailLength);
+            }
+            else
+            {
+                std::char_traits<TChar>::move(dest + aPos + aInserted, src + tailPos, tailLength);
+            }
+            resetShareable();
+            mSmallStringOptEnable = false;
+        }
+        else
+        {
+            // too small or shared dynamic memory
+            const size_type newAllocatedLength = std::max(fullLength, 2u * mAllocatedLength);
+            dest = allocateBuffer(newAllocatedLength);
+            internalMemcpy(dest, src, aPos);
+            internalMemcpy(dest + aPos + aInserted, src + tailPos, tailLength);
+            deallocateBuffer(mDynamicArray, mAllocatedLength);
+            mDynamicArray = dest;
+            mAllocatedLength = newAllocatedLength;
+            mSmallStringOptEnable = false;
+        }
+        mLength = newLength;
+        dest[newLength] = '\0';
+        return dest + aPos;
     }
 
     /**
-     * @brief Ruturn a reverse iterator that points before the first character.
+     * @brief grow_uninitialized without recording in the profiler, for operations that record themselves.
      * 
-     * @return Iterator that points before the first character. 
+     * @param aCount Number of characters the caller can write.
+     * @return Pointer to the character after the last one.
      */
-    const_reverse_iterator rend() const noexcept
+    TChar* growUninitialized(size_type aCount)
+        noexcept(noexcept(mAllocator.allocate(0u)) && noexcept(mAllocator.deallocate(nullptr, 0u)))
     {
-       return std::make_reverse_iterator(beginPtr());
+        const bool wasInline = mSmallStringOptEnable;
+        const size_type fullLength = mLength + aCount + 1u;
+        if (wasInline && fullLength <= sSmallStringOptLength)
+        {
+            return &mArray[mLength];
+        }
+        if (mAllocatedLength < fullLength || isShared())
+        {
+            const size_type newLength = std::max(fullLength, 2u * mAllocatedLength);
+            TChar* buf = allocateBuffer(newLength);
+            internalMemcpy(buf, beginPtr(), mLength);
+            deallocateBuffer(mDynamicArray, mAllocatedLength);
+            mAllocatedLength = newLength;
+            mDynamicArray = buf;
+        }
+        else if (wasInline)
+        {
+            // memory was reserved before, but characters are still in the array
+            internalMemcpy(mDynamicArray, mArray.data(), mLength);
+        }
+        resetShareable();
+        mSmallStringOptEnable = false;
+        return mDynamicArray + mLength;
     }
 
     /**
-     * @brief Ruturn a reverse iterator that points before the first character.
+     * @brief Size of local buffer for numbers that don't fit into spare memory of string.
+     */
+    static constexpr size_type sNumberLength = 128u;
+
+    /**
+     * @brief Return number of characters that can be written after the last one without reallocation.
      * 
-     * @return Iterator that points before the first character. 
+     * @return Number of characters.
      */
-    reverse_iterator rend() noexcept
+    size_type spareLength() const noexcept
     {
-       return std::make_reverse_iterator(beginPtr());
+        const size_type length = mSmallStringOptEnable ? sSmallStringOptLength : mAllocatedLength;
+        return length > mLength ? length - mLength - 1u : 0u;
     }
 
     /**
-     * @brief Ruturn a reverse iterator that points before the first character.
+     * @brief Append characters written by the given std::to_chars call. For 1 byte characters the number is written
+     * directly into spare memory of string. If it doesn't fit (or characters are wider), it is written into a local
+     * buffer and appended.
      * 
-     * @return Iterator that points before the first character. 
+     * @tparam TFormat Type of callable: std::to_chars_result(char* aFirst, char* aLast).
+     * @param aFormat Formatting function.
      */
-    const_reverse_iterator crend() const noexcept
+    template<typename TFormat>
+    void appendFormatted(TFormat aFormat)
     {
-        return rend();
+        const bool wasInline = mSmallStringOptEnable;
+        if constexpr (std::is_same<TChar, char>::value)
+        {
+            TChar* ptr = growUninitialized(0u);
+            const std::to_chars_result result = aFormat(ptr, ptr + spareLength());
+            if (result.ec == std::errc{})
+            {
+                commit(mLength + static_cast<size_type>(result.ptr - ptr));
+                profile(ESsoOperation::eAppend, wasInline);
+                return ;
+            }
+        }
+        std::array<char, sNumberLength> local;
+        std::vector<char> big; // only for very long fixed format numbers
+        char* first = local.data();
+        std::to_chars_result result = aFormat(first, first + local.size());
+        for (size_type length = 2u * local.size(); result.ec != std::errc{}; length *= 2u)
+        {
+            big.resize(length);
+            first = big.data();
+            result = aFormat(first, first + length);
+        }
+        const size_type count = static_cast<size_type>(result.ptr - first);
+        TChar* ptr = growUninitialized(count);
+        for (size_type i = 0u; i < count; ++i)
+        {
+            ptr[i] = static_cast<TChar>(first[i]);
+        }
+        commit(mLength + count);
+        profile(ESsoOperation::eAppend, wasInline);
     }
-   
-private:
-    
+
     /**
      * @brief Return pointer to the first character in string.
      * 
      * @return Pointer to the first character in string.
      */
-    TChar* beginPtr() noexcept
+    NSSO_CONSTEXPR20 TChar* beginPtr() noexcept
     {
         return const_cast<TChar*>((static_cast<this_const_pointer>(this))->beginPtr());
     }
@@ -1182,7 +2630,7 @@ private:
      * 
      * @return Pointer to the first character in string.
      */
-    const TChar* beginPtr() const noexcept
+    NSSO_CONSTEXPR20 const TChar* beginPtr() const noexcept
     {
         if (true == mSmallStringOptEnable)
         {
@@ -1217,6 +2665,56 @@ private:
 };
 // /////////////////////////////////////////
 
+/**
+ * @brief CSmallStringOpt doesn't point to itself: characters are either in its array or in dynamic memory, so it is
+ * trivially relocatable if its allocator is.
+ *
+ * @tparam sSmallStringOptLength Length of small string optimization array.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ */
+template<std::size_t sSmallStringOptLength, typename TChar, typename TAllocator, typename TPolicy>
+struct CIsTriviallyRelocatable<CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>>
+    : CIsTriviallyRelocatable<TAllocator>
+{
+};
+
+/**
+ * @brief Small string optimization string, whose array of characters is given in bytes instead of characters, so
+ * strings of wide characters take the same memory as strings of char: CSmallStringOptBytes<32u, char16_t> holds
+ * 16 characters (with the null character) inline, the same 32 bytes as CSmallStringOpt<32u>.
+ *
+ * @tparam TBytes Size of the array of characters in bytes, rounded down to a multiple of size of character.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ */
+template<
+    std::size_t TBytes,
+    typename TChar = char,
+    typename TAllocator = std::allocator<TChar>,
+    typename TPolicy = CDefaultStringPolicy>
+using CSmallStringOptBytes = CSmallStringOpt<TBytes / sizeof(TChar), TChar, TAllocator, TPolicy>;
+
+
+/**
+ * @brief Swap characters of strings, see CSmallStringOpt::swap.
+ *
+ * @tparam sSmallStringOptLength Length of small string optimization array.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ * @param aObj1 First string.
+ * @param aObj2 Second string.
+ */
+template<std::size_t sSmallStringOptLength, typename TChar, typename TAllocator, typename TPolicy>
+void swap(
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept(noexcept(aObj1.swap(aObj2)))
+{
+    aObj1.swap(aObj2);
+}
 
 /**
  * @brief Compare strings.
@@ -1226,6 +2724,8 @@ private:
  * @tparam TChar Character type.
  * @tparam TAllocator1 Type of allocator of the first string.
  * @tparam TAllocator2 Type of allocator of the second string.
+ * @tparam TPolicy1 Memory policy of the first string.
+ * @tparam TPolicy2 Memory policy of the second string.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the given strings contain the same characters.
@@ -1235,12 +2735,14 @@ template<
     std::size_t sSmallStringOptLength2,
     typename TChar,
     typename TAllocator1,
-    typename TAllocator2>
-bool operator==(
-    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2>& aObj2) noexcept
+    typename TAllocator2,
+    typename TPolicy1,
+    typename TPolicy2>
+NSSO_CONSTEXPR20 bool operator==(
+    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1, TPolicy1>& aObj1,
+    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2, TPolicy2>& aObj2) noexcept
 {
-    if (reinterpret_cast<const void*>(&aObj1) == reinterpret_cast<const void*>(&aObj2))
+    if (static_cast<const void*>(&aObj1) == static_cast<const void*>(&aObj2))
     {
         return true;
     }
@@ -1248,7 +2750,7 @@ bool operator==(
     {
         return false;
     }
-    return std::equal(&(*aObj1.begin()), &(*aObj1.end()), &(*aObj2.begin()));
+    return std::equal(aObj1.data(), aObj1.data() + aObj1.size(), aObj2.data());
 }
 
 /**
@@ -1257,6 +2759,7 @@ bool operator==(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if there are equal.
@@ -1264,16 +2767,17 @@ bool operator==(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-    bool operator==(
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+    NSSO_CONSTEXPR20 bool operator==(
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
         const std::basic_string<TChar>& aObj2) noexcept
 {
     if (aObj1.size() != aObj2.size())
     {
         return false;
     }
-    return std::equal(aObj1.begin(), aObj1.end(), aObj2.begin());
+    return std::equal(aObj1.data(), aObj1.data() + aObj1.size(), aObj2.data());
 }
 
 /**
@@ -1282,6 +2786,7 @@ template<
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aArray String array to compare.
  * @return true if there are equal.
@@ -1289,9 +2794,10 @@ template<
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-    bool operator==(
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+    NSSO_CONSTEXPR20 bool operator==(
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
         const TChar* aArray) noexcept
 {
     const auto len = txtLength(aArray);
@@ -1299,7 +2805,7 @@ template<
     {
         return false;
     }
-    return std::equal(aObj1.begin(), aObj1.end(), aArray);
+    return std::equal(aObj1.data(), aObj1.data() + aObj1.size(), aArray);
 }
 
 /**
@@ -1308,6 +2814,7 @@ template<
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if there are equal.
@@ -1315,16 +2822,17 @@ template<
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator==(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator==(
     const std::basic_string<TChar>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
     if (aObj1.size() != aObj2.size())
     {
         return false;
     }
-    return std::equal(aObj1.begin(), aObj1.end(), aObj2.begin());
+    return std::equal(aObj1.data(), aObj1.data() + aObj1.size(), aObj2.data());
 }
 
 /**
@@ -1333,6 +2841,7 @@ bool operator==(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aArray First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if there are equal.
@@ -1340,15 +2849,110 @@ bool operator==(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator==(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator==(
     const TChar* aArray,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
 {
     return aObj == aArray;
 }
 
 
+/**
+ * @brief Compare string with a literal of known length: no characters are counted, lengths are compared before
+ * characters.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ * @param aObj String to compare.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @return true if there are equal.
+ */
+template<
+    std::size_t sSmallStringOptLength,
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator==(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj,
+    const CStaticString<TChar>& aLiteral) noexcept
+{
+    return aObj.size() == aLiteral.size() && aLiteral.equals(aObj.data());
+}
+
+/**
+ * @brief Compare string with a literal of known length, see the other operator.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @param aObj String to compare.
+ * @return true if there are equal.
+ */
+template<
+    std::size_t sSmallStringOptLength,
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator==(
+    const CStaticString<TChar>& aLiteral,
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
+{
+    return aObj == aLiteral;
+}
+
+/**
+ * @brief Compare string with a literal of known length.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ * @param aObj String to compare.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @return true if there are not equal.
+ */
+template<
+    std::size_t sSmallStringOptLength,
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator!=(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj,
+    const CStaticString<TChar>& aLiteral) noexcept
+{
+    return !(aObj == aLiteral);
+}
+
+/**
+ * @brief Compare string with a literal of known length.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar Type of characters.
+ * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
+ * @param aLiteral Literal to compare, see CStaticString.
+ * @param aObj String to compare.
+ * @return true if there are not equal.
+ */
+template<
+    std::size_t sSmallStringOptLength,
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator!=(
+    const CStaticString<TChar>& aLiteral,
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
+{
+    return !(aObj == aLiteral);
+}
+
+
 //////////////////////////////////// !=
 
 
@@ -1360,6 +2964,8 @@ bool operator==(
  * @tparam TChar Character type.
  * @tparam TAllocator1 Type of allocator of the first string.
  * @tparam TAllocator2 Type of allocator of the second string.
+ * @tparam TPolicy1 Memory policy of the first string.
+ * @tparam TPolicy2 Memory policy of the second string.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the given strings don't contain the same characters.
@@ -1369,10 +2975,12 @@ template<
     std::size_t sSmallStringOptLength2,
     typename TChar,
     typename TAllocator1,
-    typename TAllocator2>
-bool operator!=(
-    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2>& aObj2) noexcept
+    typename TAllocator2,
+    typename TPolicy1,
+    typename TPolicy2>
+NSSO_CONSTEXPR20 bool operator!=(
+    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1, TPolicy1>& aObj1,
+    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2, TPolicy2>& aObj2) noexcept
 {
     return !(aObj1 == aObj2);
 }
@@ -1383,6 +2991,7 @@ bool operator!=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if there are equal.
@@ -1390,9 +2999,10 @@ bool operator!=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator!=(
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator!=(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
     const std::basic_string<TChar>& aObj2) noexcept
 {
     return !(aObj1 == aObj2);
@@ -1404,6 +3014,7 @@ bool operator!=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aArray String array to compare.
  * @return true if there are equal.
@@ -1411,9 +3022,10 @@ bool operator!=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator!=(
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator!=(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
     const TChar* aArray) noexcept
 {
     return !(aObj1 == aArray);
@@ -1429,6 +3041,7 @@ bool operator!=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if there are not equal.
@@ -1436,10 +3049,11 @@ bool operator!=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator!=(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator!=(
     const std::basic_string<TChar>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
     return !(aObj1 == aObj2);
 }
@@ -1450,6 +3064,7 @@ bool operator!=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aArray First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if there are not equal.
@@ -1457,10 +3072,11 @@ bool operator!=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator!=(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator!=(
     const TChar* aArray,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
 {
     return !(aArray == aObj);
 }
@@ -1478,6 +3094,8 @@ bool operator!=(
  * @tparam TChar Character type.
  * @tparam TAllocator1 Type of allocator of the first string.
  * @tparam TAllocator2 Type of allocator of the second string.
+ * @tparam TPolicy1 Memory policy of the first string.
+ * @tparam TPolicy2 Memory policy of the second string.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before the second string.
@@ -1487,18 +3105,20 @@ template<
     std::size_t sSmallStringOptLength2,
     typename TChar,
     typename TAllocator1,
-    typename TAllocator2>
-bool operator<(
-    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2>& aObj2) noexcept
+    typename TAllocator2,
+    typename TPolicy1,
+    typename TPolicy2>
+NSSO_CONSTEXPR20 bool operator<(
+    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1, TPolicy1>& aObj1,
+    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2, TPolicy2>& aObj2) noexcept
 {
-    if (reinterpret_cast<const void*>(&aObj1) == reinterpret_cast<const void*>(&aObj2))
+    if (static_cast<const void*>(&aObj1) == static_cast<const void*>(&aObj2))
     {
         return false;
     }
 
-    return std::lexicographical_compare(aObj1.begin(), aObj1.end(),
-        aObj2.begin(), aObj2.end());
+    return std::lexicographical_compare(aObj1.data(), aObj1.data() + aObj1.size(),
+        aObj2.data(), aObj2.data() + aObj2.size());
 }
 
 /**
@@ -1507,6 +3127,7 @@ bool operator<(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before the second string.
@@ -1514,13 +3135,14 @@ bool operator<(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator<(
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator<(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
     const std::basic_string<TChar>& aObj2) noexcept
 {
-    return std::lexicographical_compare(aObj1.begin(), aObj1.end(),
-        aObj2.begin(), aObj2.end());
+    return std::lexicographical_compare(aObj1.data(), aObj1.data() + aObj1.size(),
+        aObj2.data(), aObj2.data() + aObj2.size());
 }
 
 /**
@@ -1529,6 +3151,7 @@ bool operator<(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aArray String array to compare.
  * @return true if the first string is a lexicographicaly before the second string.
@@ -1536,13 +3159,14 @@ bool operator<(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-    bool operator<(
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+    NSSO_CONSTEXPR20 bool operator<(
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
         const TChar* aArray) noexcept
 {
     const auto len = txtLength(aArray);
-    return std::lexicographical_compare(aObj1.begin(), aObj1.end(),
+    return std::lexicographical_compare(aObj1.data(), aObj1.data() + aObj1.size(),
         aArray, aArray + len);
 }
 
@@ -1554,6 +3178,7 @@ template<
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before the second string.
@@ -1561,13 +3186,14 @@ template<
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator<(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator<(
     const std::basic_string<TChar>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
-    return std::lexicographical_compare(aObj1.begin(), aObj1.end(),
-        aObj2.begin(), aObj2.end());
+    return std::lexicographical_compare(aObj1.data(), aObj1.data() + aObj1.size(),
+        aObj2.data(), aObj2.data() + aObj2.size());
 }
 
 /**
@@ -1576,6 +3202,7 @@ bool operator<(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aArray First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before the second string.
@@ -1583,15 +3210,16 @@ bool operator<(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator<(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator<(
     const TChar* aArray,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
 {
     const auto len = txtLength(aArray);
 
     return std::lexicographical_compare(aArray, aArray + len,
-        aObj.begin(), aObj.end());
+        aObj.data(), aObj.data() + aObj.size());
 }
 
 
@@ -1607,6 +3235,8 @@ bool operator<(
  * @tparam TChar Character type.
  * @tparam TAllocator1 Type of allocator of the first string.
  * @tparam TAllocator2 Type of allocator of the second string.
+ * @tparam TPolicy1 Memory policy of the first string.
+ * @tparam TPolicy2 Memory policy of the second string.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after the second string.
@@ -1616,10 +3246,12 @@ template<
     std::size_t sSmallStringOptLength2,
     typename TChar,
     typename TAllocator1,
-    typename TAllocator2>
-bool operator>(
-    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2>& aObj2) noexcept
+    typename TAllocator2,
+    typename TPolicy1,
+    typename TPolicy2>
+NSSO_CONSTEXPR20 bool operator>(
+    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1, TPolicy1>& aObj1,
+    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2, TPolicy2>& aObj2) noexcept
 {
     return aObj2 < aObj1;
 }
@@ -1630,6 +3262,7 @@ bool operator>(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after the second string.
@@ -1637,9 +3270,10 @@ bool operator>(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator>(
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator>(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
     const std::basic_string<TChar>& aObj2) noexcept
 {
     return aObj2 < aObj1;
@@ -1651,6 +3285,7 @@ bool operator>(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aArray String array to compare.
  * @return true if the first string is a lexicographicaly after the second string.
@@ -1658,9 +3293,10 @@ bool operator>(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-    bool operator>(
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+    NSSO_CONSTEXPR20 bool operator>(
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
         const TChar* aArray) noexcept
 {
     return aArray < aObj1;
@@ -1676,6 +3312,7 @@ template<
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after the second string.
@@ -1683,10 +3320,11 @@ template<
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator>(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator>(
     const std::basic_string<TChar>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
     return aObj2 < aObj1;
 }
@@ -1697,6 +3335,7 @@ bool operator>(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aArray First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after the second string.
@@ -1704,10 +3343,11 @@ bool operator>(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator>(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator>(
     const TChar* aArray,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
     return aObj2 < aArray;
 }
@@ -1724,6 +3364,8 @@ bool operator>(
  * @tparam TChar Character type.
  * @tparam TAllocator1 Type of allocator of the first string.
  * @tparam TAllocator2 Type of allocator of the second string.
+ * @tparam TPolicy1 Memory policy of the first string.
+ * @tparam TPolicy2 Memory policy of the second string.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after or equal the second string.
@@ -1733,10 +3375,12 @@ template<
     std::size_t sSmallStringOptLength2,
     typename TChar,
     typename TAllocator1,
-    typename TAllocator2>
-bool operator>=(
-    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2>& aObj2) noexcept
+    typename TAllocator2,
+    typename TPolicy1,
+    typename TPolicy2>
+NSSO_CONSTEXPR20 bool operator>=(
+    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1, TPolicy1>& aObj1,
+    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2, TPolicy2>& aObj2) noexcept
 {
     return !(aObj1 < aObj2);
 }
@@ -1747,6 +3391,7 @@ bool operator>=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after or equal the second string.
@@ -1754,9 +3399,10 @@ bool operator>=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator>=(
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator>=(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
     const std::basic_string<TChar>& aObj2) noexcept
 {
     return !(aObj1 < aObj2);
@@ -1768,6 +3414,7 @@ bool operator>=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aArray String array to compare.
  * @return true if the first string is a lexicographicaly after or equal the second string.
@@ -1775,9 +3422,10 @@ bool operator>=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-    bool operator>=(
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+    NSSO_CONSTEXPR20 bool operator>=(
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
         const TChar* aArray) noexcept
 {
     return !(aObj1 < aArray);
@@ -1793,6 +3441,7 @@ template<
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after or equal the second string.
@@ -1800,10 +3449,11 @@ template<
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator>=(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator>=(
     const std::basic_string<TChar>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
     return !(aObj1 < aObj2);
 }
@@ -1814,6 +3464,7 @@ bool operator>=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aArray First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly after or equal the second string.
@@ -1821,10 +3472,11 @@ bool operator>=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator>=(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator>=(
     const TChar* aArray,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
 {
     return !(aArray < aObj);
 }
@@ -1840,6 +3492,8 @@ bool operator>=(
  * @tparam TChar Character type.
  * @tparam TAllocator1 Type of allocator of the first string.
  * @tparam TAllocator2 Type of allocator of the second string.
+ * @tparam TPolicy1 Memory policy of the first string.
+ * @tparam TPolicy2 Memory policy of the second string.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before or equal the second string.
@@ -1849,10 +3503,12 @@ template<
     std::size_t sSmallStringOptLength2,
     typename TChar,
     typename TAllocator1,
-    typename TAllocator2>
-bool operator<=(
-    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2>& aObj2) noexcept
+    typename TAllocator2,
+    typename TPolicy1,
+    typename TPolicy2>
+NSSO_CONSTEXPR20 bool operator<=(
+    const CSmallStringOpt<sSmallStringOptLength1, TChar, TAllocator1, TPolicy1>& aObj1,
+    const CSmallStringOpt<sSmallStringOptLength2, TChar, TAllocator2, TPolicy2>& aObj2) noexcept
 {
     return !(aObj1 > aObj2);
 }
@@ -1863,6 +3519,7 @@ bool operator<=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before or equal the second string.
@@ -1870,9 +3527,10 @@ bool operator<=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator<=(
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator<=(
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
     const std::basic_string<TChar>& aObj2) noexcept
 {
     return !(aObj1 > aObj2);
@@ -1884,6 +3542,7 @@ bool operator<=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aArray String array to compare.
  * @return true if the first string is a lexicographicaly before or equal the second string.
@@ -1891,9 +3550,10 @@ bool operator<=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-    bool operator<=(
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj1,
+    typename TAllocator,
+    typename TPolicy>
+    NSSO_CONSTEXPR20 bool operator<=(
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj1,
         const TChar* aArray) noexcept
 {
     return !(aObj1 > aArray);
@@ -1907,6 +3567,7 @@ template<
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aObj1 First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before or equal the second string.
@@ -1914,10 +3575,11 @@ template<
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator<=(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator<=(
     const std::basic_string<TChar>& aObj1,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj2) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj2) noexcept
 {
     return !(aObj1 > aObj2);
 }
@@ -1928,6 +3590,7 @@ bool operator<=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the 1st string.
  * @tparam TChar  Type of characters
  * @tparam TAllocator Type of allocator.
+ * @tparam TPolicy Memory policy.
  * @param aArray First string to compare.
  * @param aObj2 Second string to compare.
  * @return true if the first string is a lexicographicaly before or equal the second string.
@@ -1935,10 +3598,11 @@ bool operator<=(
 template<
     std::size_t sSmallStringOptLength,
     typename TChar,
-    typename TAllocator>
-bool operator<=(
+    typename TAllocator,
+    typename TPolicy>
+NSSO_CONSTEXPR20 bool operator<=(
     const TChar* aArray,
-    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aObj) noexcept
+    const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aObj) noexcept
 {
     return !(aArray > aObj);
 }
@@ -1951,6 +3615,7 @@ bool operator<=(
  * @tparam sSmallStringOptLength Length of small string optimization array of the string.
  * @tparam TChar type of characters in the string.
  * @tparam TAllocator Allocator type.
+ * @tparam TPolicy Memory policy.
  * @param aStream Stream
  * @param aString String
  * 
@@ -1960,16 +3625,91 @@ template<
     typename TCharStream, 
     std::size_t sSmallStringOptLength, 
     typename TChar,
-    typename TAllocator>
+    typename TAllocator,
+    typename TPolicy>
 std::basic_ostream<TCharStream, std::char_traits<TCharStream>>&
     operator<<(
         std::basic_ostream<TCharStream, std::char_traits<TCharStream>>& aStream, 
-        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator>& aString)
+        const CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aString)
 {
     aStream << aString.data();
     return aStream;
 }
 
+/**
+ * @brief Read characters up to the delimiter into the string (its memory is reused), like std::getline.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar type of characters in the string.
+ * @tparam TAllocator Allocator type.
+ * @tparam TPolicy Memory policy.
+ * @param aStream Stream
+ * @param aString String
+ * @param aDelim Delimiter, extracted but not stored.
+ * 
+ * @return Stream.
+ */
+template<
+    std::size_t sSmallStringOptLength, 
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+std::basic_istream<TChar>& getline(
+    std::basic_istream<TChar>& aStream,
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aString,
+    TChar aDelim)
+{
+    return CStreamRead<TChar>::getline(aStream, aString, aDelim);
+}
+
+/**
+ * @brief Read a line into the string (its memory is reused), like std::getline.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar type of characters in the string.
+ * @tparam TAllocator Allocator type.
+ * @tparam TPolicy Memory policy.
+ * @param aStream Stream
+ * @param aString String
+ * 
+ * @return Stream.
+ */
+template<
+    std::size_t sSmallStringOptLength, 
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+std::basic_istream<TChar>& getline(
+    std::basic_istream<TChar>& aStream,
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aString)
+{
+    return CStreamRead<TChar>::getline(aStream, aString, aStream.widen('\n'));
+}
+
+/**
+ * @brief Read a word (characters up to a whitespace) into the string, like operator>> of std::basic_string.
+ * 
+ * @tparam sSmallStringOptLength Length of small string optimization array of the string.
+ * @tparam TChar type of characters in the string.
+ * @tparam TAllocator Allocator type.
+ * @tparam TPolicy Memory policy.
+ * @param aStream Stream
+ * @param aString String
+ * 
+ * @return Stream.
+ */
+template<
+    std::size_t sSmallStringOptLength, 
+    typename TChar,
+    typename TAllocator,
+    typename TPolicy>
+std::basic_istream<TChar>& operator>>(
+    std::basic_istream<TChar>& aStream,
+    CSmallStringOpt<sSmallStringOptLength, TChar, TAllocator, TPolicy>& aString)
+{
+    return CStreamRead<TChar>::readWord(aStream, aString);
+}
+
 } // namespace NSSO
 
 #endif // SMALL_STRING_OPTIMIZATION_HPP_
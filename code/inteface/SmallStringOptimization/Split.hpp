@@ -0,0 +1,448 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Lazy splitting of strings into non-owning pieces.
+ */
+
+#ifndef SPLIT_HPP_
+#define SPLIT_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include "internal/InternalHelper.hpp"
+#include "internal/Search.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Delimiter that is a single character.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+class CCharDelimiter
+{
+    /**
+     * @brief Delimiter.
+     */
+    TChar mChar;
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param aChar Delimiter.
+     */
+    explicit CCharDelimiter(TChar aChar) noexcept
+        : mChar{aChar}
+    {
+    }
+
+    /**
+     * @brief Find the delimiter (SIMD for 1 byte characters).
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @param aPos Position the search starts at.
+     * @return Position of the delimiter or gNpos.
+     */
+    std::size_t find(const TChar* aTxt, std::size_t aLength, std::size_t aPos) const noexcept
+    {
+        return CStringSearch<TChar>::find(aTxt, aLength, mChar, aPos);
+    }
+
+    /**
+     * @brief Return number of characters of the delimiter.
+     *
+     * @return 1.
+     */
+    std::size_t length() const noexcept
+    {
+        return 1u;
+    }
+};
+
+/**
+ * @brief Delimiter that is a sequence of characters. An empty sequence doesn't split.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+class CStringDelimiter
+{
+    /**
+     * @brief Delimiter, not owned.
+     */
+    std::basic_string_view<TChar> mDelimiter;
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param aDelimiter Delimiter, it must live as long as the split range.
+     */
+    explicit CStringDelimiter(std::basic_string_view<TChar> aDelimiter) noexcept
+        : mDelimiter{aDelimiter}
+    {
+    }
+
+    /**
+     * @brief Find the delimiter (SIMD first/last character filter for 1 byte characters).
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @param aPos Position the search starts at.
+     * @return Position of the delimiter or gNpos.
+     */
+    std::size_t find(const TChar* aTxt, std::size_t aLength, std::size_t aPos) const noexcept
+    {
+        if (mDelimiter.empty())
+        {
+            return gNpos;
+        }
+        return CStringSearch<TChar>::find(aTxt, aLength, mDelimiter.data(), mDelimiter.size(), aPos);
+    }
+
+    /**
+     * @brief Return number of characters of the delimiter.
+     *
+     * @return Number of characters.
+     */
+    std::size_t length() const noexcept
+    {
+        return mDelimiter.size();
+    }
+};
+
+/**
+ * @brief Delimiter that is any character of the given set. An empty set doesn't split.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+class CAnyOfDelimiter
+{
+    /**
+     * @brief Set of characters, not owned.
+     */
+    std::basic_string_view<TChar> mSet;
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param aSet Set of characters, it must live as long as the split range.
+     */
+    explicit CAnyOfDelimiter(std::basic_string_view<TChar> aSet) noexcept
+        : mSet{aSet}
+    {
+    }
+
+    /**
+     * @brief Find any character of the set (SIMD for sets up to 16 characters of 1 byte).
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @param aPos Position the search starts at.
+     * @return Position of the delimiter or gNpos.
+     */
+    std::size_t find(const TChar* aTxt, std::size_t aLength, std::size_t aPos) const noexcept
+    {
+        if (mSet.empty())
+        {
+            return gNpos;
+        }
+        return CStringSearch<TChar>::findFirstOf(aTxt, aLength, mSet.data(), mSet.size(), aPos, true);
+    }
+
+    /**
+     * @brief Return number of characters of the delimiter.
+     *
+     * @return 1.
+     */
+    std::size_t length() const noexcept
+    {
+        return 1u;
+    }
+};
+
+/**
+ * @brief Return delimiter that is any of the given characters.
+ *
+ * @tparam TChar Type of character.
+ * @param aSet Null terminated set of characters, it must live as long as the split range.
+ * @return Delimiter.
+ */
+template<typename TChar>
+CAnyOfDelimiter<TChar> anyOf(const TChar* aSet) noexcept
+{
+    return CAnyOfDelimiter<TChar>{std::basic_string_view<TChar>{aSet}};
+}
+
+/**
+ * @brief Return delimiter that is any of the given characters.
+ *
+ * @tparam TChar Type of character.
+ * @param aSet Set of characters, it must live as long as the split range.
+ * @return Delimiter.
+ */
+template<typename TChar>
+CAnyOfDelimiter<TChar> anyOf(std::basic_string_view<TChar> aSet) noexcept
+{
+    return CAnyOfDelimiter<TChar>{aSet};
+}
+
+/**
+ * @brief Lazy range of pieces of a text between delimiters (a forward range for C++20 ranges). Pieces are std::basic_string_view of the text,
+ * the next delimiter is found only when the iterator is incremented, nothing is allocated. N delimiters give N + 1
+ * pieces, so empty pieces are kept (also before a leading and after a trailing delimiter) and an empty text gives
+ * one empty piece.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TDelimiter Type of delimiter: CCharDelimiter, CStringDelimiter, CAnyOfDelimiter or any class with the
+ * same find and length functions.
+ */
+template<typename TChar, typename TDelimiter>
+class CSplitRange
+{
+public:
+    /**
+     * @brief Type of piece.
+     */
+    using value_type = std::basic_string_view<TChar>;
+
+    /**
+     * @brief Iterator over pieces. Dereferencing returns the piece by value (a prvalue std::basic_string_view), so it
+     * is an input iterator for C++17 iterator traits and a forward iterator for C++20 ranges (iterator_concept).
+     */
+    class CIterator
+    {
+        /**
+         * @brief Range, nullptr for end iterator.
+         */
+        const CSplitRange* mRange = nullptr;
+
+        /**
+         * @brief Position of the first character of the current piece, gNpos for end iterator.
+         */
+        std::size_t mBegin = gNpos;
+
+        /**
+         * @brief Position after the last character of the current piece.
+         */
+        std::size_t mEnd = gNpos;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+#if defined(__cpp_lib_ranges)
+        using iterator_concept = std::forward_iterator_tag;
+#endif
+        using value_type = std::basic_string_view<TChar>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        /**
+         * @brief Construct end iterator.
+         */
+        CIterator() noexcept = default;
+
+        /**
+         * @brief Construct iterator pointing to the first piece of the given range.
+         *
+         * @param aRange Range.
+         */
+        explicit CIterator(const CSplitRange& aRange) noexcept
+            : mRange{&aRange}
+            , mBegin{0u}
+        {
+            findEnd();
+        }
+
+        /**
+         * @brief Return the current piece.
+         *
+         * @return Piece.
+         */
+        value_type operator*() const noexcept
+        {
+            return value_type{mRange->mTxt.data() + mBegin, mEnd - mBegin};
+        }
+
+        /**
+         * @brief Move to the next piece.
+         *
+         * @return This iterator.
+         */
+        CIterator& operator++() noexcept
+        {
+            if (mEnd == mRange->mTxt.size())
+            {
+                mBegin = gNpos;
+                mEnd = gNpos;
+            }
+            else
+            {
+                mBegin = mEnd + mRange->mDelimiter.length();
+                findEnd();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move to the next piece.
+         *
+         * @return Copy of iterator before moving.
+         */
+        CIterator operator++(int) noexcept
+        {
+            CIterator output{*this};
+            ++(*this);
+            return output;
+        }
+
+        bool operator==(const CIterator& aIter) const noexcept
+        {
+            return mBegin == aIter.mBegin;
+        }
+
+        bool operator!=(const CIterator& aIter) const noexcept
+        {
+            return mBegin != aIter.mBegin;
+        }
+
+    private:
+        /**
+         * @brief Find the end of piece starting at mBegin.
+         */
+        void findEnd() noexcept
+        {
+            const std::size_t pos = mRange->mDelimiter.find(mRange->mTxt.data(), mRange->mTxt.size(), mBegin);
+            mEnd = pos == gNpos ? mRange->mTxt.size() : pos;
+        }
+    };
+
+    using iterator = CIterator;
+    using const_iterator = CIterator;
+
+private:
+    /**
+     * @brief Text, not owned.
+     */
+    std::basic_string_view<TChar> mTxt;
+
+    /**
+     * @brief Delimiter.
+     */
+    TDelimiter mDelimiter;
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param aTxt Text, it must live as long as the range and its pieces.
+     * @param aDelimiter Delimiter.
+     */
+    CSplitRange(std::basic_string_view<TChar> aTxt, const TDelimiter& aDelimiter) noexcept
+        : mTxt{aTxt}
+        , mDelimiter{aDelimiter}
+    {
+    }
+
+    /**
+     * @brief Return iterator to the first piece. The first delimiter is searched.
+     *
+     * @return Iterator.
+     */
+    CIterator begin() const noexcept
+    {
+        return CIterator{*this};
+    }
+
+    /**
+     * @brief Return iterator after the last piece.
+     *
+     * @return Iterator.
+     */
+    CIterator end() const noexcept
+    {
+        return CIterator{};
+    }
+};
+
+/**
+ * @brief Split the given string by the given character.
+ *
+ * @tparam TString Type of string with data() and size(): CSmallStringOpt, CSimpleString, std::basic_string or
+ * std::basic_string_view.
+ * @param aStr String, it must live as long as the range and its pieces.
+ * @param aDelimiter Delimiter.
+ * @return Lazy range of pieces.
+ */
+template<typename TString>
+CSplitRange<typename TString::value_type, CCharDelimiter<typename TString::value_type>>
+    split(const TString& aStr, typename TString::value_type aDelimiter) noexcept
+{
+    using TChar = typename TString::value_type;
+    return {std::basic_string_view<TChar>{aStr.data(), aStr.size()}, CCharDelimiter<TChar>{aDelimiter}};
+}
+
+/**
+ * @brief Split the given string by the given sequence of characters.
+ *
+ * @tparam TString Type of string with data() and size(): CSmallStringOpt, CSimpleString, std::basic_string or
+ * std::basic_string_view.
+ * @param aStr String, it must live as long as the range and its pieces.
+ * @param aDelimiter Delimiter, it must live as long as the range. An empty delimiter doesn't split.
+ * @return Lazy range of pieces.
+ */
+template<typename TString>
+CSplitRange<typename TString::value_type, CStringDelimiter<typename TString::value_type>>
+    split(const TString& aStr, std::basic_string_view<typename TString::value_type> aDelimiter) noexcept
+{
+    using TChar = typename TString::value_type;
+    return {std::basic_string_view<TChar>{aStr.data(), aStr.size()}, CStringDelimiter<TChar>{aDelimiter}};
+}
+
+/**
+ * @brief Split the given string by the given null terminated sequence of characters.
+ *
+ * @tparam TString Type of string with data() and size(): CSmallStringOpt, CSimpleString, std::basic_string or
+ * std::basic_string_view.
+ * @param aStr String, it must live as long as the range and its pieces.
+ * @param aDelimiter Delimiter, it must live as long as the range. An empty delimiter doesn't split.
+ * @return Lazy range of pieces.
+ */
+template<typename TString>
+CSplitRange<typename TString::value_type, CStringDelimiter<typename TString::value_type>>
+    split(const TString& aStr, const typename TString::value_type* aDelimiter) noexcept
+{
+    return split(aStr, std::basic_string_view<typename TString::value_type>{aDelimiter});
+}
+
+/**
+ * @brief Split the given string by any character of the set, see anyOf.
+ *
+ * @tparam TString Type of string with data() and size(): CSmallStringOpt, CSimpleString, std::basic_string or
+ * std::basic_string_view.
+ * @param aStr String, it must live as long as the range and its pieces.
+ * @param aDelimiter Set of delimiters.
+ * @return Lazy range of pieces.
+ */
+template<typename TString>
+CSplitRange<typename TString::value_type, CAnyOfDelimiter<typename TString::value_type>>
+    split(const TString& aStr, const CAnyOfDelimiter<typename TString::value_type>& aDelimiter) noexcept
+{
+    using TChar = typename TString::value_type;
+    return {std::basic_string_view<TChar>{aStr.data(), aStr.size()}, aDelimiter};
+}
+
+} // namespace NSSO
+
+#endif // SPLIT_HPP_
@@ -0,0 +1,387 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Opt-in profiler of small string optimization hit rate. Define NSSO_ENABLE_PROFILER to enable it.
+ * Without the define all hooks are empty inline functions, so the profiler has no cost.
+ */
+
+#ifndef SSO_PROFILER_HPP_
+#define SSO_PROFILER_HPP_
+
+#include <cstddef>
+#include <ostream>
+
+#if defined(NSSO_ENABLE_PROFILER)
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#endif
+
+namespace NSSO
+{
+
+/**
+ * @brief Operation of CSmallStringOpt that is recorded by the profiler.
+ */
+enum class ESsoOperation
+{
+    eConstruct = 0,
+    eAssign,
+    eAppend,
+    eReserve,
+    eCount
+};
+
+/**
+ * @brief Where characters are stored after recorded operation.
+ */
+enum class ESsoPlacement
+{
+    eInline = 0,    // in small string optimization array
+    eSpill,         // moved to dynamic array by this operation
+    eHeap,          // already in dynamic array before this operation
+    eCount
+};
+
+#if defined(NSSO_ENABLE_PROFILER)
+
+/**
+ * @brief Statistics of a single CSmallStringOpt instantiation. Trivially destructible, so it's still valid when the report is printed at exit.
+ */
+struct CSsoProfileRecord
+{
+    /**
+     * @brief Lengths smaller than this value are counted exactly. Longer ones are counted in the overflow bucket.
+     */
+    static constexpr std::size_t sMaxTrackedLength = 256u;
+
+    /**
+     * @brief Length of small string optimization array.
+     */
+    std::size_t mSmallStringOptLength;
+
+    /**
+     * @brief Size of character in bytes.
+     */
+    std::size_t mCharSize;
+
+    /**
+     * @brief Number of operations per operation type and placement.
+     */
+    std::array<std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(ESsoPlacement::eCount)>,
+        static_cast<std::size_t>(ESsoOperation::eCount)> mCounters;
+
+    /**
+     * @brief Histogram of string lengths after construction, assignment and appending.
+     */
+    std::array<std::atomic<std::uint64_t>, sMaxTrackedLength> mLengthHistogram;
+
+    /**
+     * @brief Number of lengths not smaller than sMaxTrackedLength.
+     */
+    std::atomic<std::uint64_t> mOverflowCount;
+
+    /**
+     * @brief Sum of lengths not smaller than sMaxTrackedLength.
+     */
+    std::atomic<std::uint64_t> mOverflowLengthSum;
+
+    /**
+     * @brief Next registered record.
+     */
+    CSsoProfileRecord* mNext;
+
+    /**
+     * @brief Construct and register record.
+     *
+     * @param aSmallStringOptLength Length of small string optimization array.
+     * @param aCharSize Size of character in bytes.
+     */
+    CSsoProfileRecord(std::size_t aSmallStringOptLength, std::size_t aCharSize) noexcept;
+
+    /**
+     * @brief Record operation.
+     *
+     * @param aOperation Operation.
+     * @param aPlacement Placement of characters after the operation.
+     * @param aLength Length of string after the operation.
+     */
+    void record(ESsoOperation aOperation, ESsoPlacement aPlacement, std::size_t aLength) noexcept
+    {
+        mCounters[static_cast<std::size_t>(aOperation)][static_cast<std::size_t>(aPlacement)]
+            .fetch_add(1u, std::memory_order_relaxed);
+        if (aOperation == ESsoOperation::eReserve)
+        {
+            return ;
+        }
+        if (aLength < sMaxTrackedLength)
+        {
+            mLengthHistogram[aLength].fetch_add(1u, std::memory_order_relaxed);
+        }
+        else
+        {
+            mOverflowCount.fetch_add(1u, std::memory_order_relaxed);
+            mOverflowLengthSum.fetch_add(aLength, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Return number of operations.
+     *
+     * @param aOperation Operation.
+     * @param aPlacement Placement.
+     * @return Number of operations.
+     */
+    std::uint64_t count(ESsoOperation aOperation, ESsoPlacement aPlacement) const noexcept
+    {
+        return mCounters[static_cast<std::size_t>(aOperation)][static_cast<std::size_t>(aPlacement)]
+            .load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Profiler of all CSmallStringOpt instantiations.
+ */
+class CSsoProfiler
+{
+private:
+
+    /**
+     * @brief Return head of the list of registered records.
+     *
+     * @return Head of the list.
+     */
+    static std::atomic<CSsoProfileRecord*>& head() noexcept
+    {
+        static std::atomic<CSsoProfileRecord*> sHead{nullptr};
+        return sHead;
+    }
+
+    /**
+     * @brief Print report to std::cerr. Used by std::atexit.
+     */
+    static void reportToStdErr()
+    {
+        report(std::cerr);
+    }
+
+    /**
+     * @brief Return the smallest length of small string optimization array that keeps the given fraction of strings inline.
+     *
+     * @param aRecord Record.
+     * @param aTotal Number of lengths in the histogram.
+     * @param aFraction Fraction of strings that shall be inline.
+     * @return Length of small string optimization array (a terminating character is included).
+     */
+    static std::size_t lengthForFraction(const CSsoProfileRecord& aRecord, std::uint64_t aTotal, double aFraction) noexcept
+    {
+        std::uint64_t sum = 0u;
+        for (std::size_t i = 0u; i < CSsoProfileRecord::sMaxTrackedLength; ++i)
+        {
+            sum += aRecord.mLengthHistogram[i].load(std::memory_order_relaxed);
+            if (static_cast<double>(sum) >= aFraction * static_cast<double>(aTotal))
+            {
+                return i + 1u;
+            }
+        }
+        return CSsoProfileRecord::sMaxTrackedLength + 1u;
+    }
+
+public:
+
+    /**
+     * @brief Add record to the list of registered records.
+     *
+     * @param aRecord Record.
+     */
+    static void registerRecord(CSsoProfileRecord* aRecord) noexcept
+    {
+        CSsoProfileRecord* current = head().load(std::memory_order_relaxed);
+        do
+        {
+            aRecord->mNext = current;
+        } while (!head().compare_exchange_weak(current, aRecord, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Return the record of the given instantiation.
+     *
+     * @tparam TSmallStringOptLength Length of small string optimization array.
+     * @tparam TChar Character type.
+     * @return Record.
+     */
+    template<std::size_t TSmallStringOptLength, typename TChar>
+    static CSsoProfileRecord& record() noexcept
+    {
+        static CSsoProfileRecord sRecord{TSmallStringOptLength, sizeof(TChar)};
+        return sRecord;
+    }
+
+    /**
+     * @brief Print report of all instantiations on the given stream. Can be called at any time.
+     *
+     * @param aStream Output stream.
+     */
+    static void report(std::ostream& aStream)
+    {
+        static const char* const sOperationNames[] = {"construct", "assign", "append", "reserve"};
+        aStream << "---------- small string optimization profile ----------\n";
+        for (const CSsoProfileRecord* rec = head().load(std::memory_order_acquire); rec != nullptr; rec = rec->mNext)
+        {
+            std::uint64_t inlineCount = 0u;
+            std::uint64_t spillCount = 0u;
+            std::uint64_t heapCount = 0u;
+            for (std::size_t op = 0u; op < static_cast<std::size_t>(ESsoOperation::eCount); ++op)
+            {
+                inlineCount += rec->count(static_cast<ESsoOperation>(op), ESsoPlacement::eInline);
+                spillCount += rec->count(static_cast<ESsoOperation>(op), ESsoPlacement::eSpill);
+                heapCount += rec->count(static_cast<ESsoOperation>(op), ESsoPlacement::eHeap);
+            }
+            const std::uint64_t all = inlineCount + spillCount + heapCount;
+            aStream << "CSmallStringOpt<" << rec->mSmallStringOptLength << ">, character size " << rec->mCharSize << "B\n";
+            aStream << "  operations: " << all << ", inline: " << inlineCount;
+            if (all != 0u)
+            {
+                aStream << " (" << (100.0 * static_cast<double>(inlineCount) / static_cast<double>(all)) << "%)";
+            }
+            aStream << ", spilled: " << spillCount << ", already on heap: " << heapCount << '\n';
+            aStream << "  spill reasons:";
+            for (std::size_t op = 0u; op < static_cast<std::size_t>(ESsoOperation::eCount); ++op)
+            {
+                aStream << ' ' << sOperationNames[op] << '=' << rec->count(static_cast<ESsoOperation>(op), ESsoPlacement::eSpill);
+            }
+            aStream << '\n';
+
+            std::uint64_t lengths = rec->mOverflowCount.load(std::memory_order_relaxed);
+            for (const auto& bucket : rec->mLengthHistogram)
+            {
+                lengths += bucket.load(std::memory_order_relaxed);
+            }
+            if (lengths != 0u)
+            {
+                aStream << "  array length keeping 50%/90%/99% inline: "
+                    << lengthForFraction(*rec, lengths, 0.5) << '/'
+                    << lengthForFraction(*rec, lengths, 0.9) << '/'
+                    << lengthForFraction(*rec, lengths, 0.99) << '\n';
+            }
+        }
+        aStream << "--------------------------------------------------------" << std::endl;
+    }
+
+    /**
+     * @brief Print histogram of lengths of all instantiations in format: "length count" - one pair per line.
+     * Lengths not smaller than CSsoProfileRecord::sMaxTrackedLength are printed as their average length.
+     *
+     * @param aStream Output stream.
+     */
+    static void dumpLengths(std::ostream& aStream)
+    {
+        std::array<std::uint64_t, CSsoProfileRecord::sMaxTrackedLength> histogram{};
+        std::uint64_t overflowCount = 0u;
+        std::uint64_t overflowSum = 0u;
+        for (const CSsoProfileRecord* rec = head().load(std::memory_order_acquire); rec != nullptr; rec = rec->mNext)
+        {
+            for (std::size_t i = 0u; i < CSsoProfileRecord::sMaxTrackedLength; ++i)
+            {
+                histogram[i] += rec->mLengthHistogram[i].load(std::memory_order_relaxed);
+            }
+            overflowCount += rec->mOverflowCount.load(std::memory_order_relaxed);
+            overflowSum += rec->mOverflowLengthSum.load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0u; i < CSsoProfileRecord::sMaxTrackedLength; ++i)
+        {
+            if (histogram[i] != 0u)
+            {
+                aStream << i << ' ' << histogram[i] << '\n';
+            }
+        }
+        if (overflowCount != 0u)
+        {
+            aStream << (overflowSum / overflowCount) << ' ' << overflowCount << '\n';
+        }
+    }
+
+    /**
+     * @brief Print report on std::cerr at exit. Calling it more than once has no effect.
+     */
+    static void reportAtExit() noexcept
+    {
+        static const bool sRegistered = (std::atexit(&CSsoProfiler::reportToStdErr) == 0);
+        (void)sRegistered;
+    }
+};
+
+inline CSsoProfileRecord::CSsoProfileRecord(std::size_t aSmallStringOptLength, std::size_t aCharSize) noexcept
+    : mSmallStringOptLength{aSmallStringOptLength}
+    , mCharSize{aCharSize}
+    , mCounters{}
+    , mLengthHistogram{}
+    , mOverflowCount{0u}
+    , mOverflowLengthSum{0u}
+    , mNext{nullptr}
+{
+    CSsoProfiler::registerRecord(this);
+}
+
+/**
+ * @brief Hook called by CSmallStringOpt.
+ *
+ * @tparam TSmallStringOptLength Length of small string optimization array.
+ * @tparam TChar Character type.
+ */
+template<std::size_t TSmallStringOptLength, typename TChar>
+struct CSsoProfilerHook
+{
+    static void record(ESsoOperation aOperation, ESsoPlacement aPlacement, std::size_t aLength) noexcept
+    {
+        CSsoProfiler::record<TSmallStringOptLength, TChar>().record(aOperation, aPlacement, aLength);
+    }
+};
+
+#else // NSSO_ENABLE_PROFILER
+
+/**
+ * @brief Profiler stub used when NSSO_ENABLE_PROFILER is not defined.
+ */
+class CSsoProfiler
+{
+public:
+
+    static void report(std::ostream&)
+    {
+    }
+
+    static void dumpLengths(std::ostream&)
+    {
+    }
+
+    static void reportAtExit() noexcept
+    {
+    }
+};
+
+/**
+ * @brief Hook called by CSmallStringOpt. Does nothing, because NSSO_ENABLE_PROFILER is not defined.
+ *
+ * @tparam TSmallStringOptLength Length of small string optimization array.
+ * @tparam TChar Character type.
+ */
+template<std::size_t TSmallStringOptLength, typename TChar>
+struct CSsoProfilerHook
+{
+    static void record(ESsoOperation, ESsoPlacement, std::size_t) noexcept
+    {
+    }
+};
+
+#endif // NSSO_ENABLE_PROFILER
+
+} // namespace NSSO
+
+#endif // SSO_PROFILER_HPP_
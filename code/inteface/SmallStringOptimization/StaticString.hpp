@@ -0,0 +1,255 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * String literals with length and hash computed at compile time.
+ */
+
+#ifndef STATIC_STRING_HPP_
+#define STATIC_STRING_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "internal/InternalHelper.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Compute FNV-1a hash of the given characters. Can be evaluated at compile time.
+ *
+ * @tparam TChar Type of characters.
+ * @param aTxt Characters.
+ * @param aLength Number of characters.
+ * @return Hash.
+ */
+template<typename TChar>
+constexpr std::uint64_t hashOf(const TChar* aTxt, std::size_t aLength) noexcept
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0u; i < aLength; ++i)
+    {
+        hash ^= static_cast<std::uint64_t>(aTxt[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compute FNV-1a hash of characters of the given string, the same as hash of CStaticString with the same
+ * characters. Dispatch code hashes a key once and compares it with many literals, see CStaticString::equals.
+ *
+ * @tparam TString Type of string with data() and size(): CSmallStringOpt, CSimpleString, std::basic_string or
+ * std::basic_string_view.
+ * @param aStr String.
+ * @return Hash.
+ */
+template<typename TString>
+constexpr std::uint64_t hashOf(const TString& aStr) noexcept
+{
+    return hashOf(aStr.data(), aStr.size());
+}
+
+/**
+ * @brief View of a string literal with length and hash computed at compile time (created by the _sso literal or from
+ * an array of characters in a constant expression). Comparing it with a string doesn't count characters of
+ * the literal: lengths are compared first, then characters.
+ *
+ * @tparam TChar Type of characters.
+ */
+template<typename TChar>
+class CStaticString
+{
+public:
+    using value_type = TChar;
+    using size_type = std::size_t;
+
+private:
+    /**
+     * @brief Null terminated characters, not owned.
+     */
+    const TChar* mTxt;
+
+    /**
+     * @brief Number of characters.
+     */
+    size_type mLength;
+
+    /**
+     * @brief Hash of characters, see hashOf.
+     */
+    std::uint64_t mHash;
+
+public:
+    /**
+     * @brief Construct from a string literal. Its length is taken from the type of array, so it mustn't be a buffer
+     * with a shorter null terminated text.
+     *
+     * @tparam TLength Number of characters with the null character.
+     * @param aTxt String literal.
+     */
+    template<size_type TLength>
+    constexpr CStaticString(const TChar (&aTxt)[TLength]) noexcept
+        : mTxt{aTxt}
+        , mLength{TLength - 1u}
+        , mHash{hashOf(aTxt, TLength - 1u)}
+    {
+    }
+
+    /**
+     * @brief Construct from characters of the given length.
+     *
+     * @param aTxt Null terminated characters that live as long as this object (a string literal).
+     * @param aLength Number of characters.
+     */
+    constexpr CStaticString(const TChar* aTxt, size_type aLength) noexcept
+        : mTxt{aTxt}
+        , mLength{aLength}
+        , mHash{hashOf(aTxt, aLength)}
+    {
+    }
+
+    constexpr const TChar* data() const noexcept
+    {
+        return mTxt;
+    }
+
+    constexpr const TChar* c_str() const noexcept
+    {
+        return mTxt;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        return mLength;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return mLength == 0u;
+    }
+
+    /**
+     * @brief Return hash of characters, see hashOf.
+     *
+     * @return Hash.
+     */
+    constexpr std::uint64_t hash() const noexcept
+    {
+        return mHash;
+    }
+
+    constexpr const TChar* begin() const noexcept
+    {
+        return mTxt;
+    }
+
+    constexpr const TChar* end() const noexcept
+    {
+        return mTxt + mLength;
+    }
+
+    constexpr TChar operator[](size_type aIndex) const noexcept
+    {
+        return mTxt[aIndex];
+    }
+
+    /**
+     * @brief Return view of characters.
+     *
+     * @return View.
+     */
+    constexpr std::basic_string_view<TChar> view() const noexcept
+    {
+        return std::basic_string_view<TChar>{mTxt, mLength};
+    }
+
+    /**
+     * @brief Check if the given characters are equal to this literal: lengths, hashes and then characters are
+     * compared, so comparing a key with many literals costs mostly integer comparisons.
+     *
+     * @param aTxt Characters.
+     * @param aLength Number of characters.
+     * @param aHash Hash of characters, see hashOf.
+     * @return true if equal.
+     */
+    constexpr bool equals(const TChar* aTxt, size_type aLength, std::uint64_t aHash) const noexcept
+    {
+        return aLength == mLength && aHash == mHash && equals(aTxt);
+    }
+
+    /**
+     * @brief Check if the given characters are equal to characters of this literal.
+     *
+     * @param aTxt Characters, at least size() of them.
+     * @return true if equal.
+     */
+    constexpr bool equals(const TChar* aTxt) const noexcept
+    {
+        return mLength == 0u || std::char_traits<TChar>::compare(mTxt, aTxt, mLength) == 0;
+    }
+};
+
+/**
+ * @brief Compare literals: lengths, hashes and then characters.
+ *
+ * @tparam TChar Type of characters.
+ * @param aObj1 First literal.
+ * @param aObj2 Second literal.
+ * @return true if equal.
+ */
+template<typename TChar>
+constexpr bool operator==(const CStaticString<TChar>& aObj1, const CStaticString<TChar>& aObj2) noexcept
+{
+    return aObj1.equals(aObj2.data(), aObj2.size(), aObj2.hash());
+}
+
+template<typename TChar>
+constexpr bool operator!=(const CStaticString<TChar>& aObj1, const CStaticString<TChar>& aObj2) noexcept
+{
+    return !(aObj1 == aObj2);
+}
+
+/**
+ * @brief String literals with length and hash computed at compile time: "route"_sso.
+ */
+inline namespace literals
+{
+
+NSSO_CONSTEVAL CStaticString<char> operator""_sso(const char* aTxt, std::size_t aLength) noexcept
+{
+    return CStaticString<char>{aTxt, aLength};
+}
+
+NSSO_CONSTEVAL CStaticString<wchar_t> operator""_sso(const wchar_t* aTxt, std::size_t aLength) noexcept
+{
+    return CStaticString<wchar_t>{aTxt, aLength};
+}
+
+NSSO_CONSTEVAL CStaticString<char16_t> operator""_sso(const char16_t* aTxt, std::size_t aLength) noexcept
+{
+    return CStaticString<char16_t>{aTxt, aLength};
+}
+
+NSSO_CONSTEVAL CStaticString<char32_t> operator""_sso(const char32_t* aTxt, std::size_t aLength) noexcept
+{
+    return CStaticString<char32_t>{aTxt, aLength};
+}
+
+#if defined(__cpp_char8_t)
+NSSO_CONSTEVAL CStaticString<char8_t> operator""_sso(const char8_t* aTxt, std::size_t aLength) noexcept
+{
+    return CStaticString<char8_t>{aTxt, aLength};
+}
+#endif // __cpp_char8_t
+
+} // namespace literals
+
+} // namespace NSSO
+
+#endif // STATIC_STRING_HPP_
@@ -0,0 +1,76 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Policies that change how CSmallStringOpt manages its dynamic memory.
+ */
+
+#ifndef STRING_POLICY_HPP_
+#define STRING_POLICY_HPP_
+
+namespace NSSO
+{
+
+/**
+ * @brief Default policy: each string owns its dynamic memory.
+ */
+struct CDefaultStringPolicy
+{
+    /**
+     * @brief True if dynamic memory is shared between copies and cloned on the first modification.
+     */
+    static constexpr bool sCopyOnWrite = false;
+
+    /**
+     * @brief True if characters stay in dynamic memory when string shrinks (erase, resize, clear...) to a length that
+     * fits into the small string optimization array, so the memory is reused when string grows again. False if
+     * characters are moved back to the array and dynamic memory is released.
+     */
+    static constexpr bool sKeepHeapOnShrink = true;
+};
+
+/**
+ * @brief Copy on write policy: strings that don't fit into the small string optimization array keep characters in
+ * a dynamic memory with an atomic reference counter. Copies share the memory, so copying is O(1). The memory is cloned
+ * when a shared string is modified or a non-constant reference/iterator to its characters is taken.
+ * Strings that fit into the small string optimization array are copied as usual.
+ */
+struct CCopyOnWritePolicy
+{
+    /**
+     * @brief True if dynamic memory is shared between copies and cloned on the first modification.
+     */
+    static constexpr bool sCopyOnWrite = true;
+
+    /**
+     * @brief True if characters stay in dynamic memory when string shrinks to a length that fits into the small
+     * string optimization array.
+     */
+    static constexpr bool sKeepHeapOnShrink = true;
+};
+
+/**
+ * @brief Compact policy: each string owns its dynamic memory. When string shrinks (erase, resize, clear...) to
+ * a length that fits into the small string optimization array, characters are moved back to the array and dynamic
+ * memory is released. Useful for long living strings that are rarely long.
+ */
+struct CCompactStringPolicy
+{
+    /**
+     * @brief True if dynamic memory is shared between copies and cloned on the first modification.
+     */
+    static constexpr bool sCopyOnWrite = false;
+
+    /**
+     * @brief True if characters stay in dynamic memory when string shrinks to a length that fits into the small
+     * string optimization array.
+     */
+    static constexpr bool sKeepHeapOnShrink = false;
+};
+
+} // namespace NSSO
+
+#endif // STRING_POLICY_HPP_
@@ -0,0 +1,243 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Streams writing directly into CSmallStringOpt and CSimpleString.
+ */
+
+#ifndef STRING_STREAM_HPP_
+#define STRING_STREAM_HPP_
+
+#include <algorithm>
+#include <climits>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace NSSO
+{
+
+/**
+ * @brief Stream buffer whose put area is spare memory of a string (the small string optimization array or dynamic
+ * memory), so written characters land directly in the string. Memory grows in overflow/xsputn at least twice.
+ * Written characters are committed to the string (its size and the terminating character are updated) by sync
+ * (e.g. std::flush), str() and the destructor. The string must not be used by other means in the meantime.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ */
+template<typename TString>
+class CStringStreamBuf : public std::basic_streambuf<typename TString::value_type>
+{
+public:
+    /**
+     * @brief Character type.
+     */
+    using char_type = typename TString::value_type;
+
+    /**
+     * @brief Character traits.
+     */
+    using traits_type = std::char_traits<char_type>;
+
+    /**
+     * @brief Integer type of characters.
+     */
+    using int_type = typename traits_type::int_type;
+
+private:
+    /**
+     * @brief Size type.
+     */
+    using size_type = typename TString::size_type;
+
+    /**
+     * @brief Minimal number of characters put area grows by.
+     */
+    static constexpr size_type sMinimalGrowth = 64u;
+
+    /**
+     * @brief String written to.
+     */
+    TString* mString;
+
+public:
+    /**
+     * @brief Construct stream buffer appending to the given string.
+     *
+     * @param aString String.
+     */
+    explicit CStringStreamBuf(TString& aString)
+        : mString{&aString}
+    {
+        setupPut(0u);
+    }
+
+    CStringStreamBuf(const CStringStreamBuf&) = delete;
+    CStringStreamBuf& operator=(const CStringStreamBuf&) = delete;
+
+    /**
+     * @brief Commit written characters.
+     */
+    ~CStringStreamBuf() override
+    {
+        commitPut();
+    }
+
+    /**
+     * @brief Commit written characters and return the string.
+     *
+     * @return String.
+     */
+    TString& str()
+    {
+        commitPut();
+        setupPut(0u);
+        return *mString;
+    }
+
+protected:
+    /**
+     * @brief Commit written characters.
+     *
+     * @return 0.
+     */
+    int sync() override
+    {
+        commitPut();
+        setupPut(0u);
+        return 0;
+    }
+
+    /**
+     * @brief Put area is full: commit written characters, grow string and write the given character.
+     *
+     * @param aChar Character or EOF.
+     * @return Not EOF on success.
+     */
+    int_type overflow(int_type aChar) override
+    {
+        commitPut();
+        setupPut(std::max(sMinimalGrowth, mString->size()));
+        if (!traits_type::eq_int_type(aChar, traits_type::eof()))
+        {
+            *this->pptr() = traits_type::to_char_type(aChar);
+            this->pbump(1);
+        }
+        return traits_type::not_eof(aChar);
+    }
+
+    /**
+     * @brief Write the given characters, growing string at most once.
+     *
+     * @param aTxt Characters.
+     * @param aCount Number of characters.
+     * @return Number of written characters.
+     */
+    std::streamsize xsputn(const char_type* aTxt, std::streamsize aCount) override
+    {
+        if (aCount <= 0)
+        {
+            return 0;
+        }
+        const size_type count = static_cast<size_type>(aCount);
+        if (static_cast<size_type>(this->epptr() - this->pptr()) < count)
+        {
+            commitPut();
+            setupPut(std::max(count, std::max(sMinimalGrowth, mString->size())));
+        }
+        traits_type::copy(this->pptr(), aTxt, count);
+        for (size_type left = count; left != 0u;)
+        {
+            const size_type step = std::min<size_type>(left, INT_MAX);
+            this->pbump(static_cast<int>(step));
+            left -= step;
+        }
+        return aCount;
+    }
+
+private:
+    /**
+     * @brief Set length of string to include characters written to put area.
+     */
+    void commitPut() noexcept
+    {
+        if (this->pbase() != this->pptr())
+        {
+            mString->commit(mString->size() + static_cast<size_type>(this->pptr() - this->pbase()));
+        }
+        this->setp(nullptr, nullptr);
+    }
+
+    /**
+     * @brief Set put area to spare memory of string, growing it if less than the given number of characters is
+     * available.
+     *
+     * @param aMinimum Minimal number of characters of put area.
+     */
+    void setupPut(size_type aMinimum)
+    {
+        // grows memory only if it is too small or shared (copy on write), so spare memory is measured in memory owned
+        // by this string
+        mString->grow_uninitialized(aMinimum);
+        const size_type length = spare();
+        char_type* const ptr = mString->grow_uninitialized(length); // doesn't allocate, memory is already owned
+        this->setp(ptr, ptr + length);
+    }
+
+    /**
+     * @brief Return number of characters that fit into string's memory after the last character.
+     *
+     * @return Number of characters.
+     */
+    size_type spare() const noexcept
+    {
+        const size_type size = mString->size();
+        const size_type capacity = mString->capacity();
+        return capacity > size + 1u ? capacity - size - 1u : 0u;
+    }
+};
+
+/**
+ * @brief Output stream writing directly into a string (see CStringStreamBuf). Characters are committed to the string
+ * by std::flush, str() and the destructor.
+ *
+ * @tparam TString Type of string: CSmallStringOpt or CSimpleString.
+ */
+template<typename TString>
+class CStringOStream : public std::basic_ostream<typename TString::value_type>
+{
+    /**
+     * @brief Stream buffer.
+     */
+    CStringStreamBuf<TString> mBuffer;
+
+public:
+    /**
+     * @brief Construct stream appending to the given string.
+     *
+     * @param aString String.
+     */
+    explicit CStringOStream(TString& aString)
+        : std::basic_ostream<typename TString::value_type>(nullptr)
+        , mBuffer{aString}
+    {
+        this->init(&mBuffer);
+    }
+
+    /**
+     * @brief Commit written characters and return the string.
+     *
+     * @return String.
+     */
+    TString& str()
+    {
+        return mBuffer.str();
+    }
+};
+
+} // namespace NSSO
+
+#endif // STRING_STREAM_HPP_
@@ -0,0 +1,559 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Vector of strings that relocates trivially relocatable strings by copying bytes.
+ */
+
+#ifndef STRING_VECTOR_HPP_
+#define STRING_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Relocation.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Vector of strings (or any other nothrow movable objects). If TString is trivially relocatable (see
+ * CIsTriviallyRelocatable: CSmallStringOpt and CSimpleString with std::allocator) growing copies bytes of all strings
+ * by a single memcpy, insert and erase shift strings after the position by a single memmove, instead of moving and
+ * destroying strings one by one like std::vector does. Other types fall back to moving.
+ * Iterators are pointers, so they are invalidated like iterators of std::vector.
+ *
+ * @tparam TString Type of elements.
+ * @tparam TAllocator Allocator of elements.
+ */
+template<typename TString, typename TAllocator = std::allocator<TString>>
+class CStringVector
+{
+    static_assert(gIsTriviallyRelocatable<TString> || std::is_nothrow_move_constructible<TString>::value,
+        "elements have to be relocated without exceptions");
+
+public:
+    using value_type = TString;
+    using allocator_type = TAllocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = TString&;
+    using const_reference = const TString&;
+    using pointer = TString*;
+    using const_pointer = const TString*;
+    using iterator = TString*;
+    using const_iterator = const TString*;
+
+    /**
+     * @brief True if strings are relocated by copying their bytes.
+     */
+    static constexpr bool sTriviallyRelocatable = gIsTriviallyRelocatable<TString>;
+
+private:
+    /**
+     * @brief Allocator traits.
+     */
+    using TAllocatorTraits = std::allocator_traits<TAllocator>;
+
+    /**
+     * @brief Elements.
+     */
+    TString* mData;
+
+    /**
+     * @brief Number of elements.
+     */
+    size_type mSize;
+
+    /**
+     * @brief Number of elements that fit into allocated memory.
+     */
+    size_type mCapacity;
+
+    /**
+     * @brief Allocator.
+     */
+    TAllocator mAllocator;
+
+    /**
+     * @brief True if move assignment can take over memory of the given vector without allocating, because the
+     * allocator is propagated on move assignment or all its instances are equal.
+     */
+    static constexpr bool sMoveTakesMemory =
+        TAllocatorTraits::propagate_on_container_move_assignment::value || TAllocatorTraits::is_always_equal::value;
+
+    /**
+     * @brief True if swap can exchange memory without allocating, because the allocator is propagated on swap or all
+     * its instances are equal.
+     */
+    static constexpr bool sSwapTakesMemory =
+        TAllocatorTraits::propagate_on_container_swap::value || TAllocatorTraits::is_always_equal::value;
+
+public:
+    /**
+     * @brief Construct empty vector.
+     */
+    CStringVector() noexcept
+        : CStringVector(TAllocator{})
+    {
+    }
+
+    /**
+     * @brief Construct empty vector with the given allocator.
+     *
+     * @param aAllocator Allocator of elements.
+     */
+    explicit CStringVector(const TAllocator& aAllocator) noexcept
+        : mData{nullptr}
+        , mSize{0u}
+        , mCapacity{0u}
+        , mAllocator{aAllocator}
+    {
+    }
+
+    /**
+     * @brief Construct vector by copying elements of the given one. The allocator is given by
+     * select_on_container_copy_construction.
+     *
+     * @param aObj Vector to copy.
+     */
+    CStringVector(const CStringVector& aObj)
+        : CStringVector(TAllocatorTraits::select_on_container_copy_construction(aObj.mAllocator))
+    {
+        append(aObj);
+    }
+
+    /**
+     * @brief Construct vector by taking over memory of the given one, which is left empty.
+     *
+     * @param aObj Vector to move.
+     */
+    CStringVector(CStringVector&& aObj) noexcept
+        : mData{aObj.mData}
+        , mSize{aObj.mSize}
+        , mCapacity{aObj.mCapacity}
+        , mAllocator{aObj.mAllocator}
+    {
+        aObj.mData = nullptr;
+        aObj.mSize = 0u;
+        aObj.mCapacity = 0u;
+    }
+
+    /**
+     * @brief Copy elements of the given vector. The allocator is copied if it is propagated on copy assignment.
+     *
+     * @param aObj Vector to copy.
+     * @return This vector.
+     */
+    CStringVector& operator=(const CStringVector& aObj)
+    {
+        if (this != &aObj)
+        {
+            // the copy owns memory of the allocator that this vector has afterwards, so everything is exchanged
+            CStringVector copy{TAllocatorTraits::propagate_on_container_copy_assignment::value
+                ? aObj.mAllocator : mAllocator};
+            copy.append(aObj);
+            swapMemory(copy);
+            std::swap(mAllocator, copy.mAllocator);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Take over memory of the given vector. Nothing is allocated unless the allocator isn't propagated on move
+     * assignment and the allocators differ, then elements are moved one by one to memory of this vector's allocator.
+     *
+     * @param aObj Vector to move.
+     * @return This vector.
+     */
+    CStringVector& operator=(CStringVector&& aObj) noexcept(sMoveTakesMemory)
+    {
+        if (this == &aObj)
+        {
+            return *this;
+        }
+        if constexpr (false == sMoveTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                CStringVector moved{mAllocator};
+                moved.reserve(aObj.mSize);
+                for (TString& str : aObj)
+                {
+                    moved.emplace_back(std::move(str));
+                }
+                swapMemory(moved);
+                return *this;
+            }
+        }
+        // old elements are released by the allocator that allocated them
+        CStringVector old{mAllocator};
+        swapMemory(old);
+        if constexpr (TAllocatorTraits::propagate_on_container_move_assignment::value)
+        {
+            mAllocator = aObj.mAllocator;
+        }
+        swapMemory(aObj);
+        return *this;
+    }
+
+    ~CStringVector()
+    {
+        clear();
+        TAllocatorTraits::deallocate(mAllocator, mData, mCapacity);
+    }
+
+    /**
+     * @brief Swap elements of vectors. Nothing is allocated unless the allocator isn't propagated on swap and the
+     * allocators differ, then elements are moved one by one.
+     *
+     * @param aObj Vector to swap with.
+     */
+    void swap(CStringVector& aObj) noexcept(sSwapTakesMemory)
+    {
+        if constexpr (false == sSwapTakesMemory)
+        {
+            if (mAllocator != aObj.mAllocator)
+            {
+                CStringVector tmp{std::move(aObj)};
+                aObj = std::move(*this);
+                *this = std::move(tmp);
+                return ;
+            }
+        }
+        if constexpr (TAllocatorTraits::propagate_on_container_swap::value)
+        {
+            std::swap(mAllocator, aObj.mAllocator);
+        }
+        swapMemory(aObj);
+    }
+
+    /**
+     * @brief Return allocator of elements.
+     *
+     * @return Allocator.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return mAllocator;
+    }
+
+    /**
+     * @brief Return number of elements.
+     *
+     * @return Number of elements.
+     */
+    size_type size() const noexcept
+    {
+        return mSize;
+    }
+
+    /**
+     * @brief Return number of elements that fit into allocated memory.
+     *
+     * @return Capacity.
+     */
+    size_type capacity() const noexcept
+    {
+        return mCapacity;
+    }
+
+    /**
+     * @brief Indicate if vector is empty.
+     *
+     * @return true if empty.
+     */
+    bool empty() const noexcept
+    {
+        return mSize == 0u;
+    }
+
+    TString* data() noexcept
+    {
+        return mData;
+    }
+
+    const TString* data() const noexcept
+    {
+        return mData;
+    }
+
+    iterator begin() noexcept
+    {
+        return mData;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return mData;
+    }
+
+    iterator end() noexcept
+    {
+        return mData + mSize;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return mData + mSize;
+    }
+
+    TString& operator[](size_type aIndex) noexcept
+    {
+        return mData[aIndex];
+    }
+
+    const TString& operator[](size_type aIndex) const noexcept
+    {
+        return mData[aIndex];
+    }
+
+    TString& front() noexcept
+    {
+        return mData[0];
+    }
+
+    const TString& front() const noexcept
+    {
+        return mData[0];
+    }
+
+    TString& back() noexcept
+    {
+        return mData[mSize - 1u];
+    }
+
+    const TString& back() const noexcept
+    {
+        return mData[mSize - 1u];
+    }
+
+    /**
+     * @brief Make sure that the given number of elements fits without reallocation.
+     *
+     * @param aCapacity Number of elements.
+     */
+    void reserve(size_type aCapacity)
+    {
+        if (aCapacity > mCapacity)
+        {
+            TString* const ptr = TAllocatorTraits::allocate(mAllocator, aCapacity);
+            relocate(ptr, mData, mSize);
+            TAllocatorTraits::deallocate(mAllocator, mData, mCapacity);
+            mData = ptr;
+            mCapacity = aCapacity;
+        }
+    }
+
+    /**
+     * @brief Construct element at the end. Memory grows twice if it is full.
+     *
+     * @tparam TArgs Types of arguments.
+     * @param aArgs Arguments of constructor of element.
+     * @return Reference to the new element.
+     */
+    template<typename... TArgs>
+    TString& emplace_back(TArgs&&... aArgs)
+    {
+        if (mSize == mCapacity)
+        {
+            // the element is constructed before relocation, because arguments may refer to elements
+            TString str(std::forward<TArgs>(aArgs)...);
+            reserve(nextCapacity());
+            new (mData + mSize) TString(std::move(str));
+        }
+        else
+        {
+            new (mData + mSize) TString(std::forward<TArgs>(aArgs)...);
+        }
+        return mData[mSize++];
+    }
+
+    void push_back(const TString& aStr)
+    {
+        emplace_back(aStr);
+    }
+
+    void push_back(TString&& aStr)
+    {
+        emplace_back(std::move(aStr));
+    }
+
+    /**
+     * @brief Destroy the last element.
+     */
+    void pop_back() noexcept
+    {
+        --mSize;
+        mData[mSize].~TString();
+    }
+
+    /**
+     * @brief Construct element at the given position. Elements after the position are shifted by a single memmove if
+     * they are trivially relocatable. If memory is full, elements before and after the position are copied to new
+     * memory around the new element.
+     *
+     * @tparam TArgs Types of arguments.
+     * @param aPos Position of the new element.
+     * @param aArgs Arguments of constructor of element.
+     * @return Iterator to the new element.
+     */
+    template<typename... TArgs>
+    iterator emplace(const_iterator aPos, TArgs&&... aArgs)
+    {
+        const size_type index = static_cast<size_type>(aPos - mData);
+        if constexpr (sTriviallyRelocatable)
+        {
+            // the element is constructed before relocation, because arguments may refer to elements
+            TString str(std::forward<TArgs>(aArgs)...);
+            if (mSize == mCapacity)
+            {
+                const size_type capacity = nextCapacity();
+                TString* const ptr = TAllocatorTraits::allocate(mAllocator, capacity);
+                relocate(ptr, mData, index);
+                relocate(ptr + index + 1u, mData + index, mSize - index);
+                TAllocatorTraits::deallocate(mAllocator, mData, mCapacity);
+                mData = ptr;
+                mCapacity = capacity;
+            }
+            else if (index != mSize)
+            {
+                std::memmove(static_cast<void*>(mData + index + 1u), static_cast<const void*>(mData + index),
+                    (mSize - index) * sizeof(TString));
+            }
+            new (mData + index) TString(std::move(str));
+            ++mSize;
+        }
+        else
+        {
+            emplace_back(std::forward<TArgs>(aArgs)...);
+            std::rotate(mData + index, mData + mSize - 1u, mData + mSize);
+        }
+        return mData + index;
+    }
+
+    iterator insert(const_iterator aPos, const TString& aStr)
+    {
+        return emplace(aPos, aStr);
+    }
+
+    iterator insert(const_iterator aPos, TString&& aStr)
+    {
+        return emplace(aPos, std::move(aStr));
+    }
+
+    /**
+     * @brief Destroy elements in the given range. Elements after the range are shifted by a single memmove if they are
+     * trivially relocatable.
+     *
+     * @param aFirst First element to erase.
+     * @param aLast Element after the last one to erase.
+     * @return Iterator to the element after erased ones.
+     */
+    iterator erase(const_iterator aFirst, const_iterator aLast) noexcept
+    {
+        TString* const first = mData + (aFirst - mData);
+        TString* const last = mData + (aLast - mData);
+        const size_type count = static_cast<size_type>(last - first);
+        if (count == 0u)
+        {
+            return first;
+        }
+        if constexpr (sTriviallyRelocatable)
+        {
+            std::destroy(first, last);
+            std::memmove(static_cast<void*>(first), static_cast<const void*>(last),
+                static_cast<size_type>(end() - last) * sizeof(TString));
+        }
+        else
+        {
+            std::move(last, end(), first);
+            std::destroy(end() - count, end());
+        }
+        mSize -= count;
+        return first;
+    }
+
+    /**
+     * @brief Destroy element at the given position.
+     *
+     * @param aPos Element to erase.
+     * @return Iterator to the element after the erased one.
+     */
+    iterator erase(const_iterator aPos) noexcept
+    {
+        return erase(aPos, aPos + 1);
+    }
+
+    /**
+     * @brief Destroy all elements. Memory is kept.
+     */
+    void clear() noexcept
+    {
+        std::destroy(mData, mData + mSize);
+        mSize = 0u;
+    }
+
+private:
+    /**
+     * @brief Copy elements of the given vector to the end.
+     *
+     * @param aObj Vector to copy.
+     */
+    void append(const CStringVector& aObj)
+    {
+        reserve(mSize + aObj.mSize);
+        for (const TString& str : aObj)
+        {
+            emplace_back(str);
+        }
+    }
+
+    /**
+     * @brief Swap memory and elements, but not allocators.
+     *
+     * @param aObj Vector to swap with.
+     */
+    void swapMemory(CStringVector& aObj) noexcept
+    {
+        std::swap(mData, aObj.mData);
+        std::swap(mSize, aObj.mSize);
+        std::swap(mCapacity, aObj.mCapacity);
+    }
+
+    /**
+     * @brief Return capacity after growth.
+     *
+     * @return Twice the current capacity, at least 4 elements.
+     */
+    size_type nextCapacity() const noexcept
+    {
+        return std::max<size_type>(4u, mCapacity * 2u);
+    }
+};
+
+/**
+ * @brief Swap elements of vectors.
+ *
+ * @tparam TString Type of elements.
+ * @tparam TAllocator Allocator of elements.
+ * @param aObj1 First vector.
+ * @param aObj2 Second vector.
+ */
+template<typename TString, typename TAllocator>
+void swap(CStringVector<TString, TAllocator>& aObj1, CStringVector<TString, TAllocator>& aObj2)
+    noexcept(noexcept(aObj1.swap(aObj2)))
+{
+    aObj1.swap(aObj2);
+}
+
+} // namespace NSSO
+
+#endif // STRING_VECTOR_HPP_
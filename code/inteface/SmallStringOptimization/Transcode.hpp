@@ -0,0 +1,581 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Transcoding between UTF-8, UTF-16 and UTF-32 strings (the encoding is given by the size of character).
+ */
+
+#ifndef TRANSCODE_HPP_
+#define TRANSCODE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "internal/Search.hpp"
+#include "internal/Utf8.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Decoding and encoding of code points in UTF-8, UTF-16 or UTF-32 for characters of 1, 2 or 4 bytes. Invalid
+ * input (see CScalarUtf8::codePointLength, unpaired surrogates, code points above U+10FFFF) is decoded as U+FFFD, one
+ * code unit at a time.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+struct CUtfCodec
+{
+    static_assert(sizeof(TChar) == 1u || sizeof(TChar) == 2u || sizeof(TChar) == 4u,
+        "characters have to be UTF-8, UTF-16 or UTF-32 code units");
+
+    /**
+     * @brief Replacement character.
+     */
+    static constexpr char32_t sReplacement = 0xFFFDu;
+
+    /**
+     * @brief Decode the code point at aBeg and move aBeg after it.
+     */
+    static char32_t decode(const TChar*& aBeg, const TChar* aEnd) noexcept
+    {
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            const unsigned char* const beg = reinterpret_cast<const unsigned char*>(aBeg);
+            const std::size_t length = CScalarUtf8::codePointLength(beg, reinterpret_cast<const unsigned char*>(aEnd));
+            if (length == 0u)
+            {
+                ++aBeg;
+                return sReplacement;
+            }
+            aBeg += length;
+            constexpr unsigned char leadMask[5] = {0u, 0x7Fu, 0x1Fu, 0x0Fu, 0x07u};
+            char32_t codePoint = beg[0] & leadMask[length];
+            for (std::size_t i = 1u; i < length; ++i)
+            {
+                codePoint = (codePoint << 6u) | (beg[i] & 0x3Fu);
+            }
+            return codePoint;
+        }
+        else if constexpr (sizeof(TChar) == 2u)
+        {
+            const char32_t unit = toUnit(*aBeg++);
+            if ((unit & 0xF800u) != 0xD800u)
+            {
+                return unit;
+            }
+            if (unit <= 0xDBFFu && aBeg != aEnd && (toUnit(*aBeg) & 0xFC00u) == 0xDC00u)
+            {
+                return 0x10000u + ((unit - 0xD800u) << 10u) + (toUnit(*aBeg++) - 0xDC00u);
+            }
+            return sReplacement;
+        }
+        else
+        {
+            const char32_t codePoint = toUnit(*aBeg++);
+            return codePoint > 0x10FFFFu || (codePoint & 0xFFFFF800u) == 0xD800u ? sReplacement : codePoint;
+        }
+    }
+
+    /**
+     * @brief Return number of characters of the encoded code point.
+     */
+    static std::size_t encodedLength(char32_t aCodePoint) noexcept
+    {
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            return aCodePoint < 0x80u ? 1u : aCodePoint < 0x800u ? 2u : aCodePoint < 0x10000u ? 3u : 4u;
+        }
+        else if constexpr (sizeof(TChar) == 2u)
+        {
+            return aCodePoint < 0x10000u ? 1u : 2u;
+        }
+        else
+        {
+            return 1u;
+        }
+    }
+
+    /**
+     * @brief Encode the valid code point.
+     *
+     * @return Pointer after written characters.
+     */
+    static TChar* encode(char32_t aCodePoint, TChar* aOut) noexcept
+    {
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            if (aCodePoint < 0x80u)
+            {
+                *aOut++ = static_cast<TChar>(aCodePoint);
+            }
+            else if (aCodePoint < 0x800u)
+            {
+                *aOut++ = static_cast<TChar>(0xC0u | (aCodePoint >> 6u));
+                *aOut++ = static_cast<TChar>(0x80u | (aCodePoint & 0x3Fu));
+            }
+            else if (aCodePoint < 0x10000u)
+            {
+                *aOut++ = static_cast<TChar>(0xE0u | (aCodePoint >> 12u));
+                *aOut++ = static_cast<TChar>(0x80u | ((aCodePoint >> 6u) & 0x3Fu));
+                *aOut++ = static_cast<TChar>(0x80u | (aCodePoint & 0x3Fu));
+            }
+            else
+            {
+                *aOut++ = static_cast<TChar>(0xF0u | (aCodePoint >> 18u));
+                *aOut++ = static_cast<TChar>(0x80u | ((aCodePoint >> 12u) & 0x3Fu));
+                *aOut++ = static_cast<TChar>(0x80u | ((aCodePoint >> 6u) & 0x3Fu));
+                *aOut++ = static_cast<TChar>(0x80u | (aCodePoint & 0x3Fu));
+            }
+        }
+        else if constexpr (sizeof(TChar) == 2u)
+        {
+            if (aCodePoint < 0x10000u)
+            {
+                *aOut++ = static_cast<TChar>(aCodePoint);
+            }
+            else
+            {
+                *aOut++ = static_cast<TChar>(0xD800u + ((aCodePoint - 0x10000u) >> 10u));
+                *aOut++ = static_cast<TChar>(0xDC00u + ((aCodePoint - 0x10000u) & 0x3FFu));
+            }
+        }
+        else
+        {
+            *aOut++ = static_cast<TChar>(aCodePoint);
+        }
+        return aOut;
+    }
+
+    /**
+     * @brief Return value of the code unit.
+     */
+    static char32_t toUnit(TChar aChar) noexcept
+    {
+        return static_cast<char32_t>(static_cast<std::make_unsigned_t<TChar>>(aChar));
+    }
+};
+
+/**
+ * @brief Scalar transcoding: code points are decoded and encoded one by one.
+ *
+ * @tparam TIn Type of input characters.
+ * @tparam TOut Type of output characters.
+ */
+template<typename TIn, typename TOut>
+struct CScalarTranscoder
+{
+    static std::size_t outputLength(const TIn* aBeg, const TIn* aEnd) noexcept
+    {
+        std::size_t length = 0u;
+        while (aBeg != aEnd)
+        {
+            length += CUtfCodec<TOut>::encodedLength(CUtfCodec<TIn>::decode(aBeg, aEnd));
+        }
+        return length;
+    }
+
+    /**
+     * @brief Convert characters from aBeg to aEnd into the output of outputLength characters from aOut to aOutEnd.
+     *
+     * @return Pointer after written characters.
+     */
+    static TOut* convert(const TIn* aBeg, const TIn* aEnd, TOut* aOut, TOut* /*aOutEnd*/) noexcept
+    {
+        while (aBeg != aEnd)
+        {
+            aOut = CUtfCodec<TOut>::encode(CUtfCodec<TIn>::decode(aBeg, aEnd), aOut);
+        }
+        return aOut;
+    }
+};
+
+/**
+ * @brief Transcoding with SSE2 if available. Characters that are converted by a cast (ASCII if UTF-8 is the input or
+ * the output, UTF-16 and UTF-32 characters below U+10000 without surrogates) are skipped or converted by vectors of
+ * 16 bytes of the narrower side, the others are decoded one by one until the next such character. The output length of
+ * UTF-16 and UTF-32 input is counted on vectors, invalid input falls back to CScalarTranscoder, so the result is always
+ * the same as of CScalarTranscoder.
+ *
+ * @tparam TIn Type of input characters.
+ * @tparam TOut Type of output characters.
+ */
+template<typename TIn, typename TOut>
+struct CSimdTranscoder
+{
+    static std::size_t outputLength(const TIn* aBeg, const TIn* aEnd) noexcept
+    {
+        if constexpr (sizeof(TIn) == 1u)
+        {
+            std::size_t length = 0u;
+            while (aBeg != aEnd)
+            {
+                const std::size_t simple = skipSimple(aBeg, aEnd);
+                length += simple;
+                aBeg += simple;
+                while (aBeg != aEnd && false == isSimple(*aBeg))
+                {
+                    length += CUtfCodec<TOut>::encodedLength(CUtfCodec<TIn>::decode(aBeg, aEnd));
+                }
+            }
+            return length;
+        }
+        else
+        {
+            const std::size_t length = static_cast<std::size_t>(aEnd - aBeg);
+            CCounts counts;
+            count(aBeg, aEnd, counts);
+            if (counts.mInvalid == 0u)
+            {
+                if constexpr (sizeof(TOut) == 1u)
+                {
+                    return length + counts.mAbove7F + counts.mAbove7FF + counts.mAboveFFFF;
+                }
+                else if constexpr (sizeof(TOut) == 2u)
+                {
+                    return length + counts.mAboveFFFF;
+                }
+                else
+                {
+                    return length;
+                }
+            }
+            return CScalarTranscoder<TIn, TOut>::outputLength(aBeg, aEnd);
+        }
+    }
+
+    static TOut* convert(const TIn* aBeg, const TIn* aEnd, TOut* aOut, TOut* aOutEnd) noexcept
+    {
+        while (aBeg != aEnd)
+        {
+            const std::size_t simple = convertSimple(aBeg, aEnd, aOut, aOutEnd);
+            aBeg += simple;
+            aOut += simple;
+            while (aBeg != aEnd && false == isSimple(*aBeg))
+            {
+                aOut = CUtfCodec<TOut>::encode(CUtfCodec<TIn>::decode(aBeg, aEnd), aOut);
+            }
+        }
+        return aOut;
+    }
+
+private:
+
+    /**
+     * @brief Number of input characters of a vector: 16 bytes of the narrower side.
+     */
+    static constexpr std::size_t sBlockLength = 16u / (sizeof(TIn) < sizeof(TOut) ? sizeof(TIn) : sizeof(TOut));
+
+    /**
+     * @brief Counts of UTF-16 and UTF-32 characters.
+     */
+    struct CCounts
+    {
+        std::size_t mAbove7F = 0u;
+        std::size_t mAbove7FF = 0u;
+        std::size_t mAboveFFFF = 0u;
+
+        /**
+         * @brief Surrogates and code points above U+10FFFF. UTF-16 surrogates may be valid pairs, but the scalar pass
+         * checks them.
+         */
+        std::size_t mInvalid = 0u;
+    };
+
+    /**
+     * @brief Return true if the character is converted by a cast.
+     */
+    static bool isSimple(TIn aChar) noexcept
+    {
+        const char32_t unit = CUtfCodec<TIn>::toUnit(aChar);
+        if constexpr (sizeof(TIn) == 1u || sizeof(TOut) == 1u)
+        {
+            return unit < 0x80u;
+        }
+        else
+        {
+            return unit < 0x10000u && (unit & 0xF800u) != 0xD800u;
+        }
+    }
+
+    /**
+     * @brief Return number of characters at aBeg converted by a cast, at most to the end of the next vector.
+     */
+    static std::size_t skipSimple(const TIn* aBeg, const TIn* aEnd) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if (static_cast<std::size_t>(aEnd - aBeg) >= sBlockLength)
+        {
+            const std::uint32_t mask = notSimpleMask(aBeg);
+            return mask == 0u ? sBlockLength : lowestBitIndex(mask);
+        }
+#endif
+        return aBeg != aEnd && isSimple(*aBeg) ? 1u : 0u;
+    }
+
+    /**
+     * @brief Convert characters at aBeg converted by a cast, at most to the end of the next vector. The whole vector is
+     * stored if the output has room for it, characters after converted ones are overwritten later.
+     *
+     * @return Number of converted characters.
+     */
+    static std::size_t convertSimple(const TIn* aBeg, const TIn* aEnd, TOut* aOut, TOut* aOutEnd) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if (static_cast<std::size_t>(aEnd - aBeg) >= sBlockLength
+            && static_cast<std::size_t>(aOutEnd - aOut) >= sBlockLength)
+        {
+            const std::uint32_t mask = notSimpleMask(aBeg);
+            convertBlock(aBeg, aOut);
+            return mask == 0u ? sBlockLength : lowestBitIndex(mask);
+        }
+#else
+        static_cast<void>(aOutEnd);
+#endif
+        const std::size_t simple = skipSimple(aBeg, aEnd);
+        for (std::size_t i = 0u; i < simple; ++i)
+        {
+            aOut[i] = static_cast<TOut>(aBeg[i]);
+        }
+        return simple;
+    }
+
+    static void count(const TIn* aBeg, const TIn* aEnd, CCounts& aCounts) noexcept
+    {
+#if defined(NSSO_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        // bits of movemask per character
+        constexpr unsigned int bits = sizeof(TIn);
+        while (aEnd - aBeg >= static_cast<std::ptrdiff_t>(16u / sizeof(TIn)))
+        {
+            const __m128i block = load(aBeg);
+            if constexpr (sizeof(TIn) == 2u)
+            {
+                const __m128i high5 = _mm_and_si128(block, _mm_set1_epi16(static_cast<short>(0xF800u)));
+                aCounts.mAbove7F += (16u - popCount(CSse2Ops::movemask(_mm_cmpeq_epi16(
+                    _mm_and_si128(block, _mm_set1_epi16(static_cast<short>(0xFF80u))), zero)))) / bits;
+                aCounts.mAbove7FF += (16u - popCount(CSse2Ops::movemask(_mm_cmpeq_epi16(high5, zero)))) / bits;
+                aCounts.mInvalid += popCount(CSse2Ops::movemask(
+                    _mm_cmpeq_epi16(high5, _mm_set1_epi16(static_cast<short>(0xD800u)))));
+            }
+            else
+            {
+                const auto above = [&](std::uint32_t aMask)
+                {
+                    return (16u - popCount(CSse2Ops::movemask(_mm_cmpeq_epi32(
+                        _mm_and_si128(block, _mm_set1_epi32(static_cast<int>(aMask))), zero)))) / bits;
+                };
+                aCounts.mAbove7F += above(0xFFFFFF80u);
+                aCounts.mAbove7FF += above(0xFFFFF800u);
+                aCounts.mAboveFFFF += above(0xFFFF0000u);
+                // surrogates and code points above U+10FFFF (signed comparisons miss values with the highest bit set)
+                const __m128i surrogates = _mm_cmpeq_epi32(
+                    _mm_and_si128(block, _mm_set1_epi32(static_cast<int>(0xFFFFF800u))), _mm_set1_epi32(0xD800));
+                const __m128i tooLarge = _mm_or_si128(
+                    _mm_cmpgt_epi32(block, _mm_set1_epi32(0x10FFFF)), _mm_cmplt_epi32(block, zero));
+                aCounts.mInvalid += popCount(CSse2Ops::movemask(_mm_or_si128(surrogates, tooLarge))) / bits;
+            }
+            aBeg += 16u / sizeof(TIn);
+        }
+#endif
+        for (; aBeg != aEnd; ++aBeg)
+        {
+            const char32_t unit = CUtfCodec<TIn>::toUnit(*aBeg);
+            aCounts.mAbove7F += unit > 0x7Fu ? 1u : 0u;
+            aCounts.mAbove7FF += unit > 0x7FFu ? 1u : 0u;
+            aCounts.mAboveFFFF += unit > 0xFFFFu ? 1u : 0u;
+            aCounts.mInvalid += (unit & 0xFFFFF800u) == 0xD800u || unit > 0x10FFFFu ? 1u : 0u;
+        }
+    }
+
+#if defined(NSSO_SSE2)
+    static __m128i load(const void* aPtr) noexcept
+    {
+        return _mm_loadu_si128(static_cast<const __m128i*>(aPtr));
+    }
+
+    static void store(void* aPtr, __m128i aVec) noexcept
+    {
+        _mm_storeu_si128(static_cast<__m128i*>(aPtr), aVec);
+    }
+
+    /**
+     * @brief Return mask of sBlockLength characters at aIn with bits set for characters not converted by a cast.
+     */
+    static std::uint32_t notSimpleMask(const TIn* aIn) noexcept
+    {
+        const __m128i zero = _mm_setzero_si128();
+        if constexpr (sizeof(TIn) == 1u)
+        {
+            return CSse2Ops::movemask(load(aIn));
+        }
+        else if constexpr (sizeof(TIn) == 2u)
+        {
+            __m128i simple1;
+            __m128i simple2 = zero;
+            if constexpr (sizeof(TOut) == 1u)
+            {
+                const __m128i ascii = _mm_set1_epi16(static_cast<short>(0xFF80u));
+                simple1 = _mm_cmpeq_epi16(_mm_and_si128(load(aIn), ascii), zero);
+                simple2 = _mm_cmpeq_epi16(_mm_and_si128(load(aIn + 8), ascii), zero);
+            }
+            else
+            {
+                const __m128i high5 = _mm_and_si128(load(aIn), _mm_set1_epi16(static_cast<short>(0xF800u)));
+                simple1 = _mm_xor_si128(_mm_cmpeq_epi16(high5, _mm_set1_epi16(static_cast<short>(0xD800u))),
+                    _mm_cmpeq_epi8(zero, zero));
+            }
+            // one byte per character
+            return ~CSse2Ops::movemask(_mm_packs_epi16(simple1, simple2)) & ((1u << sBlockLength) - 1u);
+        }
+        else
+        {
+            const auto simple = [&](const TIn* aPtr)
+            {
+                const __m128i block = load(aPtr);
+                if constexpr (sizeof(TOut) == 1u)
+                {
+                    return _mm_cmpeq_epi32(_mm_and_si128(block, _mm_set1_epi32(static_cast<int>(0xFFFFFF80u))), zero);
+                }
+                else
+                {
+                    const __m128i surrogate = _mm_cmpeq_epi32(
+                        _mm_and_si128(block, _mm_set1_epi32(static_cast<int>(0xFFFFF800u))), _mm_set1_epi32(0xD800));
+                    return _mm_andnot_si128(surrogate, _mm_cmpeq_epi32(
+                        _mm_and_si128(block, _mm_set1_epi32(static_cast<int>(0xFFFF0000u))), zero));
+                }
+            };
+            const __m128i simple12 = _mm_packs_epi32(simple(aIn), simple(aIn + 4));
+            const __m128i simple34 = sizeof(TOut) == 1u ? _mm_packs_epi32(simple(aIn + 8), simple(aIn + 12)) : zero;
+            // one byte per character
+            return ~CSse2Ops::movemask(_mm_packs_epi16(simple12, simple34)) & ((1u << sBlockLength) - 1u);
+        }
+    }
+
+    /**
+     * @brief Convert sBlockLength characters, the result is valid for characters converted by a cast.
+     */
+    static void convertBlock(const TIn* aIn, TOut* aOut) noexcept
+    {
+        const __m128i zero = _mm_setzero_si128();
+        if constexpr (sizeof(TIn) == sizeof(TOut))
+        {
+            store(aOut, load(aIn));
+        }
+        else if constexpr (sizeof(TIn) == 1u)
+        {
+            const __m128i block = load(aIn);
+            const __m128i low = _mm_unpacklo_epi8(block, zero);
+            const __m128i high = _mm_unpackhi_epi8(block, zero);
+            if constexpr (sizeof(TOut) == 2u)
+            {
+                store(aOut, low);
+                store(aOut + 8, high);
+            }
+            else
+            {
+                store(aOut, _mm_unpacklo_epi16(low, zero));
+                store(aOut + 4, _mm_unpackhi_epi16(low, zero));
+                store(aOut + 8, _mm_unpacklo_epi16(high, zero));
+                store(aOut + 12, _mm_unpackhi_epi16(high, zero));
+            }
+        }
+        else if constexpr (sizeof(TOut) == 1u)
+        {
+            if constexpr (sizeof(TIn) == 2u)
+            {
+                store(aOut, _mm_packus_epi16(load(aIn), load(aIn + 8)));
+            }
+            else
+            {
+                store(aOut, _mm_packus_epi16(_mm_packs_epi32(load(aIn), load(aIn + 4)),
+                    _mm_packs_epi32(load(aIn + 8), load(aIn + 12))));
+            }
+        }
+        else if constexpr (sizeof(TIn) == 2u)
+        {
+            const __m128i block = load(aIn);
+            store(aOut, _mm_unpacklo_epi16(block, zero));
+            store(aOut + 4, _mm_unpackhi_epi16(block, zero));
+        }
+        else
+        {
+            // sign extension keeps 16 bits of characters through the signed saturation of packs
+            store(aOut, _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(load(aIn), 16), 16),
+                _mm_srai_epi32(_mm_slli_epi32(load(aIn + 4), 16), 16)));
+        }
+    }
+#endif
+};
+
+/**
+ * @brief Append characters of the given string transcoded to the encoding of the output string: characters of 1, 2
+ * and 4 bytes are UTF-8, UTF-16 and UTF-32 (wchar_t is UTF-16 or UTF-32 depending on its size), characters of the same
+ * size are copied. Invalid input is replaced by U+FFFD. The output length is computed by a SIMD pass first, so memory
+ * of the output grows at most once (characters stay in the small string optimization array if they fit).
+ *
+ * @tparam TOutString Type of output string: CSmallStringOpt or CSimpleString.
+ * @tparam TInString Type of input string with data() and size(): CSmallStringOpt, CSimpleString, std::basic_string or
+ * std::basic_string_view.
+ * @tparam TTranscoder Transcoding kernels.
+ * @param aOutput String to append to.
+ * @param aInput String to transcode, not a part of aOutput.
+ */
+template<
+    typename TOutString,
+    typename TInString,
+    typename TTranscoder = CSimdTranscoder<
+        typename TInString::value_type, typename TOutString::value_type>>
+void transcode_to(TOutString& aOutput, const TInString& aInput)
+{
+    using TIn = typename TInString::value_type;
+    using TOut = typename TOutString::value_type;
+    const TIn* const begin = aInput.data();
+    const TIn* const end = begin + aInput.size();
+    std::size_t length = 0u;
+    if constexpr (sizeof(TIn) == sizeof(TOut))
+    {
+        length = aInput.size();
+    }
+    else
+    {
+        length = TTranscoder::outputLength(begin, end);
+    }
+    TOut* const ptr = aOutput.grow_uninitialized(length);
+    if constexpr (sizeof(TIn) == sizeof(TOut))
+    {
+        for (std::size_t i = 0u; i < length; ++i)
+        {
+            ptr[i] = static_cast<TOut>(begin[i]);
+        }
+    }
+    else
+    {
+        TTranscoder::convert(begin, end, ptr, ptr + length);
+    }
+    aOutput.commit(aOutput.size() + length);
+}
+
+/**
+ * @brief Transcode the given string into a new string, see transcode_to.
+ *
+ * @tparam TOutString Type of result: CSmallStringOpt or CSimpleString.
+ * @tparam TInString Type of input string with data() and size().
+ * @param aInput String to transcode.
+ * @return Transcoded string.
+ */
+template<typename TOutString, typename TInString>
+TOutString transcode(const TInString& aInput)
+{
+    TOutString output;
+    transcode_to(output, aInput);
+    return output;
+}
+
+} // namespace NSSO
+
+#endif // TRANSCODE_HPP_
@@ -7,21 +7,80 @@
 #ifndef INTERNAL_HELPER_HPP_
 #define INTERNAL_HELPER_HPP_
 #include <cstring>
+#include <cwchar>
 #include <map>
 #include <iterator>
 #include <algorithm>
+#include <string>
+#include <type_traits>
+#include "Search.hpp"
+
+/**
+ * @brief NSSO_CONSTEXPR20 is constexpr if C++20 constant evaluation (std::is_constant_evaluated, allocations and
+ * non-trivial destructors in constant expressions) is available, otherwise empty. NSSO_HAS_CONSTEXPR20 is defined then.
+ */
+#if defined(__cpp_lib_is_constant_evaluated) && defined(__cpp_constexpr_dynamic_alloc)
+#define NSSO_HAS_CONSTEXPR20 1
+#define NSSO_CONSTEXPR20 constexpr
+#else
+#define NSSO_CONSTEXPR20
+#endif
+
+/**
+ * @brief NSSO_CONSTEVAL is consteval if immediate functions are available (C++20), so the call is guaranteed to be
+ * evaluated at compile time, otherwise constexpr.
+ */
+#if defined(__cpp_consteval)
+#define NSSO_CONSTEVAL consteval
+#else
+#define NSSO_CONSTEVAL constexpr
+#endif
 
 namespace NSSO
 {
 
-inline std::size_t txtLength(const char* aTxt)
+/**
+ * @brief Check if the call is evaluated at compile time, so functions can skip code that cannot be constant
+ * evaluated (memcpy, SIMD, profiler...).
+ *
+ * @return true during constant evaluation; always false before C++20.
+ */
+constexpr bool isConstantEvaluated() noexcept
 {
-    return std::strlen(aTxt);
+#if defined(NSSO_HAS_CONSTEXPR20)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
 }
 
-inline std::size_t txtLength(const wchar_t* aTxt)
+/**
+ * @brief Return number of characters before the null character. char and wchar_t use strlen and wcslen of the C library,
+ * other types of characters (char8_t, char16_t, char32_t) are scanned by SSE2/AVX2 vectors, see CSimdSearch::length.
+ *
+ * @tparam TChar Type of character.
+ * @param aTxt Null terminated text.
+ * @return Length of text.
+ */
+template<typename TChar>
+NSSO_CONSTEXPR20 std::size_t txtLength(const TChar* aTxt) noexcept
 {
-    return std::wcslen(aTxt);
+    if (isConstantEvaluated())
+    {
+        return std::char_traits<TChar>::length(aTxt);
+    }
+    if constexpr (std::is_same<TChar, char>::value)
+    {
+        return std::strlen(aTxt);
+    }
+    else if constexpr (std::is_same<TChar, wchar_t>::value)
+    {
+        return std::wcslen(aTxt);
+    }
+    else
+    {
+        return CSimdSearch<TChar>::length(aTxt);
+    }
 }
 
 
@@ -42,8 +101,17 @@ struct CStd
 template<typename T, typename TFastType = long>
 struct CFast
 {
-    static T* memcpy(T* aDest, const T* aSrc, std::size_t aLength)
+    static NSSO_CONSTEXPR20 T* memcpy(T* aDest, const T* aSrc, std::size_t aLength)
     {
+        if (isConstantEvaluated())
+        {
+            // reinterpret_cast cannot be constant evaluated, copy element by element
+            for (std::size_t i = 0; i < aLength / sizeof(T); ++i)
+            {
+                aDest[i] = aSrc[i];
+            }
+            return aDest;
+        }
         const char* srcPtrByte = reinterpret_cast<const char*>(aSrc);
         char* destPtrByte = reinterpret_cast<char*>(aDest);
         
@@ -68,8 +136,12 @@ struct CFast
         return aDest;
     }
     
-    static bool equal(const T* aBeg1, const T* aEnd1, const T* aBeg2)
+    static NSSO_CONSTEXPR20 bool equal(const T* aBeg1, const T* aEnd1, const T* aBeg2)
     {
+        if (isConstantEvaluated())
+        {
+            return std::equal(aBeg1, aEnd1, aBeg2);
+        }
         const char* begPtrByte1 = reinterpret_cast<const char*>(aBeg1);
         const char* begPtrByte2 = reinterpret_cast<const char*>(aBeg2);
         const char* endPtrByte1 = reinterpret_cast<const char*>(aEnd1);
@@ -103,6 +175,38 @@ struct CFast
     }
 };
 
+/**
+ * @brief True for types of characters, that are appended as characters, not as numbers.
+ */
+template<typename T>
+struct CIsCharacter : std::integral_constant<bool,
+    std::is_same<T, char>::value || std::is_same<T, wchar_t>::value
+    || std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value
+#if defined(__cpp_char8_t)
+    || std::is_same<T, char8_t>::value
+#endif
+    >
+{
+};
+
+/**
+ * @brief Enable overload for integer types (bool excluded).
+ */
+template<typename T>
+using TEnableIfInteger = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>;
+
+/**
+ * @brief Enable overload for floating point types.
+ */
+template<typename T>
+using TEnableIfFloatingPoint = std::enable_if_t<std::is_floating_point<T>::value, int>;
+
+/**
+ * @brief Enable overload for numbers: arithmetic types except bool and types of characters.
+ */
+template<typename T>
+using TEnableIfNumber = std::enable_if_t<
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && !CIsCharacter<T>::value, int>;
 
 } // namespace NSSO
 
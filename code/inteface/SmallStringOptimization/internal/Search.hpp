@@ -0,0 +1,1114 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Search kernels used by find family of string functions. Single character, small set and short needle searches
+ * of 1 byte characters use SSE2/AVX2 if the compiler targets them (define NSSO_DISABLE_SIMD to turn it off), other
+ * cases use scalar code. Long needles in long texts are searched by Boyer-Moore-Horspool. Null characters of 1, 2 and
+ * 4 byte characters are scanned by SSE2/AVX2 too.
+ */
+
+#ifndef SEARCH_HPP_
+#define SEARCH_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if !defined(NSSO_DISABLE_SIMD)
+#if defined(__AVX2__)
+#define NSSO_AVX2 1
+#endif
+#if defined(__SSSE3__) || defined(NSSO_AVX2)
+#define NSSO_SSSE3 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NSSO_SSE2 1
+#endif
+#endif
+
+#if defined(NSSO_AVX2)
+#include <immintrin.h>
+#elif defined(NSSO_SSSE3)
+#include <tmmintrin.h>
+#elif defined(NSSO_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Null character scans read whole aligned vectors, which may start before the text and end after its null
+ * character (an aligned vector never crosses a page, so it is safe), so AddressSanitizer is disabled for such reads.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define NSSO_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER)
+#define NSSO_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define NSSO_NO_SANITIZE_ADDRESS
+#endif
+
+namespace NSSO
+{
+
+/**
+ * @brief Value returned by search functions if nothing is found.
+ */
+constexpr std::size_t gNpos = static_cast<std::size_t>(-1);
+
+/**
+ * @brief Enable overload for string objects (types with data() and size()), but not for arrays and characters.
+ */
+template<typename TString, typename TChar>
+using TEnableIfStringObject = std::enable_if_t<
+    !std::is_convertible<const TString&, const TChar*>::value && !std::is_convertible<const TString&, TChar>::value,
+    int>;
+
+/**
+ * @brief Return index of the lowest set bit.
+ *
+ * @param aMask Not zero mask.
+ * @return Index of the lowest set bit.
+ */
+inline unsigned int lowestBitIndex(std::uint32_t aMask) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0u;
+    _BitScanForward(&index, aMask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(aMask));
+#endif
+}
+
+/**
+ * @brief Return index of the highest set bit.
+ *
+ * @param aMask Not zero mask.
+ * @return Index of the highest set bit.
+ */
+inline unsigned int highestBitIndex(std::uint32_t aMask) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0u;
+    _BitScanReverse(&index, aMask);
+    return static_cast<unsigned int>(index);
+#else
+    return 31u - static_cast<unsigned int>(__builtin_clz(aMask));
+#endif
+}
+
+/**
+ * @brief Return number of set bits.
+ *
+ * @param aMask Mask.
+ * @return Number of set bits.
+ */
+inline unsigned int popCount(std::uint32_t aMask) noexcept
+{
+#if defined(_MSC_VER)
+    aMask = aMask - ((aMask >> 1u) & 0x55555555u);
+    aMask = (aMask & 0x33333333u) + ((aMask >> 2u) & 0x33333333u);
+    return (((aMask + (aMask >> 4u)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24u;
+#else
+    return static_cast<unsigned int>(__builtin_popcount(aMask));
+#endif
+}
+
+/**
+ * @brief Scalar search kernels. Pointers to the first found character are returned, aEnd (forward search) or
+ * nullptr (backward search) if nothing is found.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+struct CScalarSearch
+{
+    /**
+     * @brief Set length above which 1 byte characters are looked up in a table.
+     */
+    static constexpr std::size_t sTableSetLength = 8u;
+
+    /**
+     * @brief Find the first occurrence of the character.
+     */
+    static const TChar* findChar(const TChar* aBeg, const TChar* aEnd, TChar aChar) noexcept
+    {
+        for (; aBeg != aEnd; ++aBeg)
+        {
+            if (*aBeg == aChar)
+            {
+                return aBeg;
+            }
+        }
+        return aEnd;
+    }
+
+    /**
+     * @brief Find needle (at least 2 characters): scan for its first character and compare the rest.
+     * aLast is the last position where the needle can start + 1.
+     */
+    static const TChar* findNeedle(
+        const TChar* aBeg, const TChar* aLast, const TChar* aNeedle, std::size_t aNeedleLength) noexcept
+    {
+        while (aBeg != aLast)
+        {
+            aBeg = findChar(aBeg, aLast, aNeedle[0]);
+            if (aBeg == aLast)
+            {
+                break;
+            }
+            if (std::char_traits<TChar>::compare(aBeg + 1, aNeedle + 1, aNeedleLength - 1u) == 0)
+            {
+                return aBeg;
+            }
+            ++aBeg;
+        }
+        return aLast;
+    }
+
+    /**
+     * @brief Find the last occurrence of the character.
+     */
+    static const TChar* rfindChar(const TChar* aBeg, const TChar* aEnd, TChar aChar) noexcept
+    {
+        while (aEnd != aBeg)
+        {
+            --aEnd;
+            if (*aEnd == aChar)
+            {
+                return aEnd;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Find the first character that is (aMatch true) or is not (aMatch false) in the set.
+     */
+    static const TChar* findFirstOf(
+        const TChar* aBeg, const TChar* aEnd, const TChar* aSet, std::size_t aSetLength, bool aMatch) noexcept
+    {
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            if (aSetLength > sTableSetLength)
+            {
+                bool table[256] = {};
+                fillTable(table, aSet, aSetLength);
+                for (; aBeg != aEnd; ++aBeg)
+                {
+                    if (table[static_cast<unsigned char>(*aBeg)] == aMatch)
+                    {
+                        return aBeg;
+                    }
+                }
+                return aEnd;
+            }
+        }
+        for (; aBeg != aEnd; ++aBeg)
+        {
+            if (inSet(*aBeg, aSet, aSetLength) == aMatch)
+            {
+                return aBeg;
+            }
+        }
+        return aEnd;
+    }
+
+    /**
+     * @brief Find the last character that is (aMatch true) or is not (aMatch false) in the set.
+     */
+    static const TChar* findLastOf(
+        const TChar* aBeg, const TChar* aEnd, const TChar* aSet, std::size_t aSetLength, bool aMatch) noexcept
+    {
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            if (aSetLength > sTableSetLength)
+            {
+                bool table[256] = {};
+                fillTable(table, aSet, aSetLength);
+                while (aEnd != aBeg)
+                {
+                    --aEnd;
+                    if (table[static_cast<unsigned char>(*aEnd)] == aMatch)
+                    {
+                        return aEnd;
+                    }
+                }
+                return nullptr;
+            }
+        }
+        while (aEnd != aBeg)
+        {
+            --aEnd;
+            if (inSet(*aEnd, aSet, aSetLength) == aMatch)
+            {
+                return aEnd;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Replace every occurrence of aFrom by aTo.
+     */
+    static void replaceChar(TChar* aBeg, TChar* aEnd, TChar aFrom, TChar aTo) noexcept
+    {
+        for (; aBeg != aEnd; ++aBeg)
+        {
+            if (*aBeg == aFrom)
+            {
+                *aBeg = aTo;
+            }
+        }
+    }
+
+private:
+
+    /**
+     * @brief Check if the character is in the set.
+     */
+    static bool inSet(TChar aChar, const TChar* aSet, std::size_t aSetLength) noexcept
+    {
+        for (std::size_t i = 0u; i < aSetLength; ++i)
+        {
+            if (aSet[i] == aChar)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Mark characters of the set in the table.
+     */
+    static void fillTable(bool* aTable, const TChar* aSet, std::size_t aSetLength) noexcept
+    {
+        for (std::size_t i = 0u; i < aSetLength; ++i)
+        {
+            aTable[static_cast<unsigned char>(aSet[i])] = true;
+        }
+    }
+};
+
+#if defined(NSSO_SSE2)
+/**
+ * @brief SSE2 operations on 16 bytes.
+ */
+struct CSse2Ops
+{
+    using TVector = __m128i;
+    static constexpr std::ptrdiff_t sWidth = 16;
+    static constexpr std::uint32_t sFullMask = 0xFFFFu;
+
+    static TVector load(const unsigned char* aPtr) noexcept
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(aPtr));
+    }
+
+    static TVector splat(unsigned char aChar) noexcept
+    {
+        return _mm_set1_epi8(static_cast<char>(aChar));
+    }
+
+    static TVector zero() noexcept
+    {
+        return _mm_setzero_si128();
+    }
+
+    static TVector cmpeq(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm_cmpeq_epi8(aVec1, aVec2);
+    }
+
+    static TVector bitOr(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm_or_si128(aVec1, aVec2);
+    }
+
+    static TVector bitAnd(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm_and_si128(aVec1, aVec2);
+    }
+
+    static TVector bitAndNot(TVector aMask, TVector aVec) noexcept
+    {
+        return _mm_andnot_si128(aMask, aVec);
+    }
+
+    static void store(unsigned char* aPtr, TVector aVec) noexcept
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(aPtr), aVec);
+    }
+
+    static std::uint32_t movemask(TVector aVec) noexcept
+    {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(aVec));
+    }
+
+    NSSO_NO_SANITIZE_ADDRESS static TVector loadAligned(const unsigned char* aPtr) noexcept
+    {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(aPtr));
+    }
+
+    /**
+     * @brief Compare characters of the given size with zero.
+     */
+    template<std::size_t TCharSize>
+    static TVector cmpeqZero(TVector aVec) noexcept
+    {
+        if constexpr (TCharSize == 1u)
+        {
+            return _mm_cmpeq_epi8(aVec, zero());
+        }
+        else if constexpr (TCharSize == 2u)
+        {
+            return _mm_cmpeq_epi16(aVec, zero());
+        }
+        else
+        {
+            return _mm_cmpeq_epi32(aVec, zero());
+        }
+    }
+};
+#endif
+
+#if defined(NSSO_AVX2)
+/**
+ * @brief AVX2 operations on 32 bytes.
+ */
+struct CAvx2Ops
+{
+    using TVector = __m256i;
+    static constexpr std::ptrdiff_t sWidth = 32;
+    static constexpr std::uint32_t sFullMask = 0xFFFFFFFFu;
+
+    static TVector load(const unsigned char* aPtr) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aPtr));
+    }
+
+    static TVector splat(unsigned char aChar) noexcept
+    {
+        return _mm256_set1_epi8(static_cast<char>(aChar));
+    }
+
+    static TVector zero() noexcept
+    {
+        return _mm256_setzero_si256();
+    }
+
+    static TVector cmpeq(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm256_cmpeq_epi8(aVec1, aVec2);
+    }
+
+    static TVector bitOr(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm256_or_si256(aVec1, aVec2);
+    }
+
+    static TVector bitAnd(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm256_and_si256(aVec1, aVec2);
+    }
+
+    static TVector bitAndNot(TVector aMask, TVector aVec) noexcept
+    {
+        return _mm256_andnot_si256(aMask, aVec);
+    }
+
+    static void store(unsigned char* aPtr, TVector aVec) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(aPtr), aVec);
+    }
+
+    static std::uint32_t movemask(TVector aVec) noexcept
+    {
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(aVec));
+    }
+
+    NSSO_NO_SANITIZE_ADDRESS static TVector loadAligned(const unsigned char* aPtr) noexcept
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(aPtr));
+    }
+
+    /**
+     * @brief Compare characters of the given size with zero.
+     */
+    template<std::size_t TCharSize>
+    static TVector cmpeqZero(TVector aVec) noexcept
+    {
+        if constexpr (TCharSize == 1u)
+        {
+            return _mm256_cmpeq_epi8(aVec, zero());
+        }
+        else if constexpr (TCharSize == 2u)
+        {
+            return _mm256_cmpeq_epi16(aVec, zero());
+        }
+        else
+        {
+            return _mm256_cmpeq_epi32(aVec, zero());
+        }
+    }
+};
+#endif
+
+#if defined(NSSO_SSE2)
+/**
+ * @brief Scan for the null character of 1, 2 or 4 byte characters on aligned vectors: the first vector is aligned down
+ * and bytes before the text are shifted out of the mask.
+ *
+ * @tparam TOps Vector operations.
+ */
+template<typename TOps>
+struct CNullScanBlocks
+{
+    /**
+     * @brief Return number of characters before the null character.
+     *
+     * @tparam TChar Type of character.
+     * @param aTxt Null terminated text aligned to the size of character.
+     * @return Length of text.
+     */
+    template<typename TChar>
+    NSSO_NO_SANITIZE_ADDRESS static std::size_t length(const TChar* aTxt) noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(aTxt);
+        const auto offset = static_cast<unsigned int>(address % static_cast<std::uintptr_t>(TOps::sWidth));
+        const unsigned char* block = reinterpret_cast<const unsigned char*>(address - offset);
+        std::uint32_t mask = nullMask<TChar>(block) >> offset;
+        if (mask != 0u)
+        {
+            return lowestBitIndex(mask) / sizeof(TChar);
+        }
+        while (true)
+        {
+            block += TOps::sWidth;
+            mask = nullMask<TChar>(block);
+            if (mask != 0u)
+            {
+                return (static_cast<std::size_t>(block - reinterpret_cast<const unsigned char*>(aTxt))
+                    + lowestBitIndex(mask)) / sizeof(TChar);
+            }
+        }
+    }
+
+private:
+
+    template<typename TChar>
+    static std::uint32_t nullMask(const unsigned char* aBlock) noexcept
+    {
+        return TOps::movemask(TOps::template cmpeqZero<sizeof(TChar)>(TOps::loadAligned(aBlock)));
+    }
+};
+#endif
+
+/**
+ * @brief Byte search kernels on whole vectors. Each function processes blocks while at least one vector remains and
+ * moves the given range, so a narrower kernel or scalar code can finish the rest.
+ *
+ * @tparam TOps Vector operations.
+ */
+template<typename TOps>
+struct CByteSearchBlocks
+{
+    /**
+     * @brief Maximal set length handled by vector kernels.
+     */
+    static constexpr std::size_t sMaxSetLength = 16u;
+
+    static const unsigned char* findChar(const unsigned char*& aBeg, const unsigned char* aEnd, unsigned char aChar) noexcept
+    {
+        const auto needle = TOps::splat(aChar);
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            const std::uint32_t mask = TOps::movemask(TOps::cmpeq(TOps::load(aBeg), needle));
+            if (mask != 0u)
+            {
+                return aBeg + lowestBitIndex(mask);
+            }
+            aBeg += TOps::sWidth;
+        }
+        return nullptr;
+    }
+
+    static const unsigned char* rfindChar(const unsigned char* aBeg, const unsigned char*& aEnd, unsigned char aChar) noexcept
+    {
+        const auto needle = TOps::splat(aChar);
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            const std::uint32_t mask = TOps::movemask(TOps::cmpeq(TOps::load(aEnd - TOps::sWidth), needle));
+            if (mask != 0u)
+            {
+                return aEnd - TOps::sWidth + highestBitIndex(mask);
+            }
+            aEnd -= TOps::sWidth;
+        }
+        return nullptr;
+    }
+
+    static const unsigned char* findFirstOf(const unsigned char*& aBeg, const unsigned char* aEnd,
+        const unsigned char* aSet, std::size_t aSetLength, bool aMatch) noexcept
+    {
+        typename TOps::TVector set[sMaxSetLength];
+        for (std::size_t i = 0u; i < aSetLength; ++i)
+        {
+            set[i] = TOps::splat(aSet[i]);
+        }
+        const std::uint32_t invert = aMatch ? 0u : TOps::sFullMask;
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            const std::uint32_t mask = matchMask(TOps::load(aBeg), set, aSetLength) ^ invert;
+            if (mask != 0u)
+            {
+                return aBeg + lowestBitIndex(mask);
+            }
+            aBeg += TOps::sWidth;
+        }
+        return nullptr;
+    }
+
+    static const unsigned char* findLastOf(const unsigned char* aBeg, const unsigned char*& aEnd,
+        const unsigned char* aSet, std::size_t aSetLength, bool aMatch) noexcept
+    {
+        typename TOps::TVector set[sMaxSetLength];
+        for (std::size_t i = 0u; i < aSetLength; ++i)
+        {
+            set[i] = TOps::splat(aSet[i]);
+        }
+        const std::uint32_t invert = aMatch ? 0u : TOps::sFullMask;
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            const std::uint32_t mask = matchMask(TOps::load(aEnd - TOps::sWidth), set, aSetLength) ^ invert;
+            if (mask != 0u)
+            {
+                return aEnd - TOps::sWidth + highestBitIndex(mask);
+            }
+            aEnd -= TOps::sWidth;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Find needle (at least 2 characters) filtering candidates by its first and last character.
+     * aLast is the last position where the needle can start + 1.
+     */
+    static const unsigned char* findNeedle(const unsigned char*& aBeg, const unsigned char* aLast,
+        const unsigned char* aNeedle, std::size_t aNeedleLength) noexcept
+    {
+        const auto first = TOps::splat(aNeedle[0]);
+        const auto last = TOps::splat(aNeedle[aNeedleLength - 1u]);
+        while (aLast - aBeg >= TOps::sWidth)
+        {
+            std::uint32_t mask = TOps::movemask(TOps::bitAnd(
+                TOps::cmpeq(TOps::load(aBeg), first),
+                TOps::cmpeq(TOps::load(aBeg + aNeedleLength - 1u), last)));
+            while (mask != 0u)
+            {
+                const unsigned int bit = lowestBitIndex(mask);
+                if (std::memcmp(aBeg + bit + 1u, aNeedle + 1u, aNeedleLength - 2u) == 0)
+                {
+                    return aBeg + bit;
+                }
+                mask &= mask - 1u;
+            }
+            aBeg += TOps::sWidth;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Replace every occurrence of aFrom by aTo: matching bytes are selected from aTo by the comparison mask.
+     */
+    static void replaceChar(unsigned char*& aBeg, unsigned char* aEnd, unsigned char aFrom, unsigned char aTo) noexcept
+    {
+        const auto from = TOps::splat(aFrom);
+        const auto to = TOps::splat(aTo);
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            const auto block = TOps::load(aBeg);
+            const auto mask = TOps::cmpeq(block, from);
+            TOps::store(aBeg, TOps::bitOr(TOps::bitAndNot(mask, block), TOps::bitAnd(mask, to)));
+            aBeg += TOps::sWidth;
+        }
+    }
+
+private:
+
+    static std::uint32_t matchMask(
+        typename TOps::TVector aBlock, const typename TOps::TVector* aSet, std::size_t aSetLength) noexcept
+    {
+        auto matches = TOps::zero();
+        for (std::size_t i = 0u; i < aSetLength; ++i)
+        {
+            matches = TOps::bitOr(matches, TOps::cmpeq(aBlock, aSet[i]));
+        }
+        return TOps::movemask(matches);
+    }
+};
+
+/**
+ * @brief Search kernels that use SIMD for 1 byte characters if available and scalar code otherwise.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+struct CSimdSearch
+{
+    /**
+     * @brief Find the first occurrence of the character.
+     */
+    static const TChar* findChar(const TChar* aBeg, const TChar* aEnd, TChar aChar) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            const unsigned char* beg = toBytes(aBeg);
+            const unsigned char* end = toBytes(aEnd);
+            const unsigned char* found = nullptr;
+#if defined(NSSO_AVX2)
+            found = CByteSearchBlocks<CAvx2Ops>::findChar(beg, end, static_cast<unsigned char>(aChar));
+#endif
+            if (found == nullptr)
+            {
+                found = CByteSearchBlocks<CSse2Ops>::findChar(beg, end, static_cast<unsigned char>(aChar));
+            }
+            if (found != nullptr)
+            {
+                return fromBytes(found);
+            }
+            aBeg = fromBytes(beg);
+        }
+#endif
+        return CScalarSearch<TChar>::findChar(aBeg, aEnd, aChar);
+    }
+
+    /**
+     * @brief Find the last occurrence of the character.
+     */
+    static const TChar* rfindChar(const TChar* aBeg, const TChar* aEnd, TChar aChar) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            const unsigned char* beg = toBytes(aBeg);
+            const unsigned char* end = toBytes(aEnd);
+            const unsigned char* found = nullptr;
+#if defined(NSSO_AVX2)
+            found = CByteSearchBlocks<CAvx2Ops>::rfindChar(beg, end, static_cast<unsigned char>(aChar));
+#endif
+            if (found == nullptr)
+            {
+                found = CByteSearchBlocks<CSse2Ops>::rfindChar(beg, end, static_cast<unsigned char>(aChar));
+            }
+            if (found != nullptr)
+            {
+                return fromBytes(found);
+            }
+            aEnd = fromBytes(end);
+        }
+#endif
+        return CScalarSearch<TChar>::rfindChar(aBeg, aEnd, aChar);
+    }
+
+    /**
+     * @brief Find needle (at least 2 characters). 1 byte characters are filtered by the first and the last
+     * character of needle. aLast is the last position where the needle can start + 1.
+     */
+    static const TChar* findNeedle(
+        const TChar* aBeg, const TChar* aLast, const TChar* aNeedle, std::size_t aNeedleLength) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            const unsigned char* beg = toBytes(aBeg);
+            const unsigned char* last = toBytes(aLast);
+            const unsigned char* needle = toBytes(aNeedle);
+            const unsigned char* found = nullptr;
+#if defined(NSSO_AVX2)
+            found = CByteSearchBlocks<CAvx2Ops>::findNeedle(beg, last, needle, aNeedleLength);
+#endif
+            if (found == nullptr)
+            {
+                found = CByteSearchBlocks<CSse2Ops>::findNeedle(beg, last, needle, aNeedleLength);
+            }
+            if (found != nullptr)
+            {
+                return fromBytes(found);
+            }
+            aBeg = fromBytes(beg);
+        }
+#endif
+        return CScalarSearch<TChar>::findNeedle(aBeg, aLast, aNeedle, aNeedleLength);
+    }
+
+    /**
+     * @brief Find the first character that is (aMatch true) or is not (aMatch false) in the set.
+     */
+    static const TChar* findFirstOf(
+        const TChar* aBeg, const TChar* aEnd, const TChar* aSet, std::size_t aSetLength, bool aMatch) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            if (aSetLength <= CByteSearchBlocks<CSse2Ops>::sMaxSetLength)
+            {
+                const unsigned char* beg = toBytes(aBeg);
+                const unsigned char* end = toBytes(aEnd);
+                const unsigned char* set = toBytes(aSet);
+                const unsigned char* found = nullptr;
+#if defined(NSSO_AVX2)
+                found = CByteSearchBlocks<CAvx2Ops>::findFirstOf(beg, end, set, aSetLength, aMatch);
+#endif
+                if (found == nullptr)
+                {
+                    found = CByteSearchBlocks<CSse2Ops>::findFirstOf(beg, end, set, aSetLength, aMatch);
+                }
+                if (found != nullptr)
+                {
+                    return fromBytes(found);
+                }
+                aBeg = fromBytes(beg);
+            }
+        }
+#endif
+        return CScalarSearch<TChar>::findFirstOf(aBeg, aEnd, aSet, aSetLength, aMatch);
+    }
+
+    /**
+     * @brief Find the last character that is (aMatch true) or is not (aMatch false) in the set.
+     */
+    static const TChar* findLastOf(
+        const TChar* aBeg, const TChar* aEnd, const TChar* aSet, std::size_t aSetLength, bool aMatch) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            if (aSetLength <= CByteSearchBlocks<CSse2Ops>::sMaxSetLength)
+            {
+                const unsigned char* beg = toBytes(aBeg);
+                const unsigned char* end = toBytes(aEnd);
+                const unsigned char* set = toBytes(aSet);
+                const unsigned char* found = nullptr;
+#if defined(NSSO_AVX2)
+                found = CByteSearchBlocks<CAvx2Ops>::findLastOf(beg, end, set, aSetLength, aMatch);
+#endif
+                if (found == nullptr)
+                {
+                    found = CByteSearchBlocks<CSse2Ops>::findLastOf(beg, end, set, aSetLength, aMatch);
+                }
+                if (found != nullptr)
+                {
+                    return fromBytes(found);
+                }
+                aEnd = fromBytes(end);
+            }
+        }
+#endif
+        return CScalarSearch<TChar>::findLastOf(aBeg, aEnd, aSet, aSetLength, aMatch);
+    }
+
+    /**
+     * @brief Replace every occurrence of aFrom by aTo.
+     */
+    static void replaceChar(TChar* aBeg, TChar* aEnd, TChar aFrom, TChar aTo) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u)
+        {
+            unsigned char* beg = reinterpret_cast<unsigned char*>(aBeg);
+            unsigned char* const end = reinterpret_cast<unsigned char*>(aEnd);
+#if defined(NSSO_AVX2)
+            CByteSearchBlocks<CAvx2Ops>::replaceChar(beg, end,
+                static_cast<unsigned char>(aFrom), static_cast<unsigned char>(aTo));
+#endif
+            CByteSearchBlocks<CSse2Ops>::replaceChar(beg, end,
+                static_cast<unsigned char>(aFrom), static_cast<unsigned char>(aTo));
+            aBeg = reinterpret_cast<TChar*>(beg);
+        }
+#endif
+        CScalarSearch<TChar>::replaceChar(aBeg, aEnd, aFrom, aTo);
+    }
+
+    /**
+     * @brief Return number of characters before the null character. Characters of every width (1, 2 and 4 bytes) are
+     * scanned by vectors.
+     */
+    static std::size_t length(const TChar* aTxt) noexcept
+    {
+#if defined(NSSO_SSE2)
+        if constexpr (sizeof(TChar) == 1u || sizeof(TChar) == 2u || sizeof(TChar) == 4u)
+        {
+            // misaligned wide characters would be split between vectors
+            if (reinterpret_cast<std::uintptr_t>(aTxt) % sizeof(TChar) == 0u)
+            {
+#if defined(NSSO_AVX2)
+                return CNullScanBlocks<CAvx2Ops>::length(aTxt);
+#else
+                return CNullScanBlocks<CSse2Ops>::length(aTxt);
+#endif
+            }
+        }
+#endif
+        return std::char_traits<TChar>::length(aTxt);
+    }
+
+private:
+
+    static const unsigned char* toBytes(const TChar* aPtr) noexcept
+    {
+        return reinterpret_cast<const unsigned char*>(aPtr);
+    }
+
+    static const TChar* fromBytes(const unsigned char* aPtr) noexcept
+    {
+        return reinterpret_cast<const TChar*>(aPtr);
+    }
+};
+
+/**
+ * @brief Boyer-Moore-Horspool shift table. Characters are mapped to 256 buckets, wider characters sharing a bucket
+ * get the smallest shift of them, so the search stays correct.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+class CHorspoolTable
+{
+private:
+
+    /**
+     * @brief Shift for each bucket.
+     */
+    std::size_t mShift[256];
+
+    /**
+     * @brief Return bucket of the character.
+     */
+    static std::size_t bucket(TChar aChar) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<std::make_unsigned_t<TChar>>(aChar)) & 0xFFu;
+    }
+
+public:
+
+    /**
+     * @brief Build table for the given needle.
+     *
+     * @param aNeedle Needle.
+     * @param aNeedleLength Length of needle, at least 1.
+     */
+    CHorspoolTable(const TChar* aNeedle, std::size_t aNeedleLength) noexcept
+    {
+        for (auto& shift : mShift)
+        {
+            shift = aNeedleLength;
+        }
+        for (std::size_t i = 0u; i + 1u < aNeedleLength; ++i)
+        {
+            mShift[bucket(aNeedle[i])] = aNeedleLength - 1u - i;
+        }
+    }
+
+    /**
+     * @brief Find needle given to the constructor.
+     *
+     * @param aTxt Text.
+     * @param aLength Length of text.
+     * @param aNeedle Needle.
+     * @param aNeedleLength Length of needle, at least 1.
+     * @param aPos Position where search starts.
+     * @return Index of the found needle or gNpos.
+     */
+    std::size_t find(const TChar* aTxt, std::size_t aLength,
+        const TChar* aNeedle, std::size_t aNeedleLength, std::size_t aPos) const noexcept
+    {
+        if (aPos > aLength || aLength - aPos < aNeedleLength)
+        {
+            return gNpos;
+        }
+        const TChar lastChar = aNeedle[aNeedleLength - 1u];
+        const std::size_t lastStart = aLength - aNeedleLength;
+        while (aPos <= lastStart)
+        {
+            const TChar c = aTxt[aPos + aNeedleLength - 1u];
+            if (c == lastChar && std::char_traits<TChar>::compare(aTxt + aPos, aNeedle, aNeedleLength - 1u) == 0)
+            {
+                return aPos;
+            }
+            aPos += mShift[bucket(c)];
+        }
+        return gNpos;
+    }
+};
+
+/**
+ * @brief Search functions working on [aTxt, aTxt + aLength) with std::string semantics of positions.
+ * They return index of the found character or gNpos.
+ *
+ * @tparam TChar Type of character.
+ * @tparam TKernels Search kernels.
+ */
+template<typename TChar, typename TKernels = CSimdSearch<TChar>>
+struct CStringSearch
+{
+    /**
+     * @brief Needles longer than this are searched by Boyer-Moore-Horspool...
+     */
+    static constexpr std::size_t sLongNeedleLength = 32u;
+
+    /**
+     * @brief ... if at least so many characters are searched.
+     */
+    static constexpr std::size_t sLongTextLength = 4096u;
+
+    /**
+     * @brief std::string::find(char, pos).
+     */
+    static std::size_t find(const TChar* aTxt, std::size_t aLength, TChar aChar, std::size_t aPos) noexcept
+    {
+        if (aPos >= aLength)
+        {
+            return gNpos;
+        }
+        const TChar* end = aTxt + aLength;
+        const TChar* found = TKernels::findChar(aTxt + aPos, end, aChar);
+        return found == end ? gNpos : static_cast<std::size_t>(found - aTxt);
+    }
+
+    /**
+     * @brief std::string::find(str, pos, count).
+     */
+    static std::size_t find(const TChar* aTxt, std::size_t aLength,
+        const TChar* aNeedle, std::size_t aNeedleLength, std::size_t aPos) noexcept
+    {
+        if (aNeedleLength == 0u)
+        {
+            return aPos <= aLength ? aPos : gNpos;
+        }
+        if (aPos >= aLength || aLength - aPos < aNeedleLength)
+        {
+            return gNpos;
+        }
+        if (aNeedleLength == 1u)
+        {
+            return find(aTxt, aLength, aNeedle[0], aPos);
+        }
+        if (aNeedleLength > sLongNeedleLength && aLength - aPos >= sLongTextLength)
+        {
+            // building the table pays off only for long texts
+            return CHorspoolTable<TChar>{aNeedle, aNeedleLength}.find(aTxt, aLength, aNeedle, aNeedleLength, aPos);
+        }
+        return findShort(aTxt, aLength, aNeedle, aNeedleLength, aPos);
+    }
+
+    /**
+     * @brief Find needle (at least 2 characters) using first/last character filter, no precomputed tables.
+     */
+    static std::size_t findShort(const TChar* aTxt, std::size_t aLength,
+        const TChar* aNeedle, std::size_t aNeedleLength, std::size_t aPos) noexcept
+    {
+        // the last position where the needle can start + 1
+        const TChar* last = aTxt + aLength - aNeedleLength + 1u;
+        const TChar* found = TKernels::findNeedle(aTxt + aPos, last, aNeedle, aNeedleLength);
+        return found == last ? gNpos : static_cast<std::size_t>(found - aTxt);
+    }
+
+    /**
+     * @brief std::string::rfind(char, pos).
+     */
+    static std::size_t rfind(const TChar* aTxt, std::size_t aLength, TChar aChar, std::size_t aPos) noexcept
+    {
+        if (aLength == 0u)
+        {
+            return gNpos;
+        }
+        const std::size_t last = aPos < aLength ? aPos : aLength - 1u;
+        const TChar* found = TKernels::rfindChar(aTxt, aTxt + last + 1u, aChar);
+        return found == nullptr ? gNpos : static_cast<std::size_t>(found - aTxt);
+    }
+
+    /**
+     * @brief std::string::rfind(str, pos, count).
+     */
+    static std::size_t rfind(const TChar* aTxt, std::size_t aLength,
+        const TChar* aNeedle, std::size_t aNeedleLength, std::size_t aPos) noexcept
+    {
+        if (aNeedleLength > aLength)
+        {
+            return gNpos;
+        }
+        std::size_t start = aLength - aNeedleLength;
+        if (aPos < start)
+        {
+            start = aPos;
+        }
+        if (aNeedleLength == 0u)
+        {
+            return start;
+        }
+        const TChar* end = aTxt + start + 1u;
+        while (true)
+        {
+            const TChar* found = TKernels::rfindChar(aTxt, end, aNeedle[0]);
+            if (found == nullptr)
+            {
+                return gNpos;
+            }
+            if (std::char_traits<TChar>::compare(found + 1, aNeedle + 1, aNeedleLength - 1u) == 0)
+            {
+                return static_cast<std::size_t>(found - aTxt);
+            }
+            end = found;
+        }
+    }
+
+    /**
+     * @brief std::string::find_first_of (aMatch true) and find_first_not_of (aMatch false).
+     */
+    static std::size_t findFirstOf(const TChar* aTxt, std::size_t aLength,
+        const TChar* aSet, std::size_t aSetLength, std::size_t aPos, bool aMatch) noexcept
+    {
+        if (aPos >= aLength)
+        {
+            return gNpos;
+        }
+        const TChar* end = aTxt + aLength;
+        const TChar* found = aSetLength == 1u && aMatch
+            ? TKernels::findChar(aTxt + aPos, end, aSet[0])
+            : TKernels::findFirstOf(aTxt + aPos, end, aSet, aSetLength, aMatch);
+        return found == end ? gNpos : static_cast<std::size_t>(found - aTxt);
+    }
+
+    /**
+     * @brief std::string::find_last_of (aMatch true) and find_last_not_of (aMatch false).
+     */
+    static std::size_t findLastOf(const TChar* aTxt, std::size_t aLength,
+        const TChar* aSet, std::size_t aSetLength, std::size_t aPos, bool aMatch) noexcept
+    {
+        if (aLength == 0u)
+        {
+            return gNpos;
+        }
+        const std::size_t last = aPos < aLength ? aPos : aLength - 1u;
+        const TChar* end = aTxt + last + 1u;
+        const TChar* found = aSetLength == 1u && aMatch
+            ? TKernels::rfindChar(aTxt, end, aSet[0])
+            : TKernels::findLastOf(aTxt, end, aSet, aSetLength, aMatch);
+        return found == nullptr ? gNpos : static_cast<std::size_t>(found - aTxt);
+    }
+};
+
+} // namespace NSSO
+
+#endif // SEARCH_HPP_
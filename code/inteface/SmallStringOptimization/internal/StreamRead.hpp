@@ -0,0 +1,319 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * Reading lines and words from a stream directly into a string, in bulk from the get area of the stream buffer.
+ */
+
+#ifndef STREAM_READ_HPP_
+#define STREAM_READ_HPP_
+
+#include <climits>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <streambuf>
+#include <string>
+#include "Search.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Access to the get area of any stream buffer. Pointers to protected members are formed through the derived
+ * class, which is allowed, and called on the base class object.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+class CStreamBufAccess : public std::basic_streambuf<TChar>
+{
+    /**
+     * @brief Type of stream buffer.
+     */
+    using TBase = std::basic_streambuf<TChar>;
+
+public:
+    /**
+     * @brief Return the current position of the get area.
+     *
+     * @param aBuffer Stream buffer.
+     * @return Pointer to the next character, nullptr for unbuffered streams.
+     */
+    static TChar* current(TBase& aBuffer) noexcept
+    {
+        return (aBuffer.*(&CStreamBufAccess::gptr))();
+    }
+
+    /**
+     * @brief Return end of the get area.
+     *
+     * @param aBuffer Stream buffer.
+     * @return Pointer after the last available character.
+     */
+    static TChar* end(TBase& aBuffer) noexcept
+    {
+        return (aBuffer.*(&CStreamBufAccess::egptr))();
+    }
+
+    /**
+     * @brief Consume the given number of characters of the get area.
+     *
+     * @param aBuffer Stream buffer.
+     * @param aCount Number of characters, not bigger than end - current.
+     */
+    static void advance(TBase& aBuffer, std::size_t aCount) noexcept
+    {
+        while (aCount != 0u)
+        {
+            const std::size_t step = aCount < static_cast<std::size_t>(INT_MAX) ? aCount : INT_MAX;
+            (aBuffer.*(&CStreamBufAccess::gbump))(static_cast<int>(step));
+            aCount -= step;
+        }
+    }
+};
+
+/**
+ * @brief Functions reading from a stream into CSmallStringOpt or CSimpleString. Characters are copied from the get
+ * area of the stream buffer in chunks directly into the string (memory of string is reused), delimiters are found by
+ * CStringSearch (SIMD for 1 byte characters). Unbuffered streams are read character by character.
+ *
+ * @tparam TChar Type of character.
+ */
+template<typename TChar>
+struct CStreamRead
+{
+    /**
+     * @brief Type of stream.
+     */
+    using TStream = std::basic_istream<TChar>;
+
+    /**
+     * @brief Character traits.
+     */
+    using TTraits = std::char_traits<TChar>;
+
+    /**
+     * @brief Access to get area.
+     */
+    using TAccess = CStreamBufAccess<TChar>;
+
+    /**
+     * @brief Read characters up to the delimiter (extracted, but not stored), like std::getline.
+     *
+     * @tparam TString Type of string.
+     * @param aStream Stream.
+     * @param aString String, its content is replaced.
+     * @param aDelim Delimiter.
+     * @return Stream.
+     */
+    template<typename TString>
+    static TStream& getline(TStream& aStream, TString& aString, TChar aDelim)
+    {
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        std::size_t extracted = 0u;
+        const typename TStream::sentry sentry{aStream, true};
+        if (sentry)
+        {
+            try
+            {
+                clear(aString);
+                auto& buffer = *aStream.rdbuf();
+                for (;;)
+                {
+                    const TChar* const current = TAccess::current(buffer);
+                    const std::size_t available = static_cast<std::size_t>(TAccess::end(buffer) - current);
+                    if (available == 0u)
+                    {
+                        const auto c = buffer.sgetc();
+                        if (TTraits::eq_int_type(c, TTraits::eof()))
+                        {
+                            state |= std::ios_base::eofbit;
+                            break;
+                        }
+                        if (TAccess::current(buffer) == TAccess::end(buffer))
+                        {
+                            // unbuffered stream
+                            buffer.sbumpc();
+                            ++extracted;
+                            if (TTraits::eq(TTraits::to_char_type(c), aDelim))
+                            {
+                                break;
+                            }
+                            const TChar character = TTraits::to_char_type(c);
+                            append(aString, &character, 1u);
+                        }
+                        continue;
+                    }
+                    const std::size_t pos = CStringSearch<TChar>::find(current, available, aDelim, 0u);
+                    const std::size_t count = pos == gNpos ? available : pos;
+                    append(aString, current, count);
+                    const std::size_t consumed = pos == gNpos ? count : count + 1u;
+                    TAccess::advance(buffer, consumed);
+                    extracted += consumed;
+                    if (pos != gNpos)
+                    {
+                        break;
+                    }
+                }
+            }
+            catch (...)
+            {
+                handleException(aStream);
+            }
+        }
+        if (extracted == 0u)
+        {
+            state |= std::ios_base::failbit;
+        }
+        aStream.setstate(state);
+        return aStream;
+    }
+
+    /**
+     * @brief Skip whitespaces and read characters up to the next whitespace or width() characters, like operator>>
+     * of std::basic_string.
+     *
+     * @tparam TString Type of string.
+     * @param aStream Stream.
+     * @param aString String, its content is replaced.
+     * @return Stream.
+     */
+    template<typename TString>
+    static TStream& readWord(TStream& aStream, TString& aString)
+    {
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        std::size_t extracted = 0u;
+        const typename TStream::sentry sentry{aStream, false};
+        if (sentry)
+        {
+            try
+            {
+                clear(aString);
+                const auto& ctype = std::use_facet<std::ctype<TChar>>(aStream.getloc());
+                const std::size_t limit = aStream.width() > 0
+                    ? static_cast<std::size_t>(aStream.width())
+                    : std::numeric_limits<std::size_t>::max();
+                auto& buffer = *aStream.rdbuf();
+                while (extracted < limit)
+                {
+                    const TChar* const current = TAccess::current(buffer);
+                    std::size_t available = static_cast<std::size_t>(TAccess::end(buffer) - current);
+                    if (available == 0u)
+                    {
+                        const auto c = buffer.sgetc();
+                        if (TTraits::eq_int_type(c, TTraits::eof()))
+                        {
+                            state |= std::ios_base::eofbit;
+                            break;
+                        }
+                        if (TAccess::current(buffer) == TAccess::end(buffer))
+                        {
+                            // unbuffered stream
+                            const TChar character = TTraits::to_char_type(c);
+                            if (ctype.is(std::ctype_base::space, character))
+                            {
+                                break;
+                            }
+                            buffer.sbumpc();
+                            ++extracted;
+                            append(aString, &character, 1u);
+                        }
+                        continue;
+                    }
+                    if (available > limit - extracted)
+                    {
+                        available = limit - extracted;
+                    }
+                    const TChar* const space = ctype.scan_is(std::ctype_base::space, current, current + available);
+                    const std::size_t count = static_cast<std::size_t>(space - current);
+                    append(aString, current, count);
+                    TAccess::advance(buffer, count);
+                    extracted += count;
+                    if (count != available)
+                    {
+                        break;
+                    }
+                }
+            }
+            catch (...)
+            {
+                handleException(aStream);
+            }
+        }
+        aStream.width(0);
+        if (extracted == 0u)
+        {
+            state |= std::ios_base::failbit;
+        }
+        aStream.setstate(state);
+        return aStream;
+    }
+
+private:
+    /**
+     * @brief Handle exception thrown during extraction (e.g. std::bad_alloc of the string) like std::getline and
+     * operator>>: badbit is set and the exception is rethrown only if the stream throws on badbit. Called from
+     * a catch block.
+     *
+     * @param aStream Stream.
+     */
+    static void handleException(TStream& aStream)
+    {
+        const std::ios_base::iostate exceptions = aStream.exceptions();
+        // badbit is set without throwing std::ios_base::failure instead of the caught exception
+        aStream.exceptions(std::ios_base::goodbit);
+        aStream.setstate(std::ios_base::badbit);
+        try
+        {
+            aStream.exceptions(exceptions);
+        }
+        catch (const std::ios_base::failure&)
+        {
+        }
+        if ((exceptions & std::ios_base::badbit) != 0)
+        {
+            throw;
+        }
+    }
+
+    /**
+     * @brief Make string empty, keeping its memory.
+     *
+     * @tparam TString Type of string.
+     * @param aString String.
+     */
+    template<typename TString>
+    static void clear(TString& aString)
+    {
+        aString.grow_uninitialized(0u);
+        aString.commit(0u);
+    }
+
+    /**
+     * @brief Append characters, memory of string grows geometrically.
+     *
+     * @tparam TString Type of string.
+     * @param aString String.
+     * @param aTxt Characters.
+     * @param aCount Number of characters.
+     */
+    template<typename TString>
+    static void append(TString& aString, const TChar* aTxt, std::size_t aCount)
+    {
+        if (aCount != 0u)
+        {
+            TChar* const ptr = aString.grow_uninitialized(aCount);
+            TTraits::copy(ptr, aTxt, aCount);
+            aString.commit(aString.size() + aCount);
+        }
+    }
+};
+
+} // namespace NSSO
+
+#endif // STREAM_READ_HPP_
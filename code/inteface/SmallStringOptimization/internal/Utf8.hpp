@@ -0,0 +1,581 @@
+/*
+ * Author: Marcin Serwach
+ * https://github.com/iblis-ms
+ * License: MIT
+ */
+
+/*
+ * UTF-8 kernels: validation, counting code points and finding a prefix of the given number of code points.
+ * Validation classifies pairs of bytes by table lookups (SSSE3/AVX2), counting and prefixes count lead bytes of
+ * whole vectors (SSE2/AVX2). Without SSSE3 validation skips ASCII vectors and checks other code points one by one.
+ */
+
+#ifndef UTF8_HPP_
+#define UTF8_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "Search.hpp"
+
+namespace NSSO
+{
+
+/**
+ * @brief Scalar UTF-8 kernels.
+ */
+struct CScalarUtf8
+{
+    /**
+     * @brief Return length of the valid code point at aBeg.
+     *
+     * @return 1-4 bytes, 0 if the code point is invalid (overlong encoding, surrogate, above U+10FFFF, unexpected
+     * continuation byte) or truncated.
+     */
+    static std::size_t codePointLength(const unsigned char* aBeg, const unsigned char* aEnd) noexcept
+    {
+        const unsigned char lead = aBeg[0];
+        if (lead < 0x80u)
+        {
+            return 1u;
+        }
+        std::size_t length = 0u;
+        unsigned char low = 0x80u;
+        unsigned char high = 0xBFu;
+        if (lead >= 0xC2u && lead <= 0xDFu)
+        {
+            length = 2u;
+        }
+        else if (lead >= 0xE0u && lead <= 0xEFu)
+        {
+            length = 3u;
+            low = lead == 0xE0u ? 0xA0u : 0x80u;
+            high = lead == 0xEDu ? 0x9Fu : 0xBFu;
+        }
+        else if (lead >= 0xF0u && lead <= 0xF4u)
+        {
+            length = 4u;
+            low = lead == 0xF0u ? 0x90u : 0x80u;
+            high = lead == 0xF4u ? 0x8Fu : 0xBFu;
+        }
+        else
+        {
+            return 0u;
+        }
+        if (static_cast<std::size_t>(aEnd - aBeg) < length || aBeg[1] < low || aBeg[1] > high)
+        {
+            return 0u;
+        }
+        for (std::size_t i = 2u; i < length; ++i)
+        {
+            if ((aBeg[i] & 0xC0u) != 0x80u)
+            {
+                return 0u;
+            }
+        }
+        return length;
+    }
+
+    static bool isValid(const unsigned char* aBeg, const unsigned char* aEnd) noexcept
+    {
+        while (aBeg != aEnd)
+        {
+            const std::size_t length = codePointLength(aBeg, aEnd);
+            if (length == 0u)
+            {
+                return false;
+            }
+            aBeg += length;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Count bytes that aren't continuation bytes (10xxxxxx), which is the number of code points of valid UTF-8.
+     */
+    static std::size_t countCodePoints(const unsigned char* aBeg, const unsigned char* aEnd) noexcept
+    {
+        std::size_t count = 0u;
+        for (; aBeg != aEnd; ++aBeg)
+        {
+            count += (*aBeg & 0xC0u) != 0x80u ? 1u : 0u;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Return pointer to the lead byte of the code point after aWidth code points or aEnd.
+     */
+    static const unsigned char* prefixOfWidth(
+        const unsigned char* aBeg, const unsigned char* aEnd, std::size_t aWidth) noexcept
+    {
+        for (; aBeg != aEnd; ++aBeg)
+        {
+            if ((*aBeg & 0xC0u) != 0x80u)
+            {
+                if (aWidth == 0u)
+                {
+                    return aBeg;
+                }
+                --aWidth;
+            }
+        }
+        return aEnd;
+    }
+};
+
+#if defined(NSSO_SSE2)
+/**
+ * @brief SSE2 operations for counting code points.
+ */
+struct CUtf8Sse2Ops : CSse2Ops
+{
+    /**
+     * @brief Return mask of bytes that aren't continuation bytes: signed bytes greater than -65 (0xBF).
+     */
+    static std::uint32_t leadMask(TVector aVec) noexcept
+    {
+        return movemask(_mm_cmpgt_epi8(aVec, _mm_set1_epi8(-65)));
+    }
+};
+#endif
+
+#if defined(NSSO_SSSE3)
+/**
+ * @brief SSSE3 operations for validation.
+ */
+struct CUtf8Ssse3Ops : CUtf8Sse2Ops
+{
+    static TVector table(const std::uint8_t* aTable) noexcept
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(aTable));
+    }
+
+    /**
+     * @brief Return aTable[aIndex] for every byte, aIndex has to be lower than 16.
+     */
+    static TVector lookup(TVector aTable, TVector aIndex) noexcept
+    {
+        return _mm_shuffle_epi8(aTable, aIndex);
+    }
+
+    static TVector high4(TVector aVec) noexcept
+    {
+        return _mm_and_si128(_mm_srli_epi16(aVec, 4), _mm_set1_epi8(0x0F));
+    }
+
+    static TVector bitXor(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm_xor_si128(aVec1, aVec2);
+    }
+
+    static TVector subSaturated(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm_subs_epu8(aVec1, aVec2);
+    }
+
+    /**
+     * @brief Return bytes shifted by TShift positions, the first bytes are taken from the end of the previous vector.
+     */
+    template<int TShift>
+    static TVector prev(TVector aVec, TVector aPrevVec) noexcept
+    {
+        return _mm_alignr_epi8(aVec, aPrevVec, 16 - TShift);
+    }
+
+    /**
+     * @brief Bytes greater than these are lead bytes of code points that continue in the next vector.
+     */
+    static TVector incompleteLimits() noexcept
+    {
+        return _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xEF), static_cast<char>(0xDF), static_cast<char>(0xBF));
+    }
+};
+#endif
+
+#if defined(NSSO_AVX2)
+/**
+ * @brief AVX2 operations for counting code points and validation.
+ */
+struct CUtf8Avx2Ops : CAvx2Ops
+{
+    static std::uint32_t leadMask(TVector aVec) noexcept
+    {
+        return movemask(_mm256_cmpgt_epi8(aVec, _mm256_set1_epi8(-65)));
+    }
+
+    static TVector table(const std::uint8_t* aTable) noexcept
+    {
+        return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(aTable)));
+    }
+
+    static TVector lookup(TVector aTable, TVector aIndex) noexcept
+    {
+        return _mm256_shuffle_epi8(aTable, aIndex);
+    }
+
+    static TVector high4(TVector aVec) noexcept
+    {
+        return _mm256_and_si256(_mm256_srli_epi16(aVec, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    static TVector bitXor(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm256_xor_si256(aVec1, aVec2);
+    }
+
+    static TVector subSaturated(TVector aVec1, TVector aVec2) noexcept
+    {
+        return _mm256_subs_epu8(aVec1, aVec2);
+    }
+
+    template<int TShift>
+    static TVector prev(TVector aVec, TVector aPrevVec) noexcept
+    {
+        // the upper half of the previous vector and the lower half of this one
+        return _mm256_alignr_epi8(aVec, _mm256_permute2x128_si256(aPrevVec, aVec, 0x21), 16 - TShift);
+    }
+
+    static TVector incompleteLimits() noexcept
+    {
+        return _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xEF), static_cast<char>(0xDF), static_cast<char>(0xBF));
+    }
+};
+#endif
+
+/**
+ * @brief UTF-8 kernels on whole vectors. Counting functions process blocks while at least one vector remains and
+ * move the given range, so scalar code can finish the rest.
+ *
+ * @tparam TOps Vector operations.
+ */
+template<typename TOps>
+struct CUtf8Blocks
+{
+    static std::size_t countCodePoints(const unsigned char*& aBeg, const unsigned char* aEnd) noexcept
+    {
+        std::size_t count = 0u;
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            count += popCount(TOps::leadMask(TOps::load(aBeg)));
+            aBeg += TOps::sWidth;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Find the lead byte after aWidth code points, aWidth is decreased by code points of skipped vectors.
+     */
+    static const unsigned char* prefixOfWidth(
+        const unsigned char*& aBeg, const unsigned char* aEnd, std::size_t& aWidth) noexcept
+    {
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            std::uint32_t mask = TOps::leadMask(TOps::load(aBeg));
+            const std::size_t count = popCount(mask);
+            if (count > aWidth)
+            {
+                for (std::size_t i = 0u; i < aWidth; ++i)
+                {
+                    mask &= mask - 1u;
+                }
+                return aBeg + lowestBitIndex(mask);
+            }
+            aWidth -= count;
+            aBeg += TOps::sWidth;
+        }
+        return nullptr;
+    }
+};
+
+#if defined(NSSO_SSSE3)
+/**
+ * @brief UTF-8 validation by classification of pairs of bytes with 3 table lookups (high and low nibble of the
+ * previous byte, high nibble of the current byte). Each bit of the result is an error class, a pair of bytes is
+ * invalid if all 3 lookups have the same bit set. Continuation bytes expected after 3 and 4 byte lead bytes are
+ * checked separately. The tail is copied into a vector padded by zeros.
+ *
+ * @tparam TOps Vector operations.
+ */
+template<typename TOps>
+class CUtf8Validator
+{
+    using TVector = typename TOps::TVector;
+
+    static constexpr std::uint8_t sTooShort = 1u << 0u;     // 11______ 0_______ or 11______ 11______
+    static constexpr std::uint8_t sTooLong = 1u << 1u;      // 0_______ 10______
+    static constexpr std::uint8_t sOverlong3 = 1u << 2u;    // 11100000 100_____
+    static constexpr std::uint8_t sTooLarge = 1u << 3u;     // 11110100 1001____ and greater
+    static constexpr std::uint8_t sSurrogate = 1u << 4u;    // 11101101 101_____
+    static constexpr std::uint8_t sOverlong2 = 1u << 5u;    // 1100000_ 10______
+    static constexpr std::uint8_t sTooLarge1000 = 1u << 6u; // 11110101 1000____ and greater
+    static constexpr std::uint8_t sOverlong4 = 1u << 6u;    // 11110000 1000____
+    static constexpr std::uint8_t sTwoConts = 1u << 7u;     // 10______ 10______
+    static constexpr std::uint8_t sCarry = sTooShort | sTooLong | sTwoConts;
+
+    TVector mError;
+    TVector mPrevInput;
+    TVector mPrevIncomplete;
+
+public:
+    static bool isValid(const unsigned char* aBeg, const unsigned char* aEnd) noexcept
+    {
+        CUtf8Validator validator;
+        while (aEnd - aBeg >= TOps::sWidth)
+        {
+            validator.check(TOps::load(aBeg));
+            aBeg += TOps::sWidth;
+        }
+        if (aBeg != aEnd)
+        {
+            unsigned char tail[TOps::sWidth] = {};
+            std::memcpy(tail, aBeg, static_cast<std::size_t>(aEnd - aBeg));
+            validator.check(TOps::load(tail));
+        }
+        const TVector error = TOps::bitOr(validator.mError, validator.mPrevIncomplete);
+        return TOps::movemask(TOps::cmpeq(error, TOps::zero())) == TOps::sFullMask;
+    }
+
+private:
+    CUtf8Validator() noexcept
+        : mError{TOps::zero()}
+        , mPrevInput{TOps::zero()}
+        , mPrevIncomplete{TOps::zero()}
+    {
+    }
+
+    void check(TVector aInput) noexcept
+    {
+        if (TOps::movemask(aInput) == 0u)
+        {
+            // ASCII vector, only a code point truncated by the end of the previous vector is an error
+            mError = TOps::bitOr(mError, mPrevIncomplete);
+            mPrevIncomplete = TOps::zero();
+        }
+        else
+        {
+            const TVector prev1 = TOps::template prev<1>(aInput, mPrevInput);
+            const TVector special = specialCases(aInput, prev1);
+            mError = TOps::bitOr(mError, multibyteLengths(aInput, special));
+            mPrevIncomplete = TOps::subSaturated(aInput, TOps::incompleteLimits());
+        }
+        mPrevInput = aInput;
+    }
+
+    static TVector specialCases(TVector aInput, TVector aPrev1) noexcept
+    {
+        alignas(16) static constexpr std::uint8_t byte1High[16] = {
+            // 0_______ ________ ASCII
+            sTooLong, sTooLong, sTooLong, sTooLong, sTooLong, sTooLong, sTooLong, sTooLong,
+            // 10______ ________ continuation
+            sTwoConts, sTwoConts, sTwoConts, sTwoConts,
+            // 1100____ ________
+            sTooShort | sOverlong2,
+            // 1101____ ________
+            sTooShort,
+            // 1110____ ________
+            sTooShort | sOverlong3 | sSurrogate,
+            // 1111____ ________
+            sTooShort | sTooLarge | sTooLarge1000 | sOverlong4};
+        alignas(16) static constexpr std::uint8_t byte1Low[16] = {
+            // ____0000 ________
+            sCarry | sOverlong3 | sOverlong2 | sOverlong4,
+            // ____0001 ________
+            sCarry | sOverlong2,
+            // ____001_ ________
+            sCarry, sCarry,
+            // ____0100 ________
+            sCarry | sTooLarge,
+            // ____0101 ________ and greater
+            sCarry | sTooLarge | sTooLarge1000, sCarry | sTooLarge | sTooLarge1000,
+            sCarry | sTooLarge | sTooLarge1000, sCarry | sTooLarge | sTooLarge1000,
+            sCarry | sTooLarge | sTooLarge1000, sCarry | sTooLarge | sTooLarge1000,
+            sCarry | sTooLarge | sTooLarge1000, sCarry | sTooLarge | sTooLarge1000,
+            // ____1101 ________
+            sCarry | sTooLarge | sTooLarge1000 | sSurrogate,
+            sCarry | sTooLarge | sTooLarge1000, sCarry | sTooLarge | sTooLarge1000};
+        alignas(16) static constexpr std::uint8_t byte2High[16] = {
+            // ________ 0_______
+            sTooShort, sTooShort, sTooShort, sTooShort, sTooShort, sTooShort, sTooShort, sTooShort,
+            // ________ 1000____
+            sTooLong | sOverlong2 | sTwoConts | sOverlong3 | sTooLarge1000 | sOverlong4,
+            // ________ 1001____
+            sTooLong | sOverlong2 | sTwoConts | sOverlong3 | sTooLarge,
+            // ________ 101_____
+            sTooLong | sOverlong2 | sTwoConts | sSurrogate | sTooLarge,
+            sTooLong | sOverlong2 | sTwoConts | sSurrogate | sTooLarge,
+            // ________ 11______
+            sTooShort, sTooShort, sTooShort, sTooShort};
+        const TVector prev1Low = TOps::bitAnd(aPrev1, TOps::splat(0x0Fu));
+        return TOps::bitAnd(
+            TOps::bitAnd(
+                TOps::lookup(TOps::table(byte1High), TOps::high4(aPrev1)),
+                TOps::lookup(TOps::table(byte1Low), prev1Low)),
+            TOps::lookup(TOps::table(byte2High), TOps::high4(aInput)));
+    }
+
+    /**
+     * @brief Bytes 2 and 3 positions after 3 and 4 byte lead bytes must be continuation bytes (marked by sTwoConts in
+     * aSpecial), other continuation bytes following continuation bytes are errors.
+     */
+    TVector multibyteLengths(TVector aInput, TVector aSpecial) const noexcept
+    {
+        const TVector prev2 = TOps::template prev<2>(aInput, mPrevInput);
+        const TVector prev3 = TOps::template prev<3>(aInput, mPrevInput);
+        // only 111_____ and 1111____ get the highest bit set
+        const TVector isThird = TOps::subSaturated(prev2, TOps::splat(0xE0u - 0x80u));
+        const TVector isFourth = TOps::subSaturated(prev3, TOps::splat(0xF0u - 0x80u));
+        const TVector must23 = TOps::bitAnd(TOps::bitOr(isThird, isFourth), TOps::splat(0x80u));
+        return TOps::bitXor(must23, aSpecial);
+    }
+};
+#endif
+
+/**
+ * @brief UTF-8 kernels that use SIMD if available and scalar code otherwise.
+ */
+struct CSimdUtf8
+{
+    static bool isValid(const unsigned char* aBeg, const unsigned char* aEnd) noexcept
+    {
+#if defined(NSSO_AVX2)
+        return CUtf8Validator<CUtf8Avx2Ops>::isValid(aBeg, aEnd);
+#elif defined(NSSO_SSSE3)
+        return CUtf8Validator<CUtf8Ssse3Ops>::isValid(aBeg, aEnd);
+#else
+#if defined(NSSO_SSE2)
+        while (aBeg != aEnd)
+        {
+            if (aEnd - aBeg >= CSse2Ops::sWidth && CSse2Ops::movemask(CSse2Ops::load(aBeg)) == 0u)
+            {
+                aBeg += CSse2Ops::sWidth;
+                continue;
+            }
+            const std::size_t length = CScalarUtf8::codePointLength(aBeg, aEnd);
+            if (length == 0u)
+            {
+                return false;
+            }
+            aBeg += length;
+        }
+#endif
+        return CScalarUtf8::isValid(aBeg, aEnd);
+#endif
+    }
+
+    static std::size_t countCodePoints(const unsigned char* aBeg, const unsigned char* aEnd) noexcept
+    {
+        std::size_t count = 0u;
+#if defined(NSSO_AVX2)
+        count += CUtf8Blocks<CUtf8Avx2Ops>::countCodePoints(aBeg, aEnd);
+#endif
+#if defined(NSSO_SSE2)
+        count += CUtf8Blocks<CUtf8Sse2Ops>::countCodePoints(aBeg, aEnd);
+#endif
+        return count + CScalarUtf8::countCodePoints(aBeg, aEnd);
+    }
+
+    static const unsigned char* prefixOfWidth(
+        const unsigned char* aBeg, const unsigned char* aEnd, std::size_t aWidth) noexcept
+    {
+        const unsigned char* found = nullptr;
+#if defined(NSSO_AVX2)
+        found = CUtf8Blocks<CUtf8Avx2Ops>::prefixOfWidth(aBeg, aEnd, aWidth);
+#endif
+#if defined(NSSO_SSE2)
+        if (found == nullptr)
+        {
+            found = CUtf8Blocks<CUtf8Sse2Ops>::prefixOfWidth(aBeg, aEnd, aWidth);
+        }
+#endif
+        return found != nullptr ? found : CScalarUtf8::prefixOfWidth(aBeg, aEnd, aWidth);
+    }
+};
+
+/**
+ * @brief UTF-8 functions of strings of 1 byte characters. Texts shorter than 16 bytes that are all ASCII are handled
+ * inline by 2 word loads, other texts by kernels.
+ *
+ * @tparam TChar Type of character (char, char8_t, signed char or unsigned char).
+ * @tparam TKernels UTF-8 kernels.
+ */
+template<typename TChar, typename TKernels = CSimdUtf8>
+struct CUtf8
+{
+    static_assert(sizeof(TChar) == 1u, "UTF-8 functions need 1 byte characters");
+
+    /**
+     * @brief Check if characters are valid UTF-8: no overlong encodings, surrogates, code points above U+10FFFF,
+     * unexpected continuation bytes or truncated code points.
+     */
+    static bool isValid(const TChar* aTxt, std::size_t aLength) noexcept
+    {
+        return isShortAscii(aTxt, aLength) || TKernels::isValid(toBytes(aTxt), toBytes(aTxt) + aLength);
+    }
+
+    /**
+     * @brief Return number of code points of valid UTF-8 (number of bytes that aren't continuation bytes).
+     */
+    static std::size_t countCodePoints(const TChar* aTxt, std::size_t aLength) noexcept
+    {
+        if (isShortAscii(aTxt, aLength))
+        {
+            return aLength;
+        }
+        return TKernels::countCodePoints(toBytes(aTxt), toBytes(aTxt) + aLength);
+    }
+
+    /**
+     * @brief Return number of characters of the longest prefix of at most aWidth code points, code points aren't split.
+     */
+    static std::size_t prefixOfWidth(const TChar* aTxt, std::size_t aLength, std::size_t aWidth) noexcept
+    {
+        if (aWidth >= aLength)
+        {
+            return aLength;
+        }
+        if (isShortAscii(aTxt, aLength))
+        {
+            return aWidth;
+        }
+        return static_cast<std::size_t>(
+            TKernels::prefixOfWidth(toBytes(aTxt), toBytes(aTxt) + aLength, aWidth) - toBytes(aTxt));
+    }
+
+private:
+
+    static const unsigned char* toBytes(const TChar* aPtr) noexcept
+    {
+        return reinterpret_cast<const unsigned char*>(aPtr);
+    }
+
+    /**
+     * @brief Check if the text is shorter than 16 bytes and all its bytes are ASCII.
+     */
+    static bool isShortAscii(const TChar* aTxt, std::size_t aLength) noexcept
+    {
+        if (aLength >= 2u * sizeof(std::uint64_t))
+        {
+            return false;
+        }
+        std::uint64_t word1 = 0u;
+        std::uint64_t word2 = 0u;
+        if (aLength > sizeof(std::uint64_t))
+        {
+            std::memcpy(&word1, aTxt, sizeof(std::uint64_t));
+            std::memcpy(&word2, aTxt + sizeof(std::uint64_t), aLength - sizeof(std::uint64_t));
+        }
+        else if (aLength != 0u)
+        {
+            std::memcpy(&word1, aTxt, aLength);
+        }
+        return ((word1 | word2) & 0x8080808080808080ull) == 0u;
+    }
+};
+
+} // namespace NSSO
+
+#endif // UTF8_HPP_
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/CountingAllocator.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+
+using namespace NSSO;
+
+TEST(CountingAllocatorTests, allocateDeallocate)
+{
+    CCountingAllocator<char> allocator;
+    const auto start = CAllocationStatistics::instance().snapshot();
+
+    char* ptr = allocator.allocate(100u);
+    auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 1u);
+    ASSERT_EQ(diff.mDeallocations, 0u);
+    ASSERT_EQ(diff.mAllocatedBytes, 100u);
+    ASSERT_EQ(diff.mLiveBytes, 100);
+    ASSERT_EQ(diff.mSizeHistogram[6], 1u);
+
+    allocator.deallocate(ptr, 100u);
+    diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 1u);
+    ASSERT_EQ(diff.mDeallocations, 1u);
+    ASSERT_EQ(diff.mLiveBytes, 0);
+}
+
+TEST(CountingAllocatorTests, nullDeallocateNotCounted)
+{
+    CCountingAllocator<char> allocator;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    allocator.deallocate(nullptr, 0u);
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mDeallocations, 0u);
+}
+
+TEST(CountingAllocatorTests, peak)
+{
+    CCountingAllocator<int> allocator;
+    CAllocationStatistics::instance().resetPeak();
+    const auto start = CAllocationStatistics::instance().snapshot();
+
+    int* ptr1 = allocator.allocate(10u);
+    int* ptr2 = allocator.allocate(20u);
+    allocator.deallocate(ptr1, 10u);
+    allocator.deallocate(ptr2, 20u);
+
+    const auto end = CAllocationStatistics::instance().snapshot();
+    ASSERT_EQ(end.mPeakBytes - start.mLiveBytes, static_cast<std::int64_t>(30u * sizeof(int)));
+    ASSERT_EQ(end.mLiveBytes, start.mLiveBytes);
+}
+
+TEST(CountingAllocatorTests, rebind)
+{
+    CCountingAllocator<char> allocator1;
+    CCountingAllocator<long> allocator2{allocator1};
+    ASSERT_TRUE(allocator1 == allocator2);
+    ASSERT_FALSE(allocator1 != allocator2);
+}
+
+TEST(CountingAllocatorTests, smallStringOpt)
+{
+    using DType = CSmallStringOpt<10u, char, CCountingAllocator<char>>;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    {
+        DType s1{"abc"};
+        auto diff = CAllocationStatistics::instance().snapshot() - start;
+        ASSERT_EQ(diff.mAllocations, 0u);
+
+        DType s2{"abcdefghijklmnop"};
+        diff = CAllocationStatistics::instance().snapshot() - start;
+        ASSERT_EQ(diff.mAllocations, 1u);
+        ASSERT_EQ(diff.mLiveBytes, 17);
+    }
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mDeallocations, 1u);
+    ASSERT_EQ(diff.mLiveBytes, 0);
+}
+
+TEST(CountingAllocatorTests, simpleStringAppend)
+{
+    using DType = CSimpleString<char, CCountingAllocator<char>>;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    {
+        DType s1{"abc"};
+        s1.append("defgh");
+        s1.append("ijklmnop");
+        ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    }
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 3u);
+    ASSERT_EQ(diff.mDeallocations, 3u);
+    ASSERT_EQ(diff.mLiveBytes, 0);
+}
+
+TEST(CountingAllocatorTests, vectorGrowthMovesSmallStringOpt)
+{
+    using DType = CSmallStringOpt<10u, char, CCountingAllocator<char>>;
+    static_assert(std::is_nothrow_move_constructible<DType>::value, "vector has to move strings");
+    std::vector<DType> strings;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (int i = 0; i < 100; ++i)
+    {
+        strings.push_back(DType{i % 2 == 0 ? "abc" : "abcdefghijklmnop"});
+    }
+    // only long strings allocate, reallocation of vector moves them
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 50u);
+    ASSERT_EQ(diff.mDeallocations, 0u);
+    ASSERT_STREQ(strings[98].data(), "abc");
+    ASSERT_STREQ(strings[99].data(), "abcdefghijklmnop");
+}
+
+TEST(CountingAllocatorTests, vectorGrowthMovesSimpleString)
+{
+    using DType = CSimpleString<char, CCountingAllocator<char>>;
+    static_assert(std::is_nothrow_move_constructible<DType>::value, "vector has to move strings");
+    std::vector<DType> strings;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (int i = 0; i < 100; ++i)
+    {
+        strings.push_back(DType{"abcdefghijklmnop"});
+    }
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 100u);
+    ASSERT_EQ(diff.mDeallocations, 0u);
+    ASSERT_STREQ(strings[99].data(), "abcdefghijklmnop");
+}
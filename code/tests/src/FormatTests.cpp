@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/Format.hpp>
+
+#if defined(__cpp_lib_format)
+
+#include <string>
+
+using namespace NSSO;
+
+TEST(FormatTests, formatter)
+{
+    const CSmallStringOpt<20u> s{"abc"};
+    const CSimpleString<char> t{"xyz"};
+    ASSERT_EQ(std::format("[{}|{:>5}|{:.1}]", s, t, s), "[abc|  xyz|a]");
+
+    const CSmallStringOpt<20u, wchar_t> w{L"abc"};
+    ASSERT_EQ(std::format(L"{}", w), L"abc");
+}
+
+TEST(FormatTests, formatToInline)
+{
+    CSmallStringOpt<20u> s{"id="};
+    const char* const before = s.data();
+    NSSO::format_to(s, "{}:{}", 42, "ab");
+    ASSERT_STREQ(s.data(), "id=42:ab");
+    ASSERT_EQ(s.data(), before);
+}
+
+TEST(FormatTests, formatToSpill)
+{
+    CSmallStringOpt<8u> s{"ab"};
+    const std::string longArg(100u, 'x');
+    NSSO::format_to(s, "{}-{}", longArg, 7);
+    ASSERT_EQ(s.size(), 104u);
+    ASSERT_EQ(s[102], '-');
+    ASSERT_EQ(s.data()[104], '\0');
+
+    CSimpleString<char> t;
+    NSSO::format_to(t, "{:>5}", 5);
+    ASSERT_STREQ(t.data(), "    5");
+}
+
+TEST(FormatTests, format)
+{
+    const auto s = NSSO::format<20u>("{} {}", 1.5, true);
+    ASSERT_STREQ(s.data(), "1.5 true");
+    const auto w = NSSO::format<10u>(L"{}", 12);
+    ASSERT_TRUE(w == L"12");
+}
+
+TEST(FormatTests, appender)
+{
+    CSmallStringOpt<8u> s;
+    std::format_to(NSSO::appender(s), "{}{}", "abcdefghij", 1);
+    ASSERT_STREQ(s.data(), "abcdefghij1");
+}
+
+#endif // __cpp_lib_format
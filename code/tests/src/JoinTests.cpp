@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/Join.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+#include <SmallStringOptimization/Split.hpp>
+
+#include <array>
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace NSSO;
+
+TEST(JoinTests, inline)
+{
+    std::vector<CSmallStringOpt<8u>> fields;
+    for (const char* field : {"id", "name", "", "42"})
+    {
+        fields.emplace_back(field);
+    }
+    const auto joined = join<CSmallStringOpt<32u>>(fields, ',');
+    ASSERT_STREQ(joined.data(), "id,name,,42");
+    ASSERT_EQ(joined.capacity(), 32u);
+
+    ASSERT_TRUE(join<CSmallStringOpt<8u>>(std::vector<std::string>{}, ", ").empty());
+    ASSERT_STREQ((join<CSmallStringOpt<8u>>(std::vector<std::string>{"x"}, ", ").data()), "x");
+}
+
+TEST(JoinTests, dynamicMemory)
+{
+    const std::list<std::string> fields{"alpha", "beta", "gamma", "delta", "epsilon"};
+    const auto joined = join<CSmallStringOpt<10u>>(fields, std::string_view{" | "});
+    ASSERT_STREQ(joined.data(), "alpha | beta | gamma | delta | epsilon");
+    ASSERT_EQ(joined.size(), 38u);
+
+    const std::array<std::string_view, 3u> views{"a", "b", "c"};
+    const auto simple = join<CSimpleString<char>>(views, "::");
+    ASSERT_STREQ(simple.data(), "a::b::c");
+}
+
+TEST(JoinTests, appendAndSplit)
+{
+    CSimpleString<char> line{"GET "};
+    const std::vector<CSimpleString<char>> path{CSimpleString<char>{"usr"}, CSimpleString<char>{"local"}};
+    join_to(line, path, '/');
+    ASSERT_STREQ(line.data(), "GET usr/local");
+
+    // split followed by join gives the same text
+    const std::string txt{"k1=v1;k2=v2;;k3"};
+    ASSERT_STREQ((join<CSmallStringOpt<32u>>(split(txt, ';'), ';').data()), txt.c_str());
+}
+
+TEST(JoinTests, wideChars)
+{
+    const std::vector<std::wstring> fields{L"x", L"y"};
+    const auto joined = join<CSmallStringOpt<8u, wchar_t>>(fields, L'\t');
+    ASSERT_TRUE(joined == L"x\ty");
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/MultiMatcher.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NSSO;
+
+namespace
+{
+
+/**
+ * @brief Return all (pattern, position) matches found by std::string::find, sorted.
+ */
+std::vector<std::pair<std::size_t, std::size_t>> naiveFindAll(const std::vector<std::string>& aPatterns,
+    const std::string& aTxt)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> output;
+    for (std::size_t i = 0u; i < aPatterns.size(); ++i)
+    {
+        if (aPatterns[i].empty())
+        {
+            continue;
+        }
+        for (auto pos = aTxt.find(aPatterns[i]); pos != std::string::npos; pos = aTxt.find(aPatterns[i], pos + 1u))
+        {
+            output.emplace_back(i, pos);
+        }
+    }
+    std::sort(output.begin(), output.end());
+    return output;
+}
+
+/**
+ * @brief Convert matches to sorted pairs.
+ */
+std::vector<std::pair<std::size_t, std::size_t>> toPairs(const std::vector<CMultiMatcher<char>::CMatch>& aMatches)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> output;
+    for (const auto& match : aMatches)
+    {
+        output.emplace_back(match.mPattern, match.mPosition);
+    }
+    std::sort(output.begin(), output.end());
+    return output;
+}
+
+} // namespace
+
+TEST(MultiMatcherTests, basic)
+{
+    std::vector<CSmallStringOpt<8>> patterns;
+    for (const char* pattern : {"he", "she", "his", "hers", "", "he"})
+    {
+        patterns.emplace_back(pattern);
+    }
+    const CMultiMatcher<char> matcher{patterns};
+    EXPECT_EQ(6u, matcher.patternCount());
+    EXPECT_EQ(4u, matcher.patternLength(3u));
+
+    const auto matches = matcher.findAll(std::string{"ushers"});
+    ASSERT_EQ(4u, matches.size());
+    // ordered by position of the last character: "she" and both "he" end at 3, "hers" at 5.
+    EXPECT_EQ(1u, matches[0].mPattern);
+    EXPECT_EQ(1u, matches[0].mPosition);
+    EXPECT_EQ(0u, matches[1].mPattern);
+    EXPECT_EQ(2u, matches[1].mPosition);
+    EXPECT_EQ(5u, matches[2].mPattern);
+    EXPECT_EQ(2u, matches[2].mPosition);
+    EXPECT_EQ(3u, matches[3].mPattern);
+    EXPECT_EQ(2u, matches[3].mPosition);
+
+    EXPECT_TRUE(matcher.containsAny(CSimpleString<char>{"this"}));
+    EXPECT_FALSE(matcher.containsAny(CSimpleString<char>{"xyz"}));
+    EXPECT_TRUE(matcher.findAll("", 0u).empty());
+}
+
+TEST(MultiMatcherTests, randomComparedWithFind)
+{
+    std::mt19937 generator{4321u};
+    const auto randomText = [&](std::size_t aLength)
+    {
+        std::string output;
+        for (std::size_t i = 0u; i < aLength; ++i)
+        {
+            output.push_back(static_cast<char>('a' + generator() % 4u));
+        }
+        return output;
+    };
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<std::string> patterns;
+        for (int i = 0; i < 20; ++i)
+        {
+            patterns.push_back(randomText(1u + generator() % 6u));
+        }
+        const CMultiMatcher<char> matcher{patterns};
+        const std::string txt = randomText(200u);
+        const auto expected = naiveFindAll(patterns, txt);
+        EXPECT_EQ(expected, toPairs(matcher.findAll(txt)));
+        EXPECT_EQ(!expected.empty(), matcher.containsAny(txt.data(), txt.size()));
+
+        // the same text split into random chunks.
+        std::vector<CMultiMatcher<char>::CMatch> streamed;
+        CMultiMatcher<char>::CStreamState state;
+        for (std::size_t pos = 0u; pos < txt.size();)
+        {
+            const std::size_t chunk = std::min<std::size_t>(txt.size() - pos, generator() % 7u);
+            matcher.findAll(state, txt.data() + pos, chunk,
+                [&streamed](const CMultiMatcher<char>::CMatch& aMatch) { streamed.push_back(aMatch); });
+            pos += chunk;
+        }
+        EXPECT_EQ(txt.size(), state.position());
+        EXPECT_EQ(expected, toPairs(streamed));
+    }
+}
+
+TEST(MultiMatcherTests, wideChars)
+{
+    const std::vector<std::u32string> patterns{U"ąb", U"bę", U"ę"};
+    const CMultiMatcher<char32_t> matcher{patterns.begin(), patterns.end()};
+    const std::u32string txt = U"xąbęy";
+    std::vector<std::pair<std::size_t, std::size_t>> matches;
+    matcher.findAll(txt, [&matches](const CMultiMatcher<char32_t>::CMatch& aMatch)
+        {
+            matches.emplace_back(aMatch.mPattern, aMatch.mPosition);
+        });
+    const std::vector<std::pair<std::size_t, std::size_t>> expected{{0u, 1u}, {1u, 2u}, {2u, 3u}};
+    EXPECT_EQ(expected, matches);
+}
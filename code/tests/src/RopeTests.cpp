@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/Rope.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/CountingAllocator.hpp>
+
+#include <string>
+
+using namespace NSSO;
+
+namespace
+{
+
+std::string makeText(std::size_t aLength)
+{
+    std::string output;
+    for (std::size_t i = 0u; i < aLength; ++i)
+    {
+        output.push_back(static_cast<char>('a' + (i * 7u) % 26u));
+    }
+    return output;
+}
+
+} // namespace
+
+TEST(RopeTests, defaultValues)
+{
+    const CRope<> rope;
+    ASSERT_EQ(rope.size(), 0u);
+    ASSERT_TRUE(rope.empty());
+    ASSERT_EQ(rope.depth(), 0u);
+    ASSERT_EQ(rope.chunk_begin(), rope.chunk_end());
+    ASSERT_EQ(rope.flatten(), "");
+}
+
+TEST(RopeTests, appendPieces)
+{
+    CRope<> rope;
+    std::string expected;
+    for (int i = 0; i < 5000; ++i)
+    {
+        const std::string piece = std::to_string(i) + ",";
+        rope.append(piece.data(), piece.size());
+        expected += piece;
+    }
+    rope += "end";
+    expected += "end";
+    ASSERT_EQ(rope.size(), expected.size());
+    ASSERT_EQ(rope.flatten(), expected);
+    for (std::size_t i = 0u; i < expected.size(); i += 97u)
+    {
+        ASSERT_EQ(rope[i], expected[i]);
+    }
+    ASSERT_EQ(rope.at(expected.size() - 1u), 'd');
+    ASSERT_THROW(rope.at(expected.size()), std::out_of_range);
+}
+
+TEST(RopeTests, insertErase)
+{
+    CRope<> rope{"abcdef"};
+    rope.insert(3u, "XYZ");
+    ASSERT_EQ(rope.flatten(), "abcXYZdef");
+    rope.insert(0u, "<");
+    rope.insert(rope.size(), ">");
+    ASSERT_EQ(rope.flatten(), "<abcXYZdef>");
+    rope.erase(4u, 3u);
+    ASSERT_EQ(rope.flatten(), "<abcdef>");
+    rope.erase(5u);
+    ASSERT_EQ(rope.flatten(), "<abcd");
+}
+
+TEST(RopeTests, insertMiddleBalanced)
+{
+    CRope<> rope;
+    std::string expected;
+    const std::string text = makeText(100000u);
+    for (std::size_t i = 0u; i < 2000u; ++i)
+    {
+        const std::size_t pos = expected.size() / 2u;
+        const std::size_t length = 1u + i % 50u;
+        rope.insert(pos, text.data() + i, length);
+        expected.insert(pos, text.data() + i, length);
+    }
+    ASSERT_EQ(rope.flatten(), expected);
+    // AVL tree height is below 1.45 * log2(number of leaves)
+    ASSERT_LT(rope.depth(), 30u);
+}
+
+TEST(RopeTests, substrConcat)
+{
+    const std::string text = makeText(20000u);
+    const CRope<> rope{text};
+    ASSERT_EQ(rope.substr(5000u, 7000u).flatten(), text.substr(5000u, 7000u));
+    ASSERT_EQ(rope.substr(19990u).flatten(), text.substr(19990u));
+
+    const CRope<> concatenated = rope.substr(10000u) + rope.substr(0u, 10000u);
+    ASSERT_EQ(concatenated.flatten(), text.substr(10000u) + text.substr(0u, 10000u));
+    ASSERT_TRUE(rope.substr(0u, 100u) == CRope<>(text.substr(0u, 100u)));
+    ASSERT_TRUE(rope != concatenated);
+}
+
+TEST(RopeTests, chunkIterator)
+{
+    const std::string text = makeText(10000u);
+    CRope<> rope{text};
+    rope.append("tail", 4u);
+    std::string output;
+    std::size_t chunks = 0u;
+    for (auto it = rope.chunk_begin(); it != rope.chunk_end(); ++it)
+    {
+        output.append(it->data(), it->size());
+        ++chunks;
+    }
+    ASSERT_EQ(output, text + "tail");
+    ASSERT_GT(chunks, 1u);
+}
+
+TEST(RopeTests, smallStringOptChunks)
+{
+    CRope<char, CSmallStringOpt<32u>> rope{"abc"};
+    rope.insert(1u, "123");
+    const auto flat = rope.flatten<CSmallStringOpt<8u>>();
+    ASSERT_STREQ(flat.data(), "a123bc");
+}
+
+TEST(RopeTests, flattenSizedOnce)
+{
+    using DString = CSmallStringOpt<16u, char, CCountingAllocator<char>>;
+    const std::string text = makeText(20000u);
+    CRope<char, CSmallStringOpt<32u>> rope{text};
+    rope.append("tail");
+    const auto start = CAllocationStatistics::instance().snapshot();
+    const DString flat = rope.flatten<DString>();
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 1u);
+    ASSERT_EQ(std::string(flat.data(), flat.size()), text + "tail");
+    ASSERT_EQ(rope.flatten<CSimpleString<char>>().size(), text.size() + 4u);
+    ASSERT_EQ(rope.flatten(), text + "tail");
+    ASSERT_EQ(CRope<>{}.flatten<DString>().size(), 0u);
+}
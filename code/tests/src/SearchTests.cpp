@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NSSO;
+
+namespace
+{
+
+/**
+ * @brief Compare all search functions of the given kernels with std::string on random texts of small alphabet.
+ */
+template<typename TKernels>
+void compareWithStdString()
+{
+    using TSearch = CStringSearch<char, TKernels>;
+    std::mt19937 generator{1234u};
+    const std::string alphabet = "abcdefgh";
+    const auto randomText = [&](std::size_t aLength)
+    {
+        std::string output;
+        for (std::size_t i = 0u; i < aLength; ++i)
+        {
+            output.push_back(alphabet[generator() % alphabet.size()]);
+        }
+        return output;
+    };
+    for (std::size_t length = 0u; length < 100u; ++length)
+    {
+        const std::string txt = randomText(length);
+        for (std::size_t needleLength = 0u; needleLength < 4u; ++needleLength)
+        {
+            const std::string needle = randomText(needleLength);
+            std::string set = randomText(needleLength * 2u);
+            for (std::size_t pos : {std::size_t{0u}, length / 3u, length / 2u, length, std::string::npos})
+            {
+                const char* t = txt.data();
+                ASSERT_EQ(TSearch::find(t, length, needle.data(), needleLength, pos), txt.find(needle, pos));
+                ASSERT_EQ(TSearch::rfind(t, length, needle.data(), needleLength, pos), txt.rfind(needle, pos));
+                ASSERT_EQ(TSearch::find(t, length, 'h', pos), txt.find('h', pos));
+                ASSERT_EQ(TSearch::rfind(t, length, 'h', pos), txt.rfind('h', pos));
+                ASSERT_EQ(TSearch::findFirstOf(t, length, set.data(), set.size(), pos, true), txt.find_first_of(set, pos));
+                ASSERT_EQ(TSearch::findFirstOf(t, length, set.data(), set.size(), pos, false), txt.find_first_not_of(set, pos));
+                ASSERT_EQ(TSearch::findLastOf(t, length, set.data(), set.size(), pos, true), txt.find_last_of(set, pos));
+                ASSERT_EQ(TSearch::findLastOf(t, length, set.data(), set.size(), pos, false), txt.find_last_not_of(set, pos));
+            }
+        }
+        // big set uses table in scalar code and falls back from SIMD
+        const std::string bigSet = "abcdefghijklmnopqrstu";
+        ASSERT_EQ(TSearch::findFirstOf(txt.data(), length, bigSet.data(), bigSet.size(), 0u, false), txt.find_first_not_of(bigSet));
+        ASSERT_EQ(TSearch::findLastOf(txt.data(), length, bigSet.data(), bigSet.size(), gNpos, true), txt.find_last_of(bigSet));
+    }
+}
+
+} // namespace
+
+TEST(SearchTests, scalarKernels)
+{
+    compareWithStdString<CScalarSearch<char>>();
+}
+
+TEST(SearchTests, simdKernels)
+{
+    compareWithStdString<CSimdSearch<char>>();
+}
+
+TEST(SearchTests, smallStringOpt)
+{
+    const CSmallStringOpt<10u> s1{"key=value; other=1"};
+    ASSERT_EQ(s1.find('='), 3u);
+    ASSERT_EQ(s1.find('=', 4u), 16u);
+    ASSERT_EQ(s1.find("other"), 11u);
+    ASSERT_EQ(s1.find(std::string{"value"}), 4u);
+    ASSERT_EQ(s1.find(CSmallStringOpt<4u>{"1"}), 17u);
+    ASSERT_EQ(s1.find('x'), CSmallStringOpt<10u>::npos);
+    ASSERT_EQ(s1.rfind('='), 16u);
+    ASSERT_EQ(s1.rfind("e", 5u), 1u);
+    ASSERT_EQ(s1.find_first_of(";="), 3u);
+    ASSERT_EQ(s1.find_first_not_of("kye"), 3u);
+    ASSERT_EQ(s1.find_last_of(";="), 16u);
+    ASSERT_EQ(s1.find_last_not_of("1="), 15u);
+    ASSERT_EQ(s1.find_last_not_of('1'), 16u);
+
+    const CSmallStringOpt<10u> s2{"a b"};
+    ASSERT_EQ(s2.find(' '), 1u);
+    ASSERT_EQ(s2.find(""), 0u);
+    ASSERT_EQ(s2.find("", 3u), 3u);
+    ASSERT_EQ(s2.find("", 4u), CSmallStringOpt<10u>::npos);
+}
+
+TEST(SearchTests, simpleString)
+{
+    const CSimpleString<> s1{"key=value; other=1"};
+    ASSERT_EQ(s1.find('='), 3u);
+    ASSERT_EQ(s1.find("other"), 11u);
+    ASSERT_EQ(s1.rfind('='), 16u);
+    ASSERT_EQ(s1.find_first_of(";="), 3u);
+    ASSERT_EQ(s1.find_last_not_of("1="), 15u);
+
+    const CSimpleString<> empty;
+    ASSERT_EQ(empty.find('a'), CSimpleString<>::npos);
+    ASSERT_EQ(empty.rfind("a"), CSimpleString<>::npos);
+    ASSERT_EQ(empty.find_last_of("a"), CSimpleString<>::npos);
+}
+
+TEST(SearchTests, longNeedles)
+{
+    std::mt19937 generator{42u};
+    std::string txt;
+    for (std::size_t i = 0u; i < 20000u; ++i)
+    {
+        txt.push_back(static_cast<char>('a' + generator() % 3u));
+    }
+    for (std::size_t needleLength : {2u, 5u, 16u, 31u, 33u, 64u, 200u})
+    {
+        for (std::size_t start : {std::size_t{0u}, std::size_t{7777u}, txt.size() - needleLength})
+        {
+            const std::string needle = txt.substr(start, needleLength);
+            const CSearcher<> searcher{needle};
+            for (std::size_t pos : {std::size_t{0u}, std::size_t{5000u}, start, start + 1u})
+            {
+                const std::size_t expected = txt.find(needle, pos);
+                ASSERT_EQ((CStringSearch<char>::find(txt.data(), txt.size(), needle.data(), needle.size(), pos)), expected);
+                ASSERT_EQ((CStringSearch<char, CScalarSearch<char>>::find(txt.data(), txt.size(), needle.data(), needle.size(), pos)), expected);
+                ASSERT_EQ(searcher.find(txt, pos), expected);
+            }
+        }
+    }
+    const CSearcher<> missing{std::string(40u, 'd')};
+    ASSERT_EQ(missing.find(txt), gNpos);
+}
+
+TEST(SearchTests, searcherWideChars)
+{
+    // characters 0x161 and 0x61 share a bucket of shift table
+    std::wstring txt;
+    for (int i = 0; i < 5000; ++i)
+    {
+        txt.push_back(static_cast<wchar_t>(i % 2 == 0 ? 0x161 : 0x61 + i % 5));
+    }
+    const std::wstring needle = txt.substr(3001u, 50u);
+    const CSearcher<wchar_t> searcher{needle};
+    ASSERT_EQ(searcher.find(txt), txt.find(needle));
+    ASSERT_EQ(searcher.find(txt, 1000u), txt.find(needle, 1000u));
+}
+
+TEST(SearchTests, searcherMembers)
+{
+    const CSearcher<> searcher{"needle"};
+    const CSimpleString<> s1{"haystack with a needle inside"};
+    ASSERT_EQ(s1.find(searcher), 16u);
+    ASSERT_EQ(s1.find(searcher, 17u), CSimpleString<>::npos);
+    const CSmallStringOpt<10u> s2{"needle"};
+    ASSERT_EQ(s2.find(searcher), 0u);
+}
+
+namespace
+{
+
+/**
+ * @brief Check length of texts at every alignment and of every length up to a few vectors, so the null character is
+ * found in the first, a middle and the last lane of aligned vectors.
+ */
+template<typename TChar>
+void checkLength()
+{
+    std::vector<TChar> buffer(200u, static_cast<TChar>(0x7A));
+    for (std::size_t start = 0u; start < 40u; ++start)
+    {
+        for (std::size_t length = 0u; length < 100u; ++length)
+        {
+            buffer[start + length] = TChar{};
+            ASSERT_EQ(CSimdSearch<TChar>::length(buffer.data() + start), length);
+            ASSERT_EQ(txtLength(buffer.data() + start), length);
+            buffer[start + length] = static_cast<TChar>(0x7A);
+        }
+    }
+    // characters whose bytes are zero, but the characters aren't
+    std::vector<TChar> highBytes(50u, static_cast<TChar>(sizeof(TChar) == 1u ? 0x80 : 0x100));
+    highBytes[33] = TChar{};
+    ASSERT_EQ(txtLength(highBytes.data()), 33u);
+}
+
+} // namespace
+
+TEST(SearchTests, lengthEveryWidth)
+{
+    checkLength<char>();
+    checkLength<wchar_t>();
+    checkLength<char16_t>();
+    checkLength<char32_t>();
+#if defined(__cpp_char8_t)
+    checkLength<char8_t>();
+#endif
+}
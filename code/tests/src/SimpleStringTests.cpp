@@ -796,3 +796,118 @@ TEST(SimpleStringTests, less)
     
 }
 
+
+TEST(SimpleStringTests, growUninitialized)
+{
+    CSimpleString<> s;
+    for (int i = 0; i < 100; ++i)
+    {
+        char* ptr = s.grow_uninitialized(1u);
+        *ptr = static_cast<char>('a' + i % 26);
+        s.commit(s.size() + 1u);
+    }
+    ASSERT_EQ(s.size(), 100u);
+    ASSERT_EQ(s[99], 'v');
+    ASSERT_EQ(s.data()[100], '\0');
+
+    s.resize_and_overwrite(3u, [](char* aBuf, std::size_t)
+        {
+            aBuf[2] = 'Z';
+            return std::size_t{3u};
+        });
+    ASSERT_STREQ(s.data(), "abZ");
+}
+
+TEST(SimpleStringTests, insertEraseReplace)
+{
+    CSimpleString<> s;
+    s.clear();
+    s.erase();
+    ASSERT_STREQ(s.data(), "");
+    s.insert(0u, "abef");
+    s.insert(2u, std::string{"cd"});
+    ASSERT_STREQ(s.data(), "abcdef");
+    s.insert(1u, s);
+    ASSERT_STREQ(s.data(), "aabcdefbcdef");
+    s.replace(1u, 6u, 2u, 'x');
+    ASSERT_STREQ(s.data(), "axxbcdef");
+    s.erase(3u, 2u);
+    ASSERT_STREQ(s.data(), "axxdef");
+    s.push_back('g');
+    s += 'h';
+    s.pop_back();
+    ASSERT_STREQ(s.data(), "axxdefg");
+    s.resize(9u, '.');
+    ASSERT_STREQ(s.data(), "axxdefg..");
+    const std::size_t capacity = s.capacity();
+    s.clear();
+    ASSERT_TRUE(s.empty());
+    ASSERT_EQ(s.capacity(), capacity);
+}
+
+TEST(SimpleStringTests, replaceAll)
+{
+    CSimpleString<> s;
+    s.replace_all('a', 'b');
+    s.replace_all("a", "bb");
+    ASSERT_TRUE(s.empty());
+
+    s.assign("{name} is {name}");
+    s.replace_all("{name}", "Tadeusz");
+    ASSERT_STREQ(s.data(), "Tadeusz is Tadeusz");
+    s.replace_all(' ', '_');
+    ASSERT_STREQ(s.data(), "Tadeusz_is_Tadeusz");
+    s.replace_all(std::string{"Tadeusz"}, std::string{"T"});
+    ASSERT_STREQ(s.data(), "T_is_T");
+    ASSERT_EQ(s.size(), 6u);
+}
+
+TEST(SimpleStringTests, nothrowMove)
+{
+    using DType = CSimpleString<char>;
+    static_assert(std::is_nothrow_move_constructible<DType>::value, "");
+    static_assert(std::is_nothrow_move_assignable<DType>::value, "");
+
+    DType s1{"abcdefghijklmnop"};
+    const char* const ptr = s1.data();
+    DType s2{std::move(s1)};
+    ASSERT_EQ(s2.data(), ptr);
+    ASSERT_TRUE(s1.empty());
+
+    DType s3{"abc"};
+    s3 = std::move(s2);
+    ASSERT_EQ(s3.data(), ptr);
+    ASSERT_STREQ(s3.data(), "abcdefghijklmnop");
+}
+
+TEST(SimpleStringTests, swap)
+{
+    using DType = CSimpleString<char>;
+    static_assert(noexcept(std::declval<DType&>().swap(std::declval<DType&>())), "");
+
+    DType s1{"abc"};
+    DType s2{"abcdefghijklmnop"};
+    const char* const ptr1 = s1.data();
+    const char* const ptr2 = s2.data();
+    swap(s1, s2);
+    ASSERT_EQ(s1.data(), ptr2);
+    ASSERT_EQ(s2.data(), ptr1);
+    ASSERT_EQ(s1.size(), 16u);
+    ASSERT_STREQ(s2.data(), "abc");
+}
+
+TEST(SimpleStringTests, wideCharacters)
+{
+    CSimpleString<char16_t> s1{u"zażółć"};
+    s1 += u" gęślą";
+    s1.append(u" jaźń");
+    ASSERT_EQ(s1.size(), 17u);
+    ASSERT_TRUE(s1 == u"zażółć gęślą jaźń");
+    ASSERT_EQ(s1.find(u"jaźń"), 13u);
+    s1 = u"abc";
+    ASSERT_TRUE(s1 == u"abc");
+
+    const CSimpleString<char32_t> s2{U"żółw🐢"};
+    ASSERT_EQ(s2.size(), 5u);
+    ASSERT_EQ(s2.find(U'🐢'), 4u);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <SmallStringOptimization/SmallStringOptimization.hpp>
 
+#include <map>
+
 using namespace NSSO;
 
 namespace std
@@ -797,3 +799,675 @@ TEST(SmallStringOptimizationTests, less)
     c2(a, b);
     
 }
+
+TEST(SmallStringOptimizationTests, reserveAppend)
+{
+    CSmallStringOpt<10u> s1{"abc"};
+    s1.reserve(30u);
+    ASSERT_STREQ(s1.data(), "abc");
+    s1.append("defghijklmnop");
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_EQ(s1.capacity(), 30u);
+}
+
+TEST(SmallStringOptimizationTests, appendAfterShortAssign)
+{
+    CSmallStringOpt<10u> s1{"abcdefghijklmnop"};
+    s1.assign("xyz");
+    ASSERT_STREQ(s1.data(), "xyz");
+    s1.append("0123456789");
+    ASSERT_STREQ(s1.data(), "xyz0123456789");
+}
+
+TEST(SmallStringOptimizationTests, copySmallerArray)
+{
+    const CSmallStringOpt<4u> s1{"abcdefghij"};
+    const CSmallStringOpt<20u> s2{s1};
+    ASSERT_STREQ(s2.data(), "abcdefghij");
+    ASSERT_EQ(s2.size(), 10u);
+}
+
+TEST(SmallStringOptimizationTests, moveBiggerArray)
+{
+    CSmallStringOpt<20u> s1{"abcdefghij"};
+    CSmallStringOpt<4u> s2{std::move(s1)};
+    ASSERT_STREQ(s2.data(), "abcdefghij");
+    ASSERT_EQ(s2.size(), 10u);
+}
+
+using TCowString = CSmallStringOpt<10u, char, std::allocator<char>, CCopyOnWritePolicy>;
+
+TEST(SmallStringOptimizationTests, copyOnWriteShare)
+{
+    const TCowString s1{"abcdefghijklmnop"};
+    const TCowString s2{s1};
+    ASSERT_EQ(s1.data(), s2.data());
+    TCowString s3;
+    s3 = s2;
+    ASSERT_EQ(s1.data(), s3.data());
+    ASSERT_STREQ(s3.data(), "abcdefghijklmnop");
+}
+
+TEST(SmallStringOptimizationTests, copyOnWriteInline)
+{
+    const TCowString s1{"abc"};
+    const TCowString s2{s1};
+    ASSERT_NE(s1.data(), s2.data());
+    ASSERT_STREQ(s2.data(), "abc");
+}
+
+TEST(SmallStringOptimizationTests, copyOnWriteAppend)
+{
+    const TCowString s1{"abcdefghijklmnop"};
+    TCowString s2{s1};
+    s2.append("qrs");
+    ASSERT_NE(s1.data(), s2.data());
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(s2.data(), "abcdefghijklmnopqrs");
+
+    TCowString s3{s1};
+    s3.assign("xyz");
+    s3.append("0123456789");
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(s3.data(), "xyz0123456789");
+}
+
+TEST(SmallStringOptimizationTests, copyOnWriteNonConstAccess)
+{
+    const TCowString s1{"abcdefghijklmnop"};
+    TCowString s2{s1};
+    char& c = s2[0];
+    ASSERT_NE(s1.data(), s2.data());
+    // reference was returned, so the next copy cannot share memory
+    const TCowString s3{s2};
+    ASSERT_NE(s2.data(), s3.data());
+    c = 'X';
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(s2.data(), "Xbcdefghijklmnop");
+    ASSERT_STREQ(s3.data(), "abcdefghijklmnop");
+}
+
+TEST(SmallStringOptimizationTests, copyOnWriteShareAfterModification)
+{
+    TCowString s1{"abcdefghijklmnop"};
+    s1[0] = 'X';
+    // assignment reuses dynamic memory and invalidates the reference, so memory can be shared again
+    s1.assign("0123456789abcdef");
+    const TCowString s2{s1};
+    ASSERT_EQ(s1.data(), s2.data());
+
+    TCowString s3{"abcdefghijklmnop"};
+    for (char& c : s3)
+    {
+        c = static_cast<char>(c - 'a' + 'A');
+    }
+    s3.append("Q");
+    const TCowString s4{s3};
+    ASSERT_EQ(s3.data(), s4.data());
+    ASSERT_STREQ(s4.data(), "ABCDEFGHIJKLMNOPQ");
+
+    s3.erase(12u);
+    TCowString s5;
+    s5 = s3;
+    ASSERT_EQ(s3.data(), s5.data());
+    ASSERT_STREQ(s5.data(), "ABCDEFGHIJKL");
+}
+
+TEST(SmallStringOptimizationTests, copyOnWriteGrowUninitialized)
+{
+    const TCowString s1{"abcdefghijklmnop"};
+    TCowString s2{s1};
+    char* ptr = s2.grow_uninitialized(2u);
+    ptr[0] = 'q';
+    ptr[1] = 'r';
+    s2.commit(s2.size() + 2u);
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(s2.data(), "abcdefghijklmnopqr");
+}
+
+TEST(SmallStringOptimizationTests, growUninitialized)
+{
+    CSmallStringOpt<10u> s{"abc"};
+    char* ptr = s.grow_uninitialized(3u);
+    ASSERT_EQ(s.data() + 3, ptr);
+    ASSERT_EQ(s.size(), 3u);
+    ptr[0] = 'd';
+    ptr[1] = 'e';
+    s.commit(5u);
+    ASSERT_STREQ(s.data(), "abcde");
+
+    // spill to dynamic memory
+    ptr = s.grow_uninitialized(21u);
+    for (char c = 'f'; c <= 'z'; ++c)
+    {
+        *ptr++ = c;
+    }
+    s.commit(26u);
+    ASSERT_STREQ(s.data(), "abcdefghijklmnopqrstuvwxyz");
+    ASSERT_GE(s.capacity(), 27u);
+
+    // reserved memory is used without reallocation
+    CSmallStringOpt<4u> r{"ab"};
+    r.reserve(100u);
+    ptr = r.grow_uninitialized(50u);
+    ptr[0] = 'c';
+    r.commit(3u);
+    ASSERT_STREQ(r.data(), "abc");
+    ASSERT_EQ(r.capacity(), 100u);
+}
+
+TEST(SmallStringOptimizationTests, resizeAndOverwrite)
+{
+    CSmallStringOpt<10u> s{"abc"};
+    s.resize_and_overwrite(30u, [](char* aBuf, std::size_t aCount)
+        {
+            EXPECT_EQ(aBuf[0], 'a');
+            for (std::size_t i = 3u; i < aCount; ++i)
+            {
+                aBuf[i] = 'x';
+            }
+            return std::size_t{20u};
+        });
+    ASSERT_EQ(s.size(), 20u);
+    ASSERT_STREQ(s.data(), "abcxxxxxxxxxxxxxxxxx");
+
+    s.resize_and_overwrite(2u, [](char* aBuf, std::size_t aCount)
+        {
+            aBuf[1] = 'B';
+            return aCount;
+        });
+    ASSERT_STREQ(s.data(), "aB");
+}
+
+TEST(SmallStringOptimizationTests, appendNumber)
+{
+    CSmallStringOpt<20u> s{"user:"};
+    s.append_number(12345);
+    ASSERT_STREQ(s.data(), "user:12345");
+    s += -7;
+    ASSERT_STREQ(s.data(), "user:12345-7");
+    s.append_number(255u, 16);
+    ASSERT_STREQ(s.data(), "user:12345-7ff");
+
+    // doesn't fit into the small string optimization array any more
+    s.append_number(std::numeric_limits<long long>::min());
+    ASSERT_STREQ(s.data(), "user:12345-7ff-9223372036854775808");
+    ASSERT_EQ(s.size(), 34u);
+    s.append_number(0);
+    ASSERT_STREQ(s.data(), "user:12345-7ff-92233720368547758080");
+
+    CSmallStringOpt<20u> f;
+    f += 0.5;
+    f.append_number(1.25, std::chars_format::fixed, 3);
+    ASSERT_STREQ(f.data(), "0.51.250");
+
+    CSmallStringOpt<20u> big;
+    big.append_number(1e300, std::chars_format::fixed);
+    ASSERT_EQ(big.size(), 301u);
+    ASSERT_EQ(big[0], '1');
+    ASSERT_EQ(big.data()[301], '\0');
+
+    CSmallStringOpt<10u, wchar_t> w{L"id="};
+    w += 42;
+    ASSERT_TRUE(w == L"id=42");
+}
+
+TEST(SmallStringOptimizationTests, insertEraseReplace)
+{
+    CSmallStringOpt<10u> s{"abef"};
+    const char* const inlineData = s.data();
+    s.insert(2u, "cd");
+    ASSERT_STREQ(s.data(), "abcdef");
+    s.insert(100u, std::string{"g"});
+    s.insert(0u, 2u, '_');
+    ASSERT_STREQ(s.data(), "__abcdefg");
+    ASSERT_EQ(s.data(), inlineData);
+
+    // crosses the small string optimization length
+    s.replace(2u, 3u, "ABCDEFGH");
+    ASSERT_STREQ(s.data(), "__ABCDEFGHdefg");
+    ASSERT_NE(s.data(), inlineData);
+    s.erase(0u, 2u);
+    ASSERT_STREQ(s.data(), "ABCDEFGHdefg");
+    s.erase(8u);
+    ASSERT_STREQ(s.data(), "ABCDEFGH");
+    // the default policy keeps dynamic memory
+    ASSERT_NE(s.data(), inlineData);
+    ASSERT_GE(s.capacity(), 15u);
+    s.replace(1u, 100u, 3u, 'x');
+    ASSERT_STREQ(s.data(), "Axxx");
+
+    s.push_back('y');
+    s += 'z';
+    ASSERT_STREQ(s.data(), "Axxxyz");
+    s.pop_back();
+    ASSERT_STREQ(s.data(), "Axxxy");
+    s.resize(7u, '-');
+    ASSERT_STREQ(s.data(), "Axxxy--");
+    s.resize(1u);
+    ASSERT_STREQ(s.data(), "A");
+    s.clear();
+    ASSERT_TRUE(s.empty());
+    ASSERT_STREQ(s.data(), "");
+    s.pop_back();
+    ASSERT_TRUE(s.empty());
+}
+
+TEST(SmallStringOptimizationTests, appendAfterErase)
+{
+    CSmallStringOpt<10u> s{"0123456789abcdef"};
+    s.erase(2u);
+    // characters stay in dynamic memory
+    s.append("xy");
+    ASSERT_STREQ(s.data(), "01xy");
+    s += "z";
+    ASSERT_EQ(s.size(), 5u);
+    ASSERT_STREQ(s.data(), "01xyz");
+}
+
+TEST(SmallStringOptimizationTests, insertFromItself)
+{
+    CSmallStringOpt<10u> s{"abcd"};
+    s.insert(1u, s);
+    ASSERT_STREQ(s.data(), "aabcdbcd");
+    s.replace(0u, 1u, s.data() + 4u, 4u);
+    ASSERT_STREQ(s.data(), "dbcdabcdbcd");
+    s.insert(3u, s.data(), 6u);
+    ASSERT_STREQ(s.data(), "dbcdbcdabdabcdbcd");
+}
+
+TEST(SmallStringOptimizationTests, compactPolicyReleasesMemory)
+{
+    using TCompactString = CSmallStringOpt<10u, char, std::allocator<char>, CCompactStringPolicy>;
+    TCompactString s{"0123456789abcdef"};
+    const TCompactString inlineString;
+    s.erase(3u);
+    ASSERT_STREQ(s.data(), "012");
+    ASSERT_EQ(s.capacity(), inlineString.capacity());
+    const char* const ptr = s.data();
+    ASSERT_TRUE(ptr >= reinterpret_cast<const char*>(&s) && ptr < reinterpret_cast<const char*>(&s + 1));
+}
+
+TEST(SmallStringOptimizationTests, copyOnWriteErase)
+{
+    const TCowString s1{"abcdefghijklmnop"};
+    TCowString s2{s1};
+    s2.erase(1u, 10u);
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(s2.data(), "almnop");
+
+    TCowString s3{s1};
+    s3.insert(0u, "0123");
+    ASSERT_STREQ(s1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(s3.data(), "0123abcdefghijklmnop");
+}
+
+TEST(SmallStringOptimizationTests, editComparedWithStdString)
+{
+    std::string expected;
+    CSmallStringOpt<16u> s;
+    unsigned int seed = 7u;
+    const auto next = [&seed](unsigned int aMax)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16u) % aMax;
+    };
+    for (int i = 0; i < 2000; ++i)
+    {
+        const std::size_t pos = next(static_cast<unsigned int>(expected.size() + 1u));
+        const std::size_t count = next(6u);
+        const std::string txt(next(8u), static_cast<char>('a' + i % 26));
+        switch (next(4u))
+        {
+        case 0u:
+            expected.insert(pos, txt);
+            s.insert(pos, txt);
+            break;
+        case 1u:
+            expected.erase(pos, count);
+            s.erase(pos, count);
+            break;
+        case 2u:
+            expected.replace(pos, count, txt);
+            s.replace(pos, count, txt);
+            break;
+        default:
+            expected.resize(count * 5u, 'r');
+            s.resize(count * 5u, 'r');
+            break;
+        }
+        ASSERT_EQ(expected.size(), s.size());
+        ASSERT_STREQ(expected.c_str(), s.data());
+    }
+}
+
+TEST(SmallStringOptimizationTests, replaceAll)
+{
+    CSmallStringOpt<16u> s{"a-b-c"};
+    s.replace_all('-', '+');
+    ASSERT_STREQ(s.data(), "a+b+c");
+
+    s.replace_all("+", "{plus}");
+    ASSERT_STREQ(s.data(), "a{plus}b{plus}c");
+    s.replace_all("{plus}", "");
+    ASSERT_STREQ(s.data(), "abc");
+    s.replace_all("x", "yyyy");
+    ASSERT_STREQ(s.data(), "abc");
+    s.replace_all("", "yyyy");
+    ASSERT_STREQ(s.data(), "abc");
+    s.replace_all(std::string{"b"}, std::string{"B"});
+    ASSERT_STREQ(s.data(), "aBc");
+
+    // overlapping matches are replaced from the left
+    CSmallStringOpt<16u> a{"aaaaa"};
+    a.replace_all("aa", "b");
+    ASSERT_STREQ(a.data(), "bba");
+
+    // replaced by a part of itself
+    CSmallStringOpt<16u> self{"x.y"};
+    self.replace_all(self.data() + 1, 1u, self.data(), 3u);
+    ASSERT_STREQ(self.data(), "xx.yy");
+}
+
+TEST(SmallStringOptimizationTests, replaceAllLong)
+{
+    std::string expected;
+    for (int i = 0; i < 200; ++i)
+    {
+        expected += "<a&b> ";
+    }
+    CSmallStringOpt<16u> s{expected.data(), expected.size()};
+    s.replace_all('a', 'A');
+    s.replace_all("&", "&amp;");
+    s.replace_all("<", "&lt;");
+    s.replace_all(">", "&gt;");
+    std::string html;
+    for (int i = 0; i < 200; ++i)
+    {
+        html += "&lt;A&amp;b&gt; ";
+    }
+    ASSERT_EQ(s.size(), html.size());
+    ASSERT_STREQ(s.data(), html.c_str());
+
+    const TCowString cow1{"abcdefghijklmnop"};
+    TCowString cow2{cow1};
+    cow2.replace_all('a', 'A');
+    cow2.replace_all("bc", "");
+    ASSERT_STREQ(cow1.data(), "abcdefghijklmnop");
+    ASSERT_STREQ(cow2.data(), "Adefghijklmnop");
+}
+
+namespace
+{
+
+/**
+ * @brief Stateful allocator that is not propagated on move assignment.
+ */
+template<typename TChar>
+struct CTaggedAllocator
+{
+    using value_type = TChar;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+
+    int mTag = 0;
+
+    CTaggedAllocator() = default;
+
+    explicit CTaggedAllocator(int aTag) noexcept
+        : mTag{aTag}
+    {
+    }
+
+    TChar* allocate(std::size_t aLength)
+    {
+        return std::allocator<TChar>{}.allocate(aLength);
+    }
+
+    void deallocate(TChar* aPtr, std::size_t aLength) noexcept
+    {
+        std::allocator<TChar>{}.deallocate(aPtr, aLength);
+    }
+
+    bool operator==(const CTaggedAllocator& aObj) const noexcept
+    {
+        return mTag == aObj.mTag;
+    }
+
+    bool operator!=(const CTaggedAllocator& aObj) const noexcept
+    {
+        return mTag != aObj.mTag;
+    }
+};
+
+/**
+ * @brief Stateful allocator that is propagated on move assignment. Every default constructed instance gets a new tag,
+ * memory released by an instance with another tag is counted.
+ */
+template<typename TChar>
+struct CPropagatedAllocator
+{
+    using value_type = TChar;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    static inline int sNextTag = 0;
+    static inline std::map<const void*, int> sOwners;
+    static inline std::size_t sForeignDeallocations = 0u;
+
+    int mTag = ++sNextTag;
+
+    TChar* allocate(std::size_t aLength)
+    {
+        TChar* const ptr = std::allocator<TChar>{}.allocate(aLength);
+        sOwners[ptr] = mTag;
+        return ptr;
+    }
+
+    void deallocate(TChar* aPtr, std::size_t aLength) noexcept
+    {
+        sForeignDeallocations += sOwners[aPtr] != mTag ? 1u : 0u;
+        sOwners.erase(aPtr);
+        std::allocator<TChar>{}.deallocate(aPtr, aLength);
+    }
+
+    bool operator==(const CPropagatedAllocator& aObj) const noexcept
+    {
+        return mTag == aObj.mTag;
+    }
+
+    bool operator!=(const CPropagatedAllocator& aObj) const noexcept
+    {
+        return mTag != aObj.mTag;
+    }
+};
+
+} // namespace
+
+TEST(SmallStringOptimizationTests, moveAssignmentPropagatesAllocator)
+{
+    using DSmall = CSmallStringOpt<10u, char, CPropagatedAllocator<char>>;
+    using DBig = CSmallStringOpt<20u, char, CPropagatedAllocator<char>>;
+    {
+        DSmall s1{"abcdefghijklmnop"};
+        DBig s2{"abcdefghijklmnopqrstuvwxyz"};
+        s1 = std::move(s2);
+        ASSERT_STREQ(s1.data(), "abcdefghijklmnopqrstuvwxyz");
+        ASSERT_TRUE(s2.empty());
+        s2.append("abcdefghijklmnopqrstuvwxyz0123");
+
+        DSmall s3{"0123456789abcdef"};
+        DSmall s4{"abcdefghijklmnopqrstuvwxyz"};
+        s3 = std::move(s4);
+        ASSERT_STREQ(s3.data(), "abcdefghijklmnopqrstuvwxyz");
+    }
+    ASSERT_TRUE(CPropagatedAllocator<char>::sOwners.empty());
+    ASSERT_EQ(CPropagatedAllocator<char>::sForeignDeallocations, 0u);
+}
+
+TEST(SmallStringOptimizationTests, nothrowMove)
+{
+    using DType = CSmallStringOpt<10u>;
+    static_assert(std::is_nothrow_move_constructible<DType>::value, "");
+    static_assert(std::is_nothrow_move_assignable<DType>::value, "");
+    static_assert(std::is_nothrow_move_constructible<TCowString>::value, "");
+    static_assert(std::is_nothrow_move_assignable<TCowString>::value, "");
+    using DTagged = CSmallStringOpt<10u, char, CTaggedAllocator<char>>;
+    static_assert(std::is_nothrow_move_constructible<DTagged>::value, "");
+    static_assert(false == std::is_nothrow_move_assignable<DTagged>::value, "");
+
+    DType s1{"abcdefghijklmnop"};
+    const char* const ptr = s1.data();
+    DType s2{std::move(s1)};
+    ASSERT_EQ(s2.data(), ptr);
+    ASSERT_TRUE(s1.empty());
+    ASSERT_STREQ(s1.data(), "");
+
+    DType s3{"abc"};
+    s3 = std::move(s2);
+    ASSERT_EQ(s3.data(), ptr);
+    ASSERT_TRUE(s2.empty());
+    s2 = std::move(s3);
+    ASSERT_STREQ(s2.data(), "abcdefghijklmnop");
+    s3 = DType{"xyz"};
+    ASSERT_STREQ(s3.data(), "xyz");
+    s3 = std::move(s3);
+    ASSERT_STREQ(s3.data(), "xyz");
+
+    CSmallStringOpt<20u> s4{"abcdefghijklmnopqrstuvwxyz"};
+    s2 = std::move(s4);
+    ASSERT_STREQ(s2.data(), "abcdefghijklmnopqrstuvwxyz");
+    ASSERT_TRUE(s4.empty());
+
+    // different allocators which are not propagated, so characters are copied
+    DTagged t1{"abcdefghijklmnop"};
+    DTagged t2{"abc"};
+    t2 = std::move(t1);
+    ASSERT_STREQ(t2.data(), "abcdefghijklmnop");
+    DTagged t3{std::move(t2)};
+    ASSERT_STREQ(t3.data(), "abcdefghijklmnop");
+}
+
+TEST(SmallStringOptimizationTests, swap)
+{
+    using DType = CSmallStringOpt<10u>;
+    static_assert(noexcept(std::declval<DType&>().swap(std::declval<DType&>())), "");
+
+    DType s1{"abc"};
+    DType s2{"xyz12"};
+    swap(s1, s2);
+    ASSERT_STREQ(s1.data(), "xyz12");
+    ASSERT_STREQ(s2.data(), "abc");
+
+    DType s3{"abcdefghijklmnop"};
+    const char* const ptr = s3.data();
+    s1.swap(s3);
+    ASSERT_EQ(s1.data(), ptr);
+    ASSERT_STREQ(s3.data(), "xyz12");
+    std::swap(s1, s3);
+    ASSERT_STREQ(s1.data(), "xyz12");
+    ASSERT_EQ(s3.data(), ptr);
+
+    DType s4{"0123456789abcdef"};
+    const char* const ptr4 = s4.data();
+    using std::swap;
+    swap(s3, s4);
+    ASSERT_EQ(s3.data(), ptr4);
+    ASSERT_EQ(s4.data(), ptr);
+    s4.swap(s4);
+    ASSERT_STREQ(s4.data(), "abcdefghijklmnop");
+
+    TCowString cow1{"abcdefghijklmnop"};
+    const TCowString cow2{cow1};
+    TCowString cow3{"abc"};
+    cow1.swap(cow3);
+    ASSERT_STREQ(cow1.data(), "abc");
+    ASSERT_STREQ(cow3.data(), "abcdefghijklmnop");
+    ASSERT_EQ(cow3.data(), cow2.data());
+
+    // allocator which is not propagated, equal instances exchange memory
+    using DTagged = CSmallStringOpt<10u, char, CTaggedAllocator<char>>;
+    static_assert(false == noexcept(std::declval<DTagged&>().swap(std::declval<DTagged&>())), "");
+    DTagged t1{"abcdefghijklmnop"};
+    DTagged t2{"abc"};
+    t1.swap(t2);
+    ASSERT_STREQ(t1.data(), "abc");
+    ASSERT_STREQ(t2.data(), "abcdefghijklmnop");
+}
+
+TEST(SmallStringOptimizationTests, wideCharacters)
+{
+    using DType = CSmallStringOptBytes<32u, char16_t>;
+    static_assert(DType::sSmallStringOptLength == 16u, "");
+    static_assert(CSmallStringOptBytes<32u, char32_t>::sSmallStringOptLength == 8u, "");
+    static_assert(CSmallStringOptBytes<32u>::sSmallStringOptLength == 32u, "");
+
+    DType s1{u"zażółć"};
+    ASSERT_EQ(s1.size(), 6u);
+    ASSERT_EQ(s1.capacity(), 16u);
+    s1 += u" gęślą";
+    s1.append(u" jaźń");
+    ASSERT_EQ(s1.size(), 17u);
+    ASSERT_GT(s1.capacity(), 16u);
+    ASSERT_TRUE(s1 == u"zażółć gęślą jaźń");
+    ASSERT_EQ(s1.find(u"gęślą"), 7u);
+    ASSERT_EQ(s1.find(u'ź'), 15u);
+    ASSERT_EQ(std::u16string(s1.data(), s1.size()), u"zażółć gęślą jaźń");
+    s1 = u"abc";
+    ASSERT_TRUE(s1 == u"abc");
+    s1.insert(1u, u"xy");
+    ASSERT_TRUE(s1 == u"axybc");
+
+    CSmallStringOpt<8u, char32_t> s2{U"żółw"};
+    s2.push_back(U'🐢');
+    ASSERT_EQ(s2.size(), 5u);
+    ASSERT_TRUE(s2 == U"żółw🐢");
+    ASSERT_EQ(s2.rfind(U"🐢"), 4u);
+
+#if defined(__cpp_char8_t)
+    const CSmallStringOpt<8u, char8_t> s3{u8"żółw"};
+    ASSERT_EQ(s3.size(), 7u);
+    ASSERT_TRUE(s3 == u8"żółw");
+#endif
+}
+
+#if defined(NSSO_HAS_CONSTEXPR20)
+
+namespace
+{
+
+constexpr CSmallStringOpt<16u> makeGreeting()
+{
+    CSmallStringOpt<16u> str{"hello"};
+    str.append(", ");
+    str += "world";
+    str.push_back('!');
+    return str;
+}
+
+constexpr CSmallStringOpt<16u> gGreeting = makeGreeting();
+
+constexpr std::array<CSmallStringOpt<8u>, 3u> gKeywords{
+    CSmallStringOpt<8u>{"delete"}, CSmallStringOpt<8u>{"get"}, CSmallStringOpt<8u>{"put"}};
+
+} // namespace
+
+TEST(SmallStringOptimizationTests, constexprInline)
+{
+    static_assert(gGreeting.size() == 13u, "");
+    static_assert(gGreeting == "hello, world!", "");
+    static_assert(gGreeting != "hello", "");
+    static_assert(gGreeting[7] == 'w', "");
+    static_assert(gGreeting.capacity() == 16u, "");
+    static_assert(false == gGreeting.empty(), "");
+    static_assert(gKeywords[0] < gKeywords[1] && gKeywords[1] < gKeywords[2], "");
+    static_assert(gKeywords[1] == CSmallStringOpt<16u>{"get"}, "");
+    static_assert(CSmallStringOpt<8u>{"abc", 2u} == "ab", "");
+
+    // the same functions at run time
+    ASSERT_STREQ(gGreeting.data(), "hello, world!");
+    const auto greeting = makeGreeting();
+    ASSERT_TRUE(greeting == gGreeting);
+}
+
+#endif // NSSO_HAS_CONSTEXPR20
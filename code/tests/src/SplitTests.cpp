@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/Split.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using namespace NSSO;
+
+namespace
+{
+
+/**
+ * @brief Copy pieces of the given range.
+ */
+template<typename TRange>
+std::vector<std::string> toVector(const TRange& aRange)
+{
+    std::vector<std::string> output;
+    for (const auto piece : aRange)
+    {
+        output.emplace_back(piece);
+    }
+    return output;
+}
+
+} // namespace
+
+TEST(SplitTests, iteratorCategory)
+{
+    using DIterator = decltype(split(std::string_view{}, ',').begin());
+    static_assert(std::is_same<std::iterator_traits<DIterator>::iterator_category, std::input_iterator_tag>::value, "");
+    static_assert(std::is_same<std::iterator_traits<DIterator>::reference, std::string_view>::value, "");
+#if defined(__cpp_lib_ranges)
+    static_assert(std::forward_iterator<DIterator>, "");
+#endif
+}
+
+TEST(SplitTests, character)
+{
+    const CSmallStringOpt<10u> str{"a,bc,,d,"};
+    const std::vector<std::string> expected{"a", "bc", "", "d", ""};
+    EXPECT_EQ(expected, toVector(split(str, ',')));
+
+    EXPECT_EQ(std::vector<std::string>{""}, toVector(split(std::string{}, ',')));
+    EXPECT_EQ(std::vector<std::string>{"abc"}, toVector(split(std::string_view{"abc"}, ',')));
+}
+
+TEST(SplitTests, piecesPointToString)
+{
+    const CSimpleString<char> str{"key=value"};
+    const auto range = split(str, '=');
+    auto iter = range.begin();
+    EXPECT_EQ(str.data(), (*iter).data());
+    EXPECT_EQ(str.data() + 4, (*++iter).data());
+    EXPECT_EQ(range.end(), ++iter);
+    EXPECT_EQ(2, std::distance(range.begin(), range.end()));
+}
+
+TEST(SplitTests, sequence)
+{
+    const std::string str{"a::b:c::::d"};
+    const std::vector<std::string> expected{"a", "b:c", "", "d"};
+    EXPECT_EQ(expected, toVector(split(str, "::")));
+    EXPECT_EQ(expected, toVector(split(str, std::string{"::"})));
+    // empty delimiter doesn't split
+    EXPECT_EQ(std::vector<std::string>{str}, toVector(split(str, "")));
+}
+
+TEST(SplitTests, anyOf)
+{
+    const CSmallStringOpt<32u> str{"GET /index.html\tHTTP/1.1\r\n"};
+    const std::vector<std::string> expected{"GET", "/index.html", "HTTP/1.1", "", ""};
+    EXPECT_EQ(expected, toVector(split(str, anyOf(" \t\r\n"))));
+    EXPECT_EQ(std::vector<std::string>{str.data()}, toVector(split(str, anyOf(""))));
+}
+
+TEST(SplitTests, wideChars)
+{
+    const CSmallStringOpt<10u, wchar_t> str{L"x y"};
+    std::vector<std::wstring> pieces;
+    for (const auto piece : split(str, L' '))
+    {
+        pieces.emplace_back(piece);
+    }
+    EXPECT_EQ((std::vector<std::wstring>{L"x", L"y"}), pieces);
+}
+
+TEST(SplitTests, long)
+{
+    std::string str;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected.push_back(std::to_string(i * 7919));
+        str += expected.back();
+        str += ';';
+    }
+    expected.emplace_back();
+    EXPECT_EQ(expected, toVector(split(str, ';')));
+}
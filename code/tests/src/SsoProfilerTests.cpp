@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace NSSO;
+
+#if defined(NSSO_ENABLE_PROFILER)
+
+TEST(SsoProfilerTests, construct)
+{
+    auto& rec = CSsoProfiler::record<7u, char>();
+    const CSmallStringOpt<7u> s1{"abc"};
+    const CSmallStringOpt<7u> s2{"abcdefghijk"};
+
+    ASSERT_EQ(rec.count(ESsoOperation::eConstruct, ESsoPlacement::eInline), 1u);
+    ASSERT_EQ(rec.count(ESsoOperation::eConstruct, ESsoPlacement::eSpill), 1u);
+    ASSERT_EQ(rec.mLengthHistogram[3].load(), 1u);
+    ASSERT_EQ(rec.mLengthHistogram[11].load(), 1u);
+}
+
+TEST(SsoProfilerTests, spillReasons)
+{
+    auto& rec = CSsoProfiler::record<5u, char>();
+    CSmallStringOpt<5u> s1{"ab"};
+    s1.append("cdefgh");
+    ASSERT_EQ(rec.count(ESsoOperation::eAppend, ESsoPlacement::eSpill), 1u);
+    s1.append("ij");
+    ASSERT_EQ(rec.count(ESsoOperation::eAppend, ESsoPlacement::eHeap), 1u);
+
+    CSmallStringOpt<5u> s2{"ab"};
+    s2.assign("abcdefgh");
+    ASSERT_EQ(rec.count(ESsoOperation::eAssign, ESsoPlacement::eSpill), 1u);
+    s2.assign("a");
+    ASSERT_EQ(rec.count(ESsoOperation::eAssign, ESsoPlacement::eInline), 1u);
+
+    CSmallStringOpt<5u> s3{"ab"};
+    s3.reserve(100u);
+    ASSERT_EQ(rec.count(ESsoOperation::eReserve, ESsoPlacement::eSpill), 1u);
+}
+
+TEST(SsoProfilerTests, spillsWrittenInPlace)
+{
+    auto& rec = CSsoProfiler::record<6u, char>();
+    CSmallStringOpt<6u> s1{"abc"};
+    s1.resize_and_overwrite(20u, [](char* aBuffer, std::size_t aCount)
+    {
+        std::fill(aBuffer, aBuffer + aCount, 'x');
+        return aCount;
+    });
+    ASSERT_EQ(rec.count(ESsoOperation::eAssign, ESsoPlacement::eSpill), 1u);
+    ASSERT_EQ(rec.count(ESsoOperation::eAssign, ESsoPlacement::eHeap), 0u);
+    ASSERT_EQ(rec.count(ESsoOperation::eReserve, ESsoPlacement::eInline), 0u);
+
+    CSmallStringOpt<6u> s2{"abc"};
+    s2.append_number(1234567890123ll);
+    ASSERT_EQ(rec.count(ESsoOperation::eAppend, ESsoPlacement::eSpill), 1u);
+    ASSERT_EQ(rec.count(ESsoOperation::eAppend, ESsoPlacement::eHeap), 0u);
+    ASSERT_STREQ(s2.data(), "abc1234567890123");
+
+    CSmallStringOpt<6u> s3{"abc"};
+    s3.grow_uninitialized(10u);
+    ASSERT_EQ(rec.count(ESsoOperation::eReserve, ESsoPlacement::eSpill), 1u);
+    ASSERT_EQ(rec.count(ESsoOperation::eReserve, ESsoPlacement::eInline), 0u);
+}
+
+TEST(SsoProfilerTests, report)
+{
+    const CSmallStringOpt<9u> s1{"abc"};
+    const CSmallStringOpt<9u> s2{"abcdefghijk"};
+
+    std::ostringstream report;
+    CSsoProfiler::report(report);
+    ASSERT_NE(report.str().find("CSmallStringOpt<9>"), std::string::npos);
+
+    std::ostringstream lengths;
+    CSsoProfiler::dumpLengths(lengths);
+    ASSERT_NE(lengths.str().find("11 "), std::string::npos);
+}
+
+#endif // NSSO_ENABLE_PROFILER
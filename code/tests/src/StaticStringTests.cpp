@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/StaticString.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+#include <string>
+
+using namespace NSSO;
+
+TEST(StaticStringTests, compileTimeLengthAndHash)
+{
+    constexpr auto route = "route"_sso;
+    static_assert(route.size() == 5u, "");
+    static_assert(route.hash() == hashOf("route", 5u), "");
+    static_assert(route == CStaticString<char>{"route"}, "");
+    static_assert(route != "router"_sso, "");
+    static_assert(""_sso.empty(), "");
+    static_assert(u"route"_sso.size() == 5u, "");
+    static_assert(U"route"_sso.hash() == hashOf(U"route", 5u), "");
+    static_assert(L"route"_sso[1] == L'o', "");
+
+    ASSERT_STREQ(route.c_str(), "route");
+    ASSERT_EQ(route.view(), std::string_view{"route"});
+    ASSERT_EQ(hashOf(std::string{"route"}), route.hash());
+}
+
+TEST(StaticStringTests, compareWithStrings)
+{
+    const CSmallStringOpt<8u> shortStr{"route"};
+    const CSmallStringOpt<8u> longStr{"route/users/list"};
+    ASSERT_TRUE(shortStr == "route"_sso);
+    ASSERT_TRUE("route"_sso == shortStr);
+    ASSERT_FALSE(shortStr != "route"_sso);
+    ASSERT_TRUE(shortStr != "rout"_sso);
+    ASSERT_TRUE(shortStr != "routa"_sso);
+    ASSERT_TRUE(longStr == "route/users/list"_sso);
+    ASSERT_TRUE(CSmallStringOpt<8u>{} == ""_sso);
+
+    const CSimpleString<char> simple{"route"};
+    ASSERT_TRUE(simple == "route"_sso);
+    ASSERT_TRUE("routes"_sso != simple);
+    ASSERT_TRUE(CSimpleString<char>{} == ""_sso);
+
+    constexpr CStaticString<char> keys[] = {"get"_sso, "put"_sso, "route"_sso};
+    const std::uint64_t hash = hashOf(shortStr);
+    std::size_t found = 3u;
+    for (std::size_t i = 0u; i < 3u; ++i)
+    {
+        if (keys[i].equals(shortStr.data(), shortStr.size(), hash))
+        {
+            found = i;
+        }
+    }
+    ASSERT_EQ(found, 2u);
+}
+
+TEST(StaticStringTests, switchOnHash)
+{
+    const auto dispatch = [](const CSmallStringOpt<16u>& aKey)
+    {
+        switch (hashOf(aKey))
+        {
+        case "get"_sso.hash():
+            return "get"_sso == aKey ? 1 : 0;
+        case "put"_sso.hash():
+            return "put"_sso == aKey ? 2 : 0;
+        default:
+            return 0;
+        }
+    };
+    ASSERT_EQ(dispatch(CSmallStringOpt<16u>{"get"}), 1);
+    ASSERT_EQ(dispatch(CSmallStringOpt<16u>{"put"}), 2);
+    ASSERT_EQ(dispatch(CSmallStringOpt<16u>{"post"}), 0);
+}
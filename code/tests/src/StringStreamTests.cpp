@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/StringStream.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+#include <SmallStringOptimization/CountingAllocator.hpp>
+
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+
+using namespace NSSO;
+
+TEST(StringStreamTests, writeInline)
+{
+    CSmallStringOpt<20u> s{"id="};
+    {
+        CStringOStream<CSmallStringOpt<20u>> stream{s};
+        stream << 42 << ' ' << "ab";
+    }
+    ASSERT_STREQ(s.data(), "id=42 ab");
+    ASSERT_EQ(s.size(), 8u);
+}
+
+TEST(StringStreamTests, writeSpill)
+{
+    CSmallStringOpt<8u> s;
+    CStringOStream<CSmallStringOpt<8u>> stream{s};
+    std::string expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        stream << i << ',';
+        expected += std::to_string(i) + ',';
+    }
+    stream << std::string(5000u, 'x');
+    expected += std::string(5000u, 'x');
+    ASSERT_EQ(&stream.str(), &s);
+    ASSERT_EQ(s.size(), expected.size());
+    ASSERT_STREQ(s.data(), expected.c_str());
+
+    // writing continues after str()
+    stream << std::setw(4) << 7 << std::flush;
+    ASSERT_EQ(s.size(), expected.size() + 4u);
+    ASSERT_STREQ(s.data() + expected.size(), "   7");
+}
+
+TEST(StringStreamTests, writeCopyOnWrite)
+{
+    using DType = CSmallStringOpt<8u, char, CCountingAllocator<char>, CCopyOnWritePolicy>;
+    DType s{"abcdefghijklmnop"};
+    const DType copy{s};
+    ASSERT_EQ(s.data(), copy.data());
+    const auto start = CAllocationStatistics::instance().snapshot();
+    {
+        CStringOStream<DType> stream{s};
+        stream << 42 << ' ' << "ab";
+    }
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    // shared memory is copied once, before spare memory is measured
+    ASSERT_EQ(diff.mAllocations, 1u);
+    ASSERT_STREQ(s.data(), "abcdefghijklmnop42 ab");
+    ASSERT_STREQ(copy.data(), "abcdefghijklmnop");
+}
+
+TEST(StringStreamTests, writeSimpleString)
+{
+    CSimpleString<char> s;
+    {
+        CStringOStream<CSimpleString<char>> stream{s};
+        stream << "abc" << 1.5;
+    }
+    ASSERT_STREQ(s.data(), "abc1.5");
+
+    CSmallStringOpt<4u, wchar_t> w;
+    {
+        CStringOStream<CSmallStringOpt<4u, wchar_t>> stream{w};
+        stream << L"wide " << 12;
+    }
+    ASSERT_TRUE(w == L"wide 12");
+}
+
+namespace
+{
+
+/**
+ * @brief Stream buffer without get area, characters are read one by one by underflow/uflow.
+ */
+class CUnbufferedStreamBuf : public std::streambuf
+{
+    std::string mData;
+    std::size_t mPos = 0u;
+
+public:
+    explicit CUnbufferedStreamBuf(std::string aData)
+        : mData{std::move(aData)}
+    {
+    }
+
+protected:
+    int_type underflow() override
+    {
+        return mPos < mData.size() ? traits_type::to_int_type(mData[mPos]) : traits_type::eof();
+    }
+
+    int_type uflow() override
+    {
+        return mPos < mData.size() ? traits_type::to_int_type(mData[mPos++]) : traits_type::eof();
+    }
+};
+
+/**
+ * @brief Allocator that throws std::bad_alloc for more than 32 characters.
+ */
+template<typename TChar>
+struct CLimitedAllocator
+{
+    using value_type = TChar;
+
+    TChar* allocate(std::size_t aLength)
+    {
+        if (aLength > 32u)
+        {
+            throw std::bad_alloc{};
+        }
+        return std::allocator<TChar>{}.allocate(aLength);
+    }
+
+    void deallocate(TChar* aPtr, std::size_t aLength) noexcept
+    {
+        std::allocator<TChar>{}.deallocate(aPtr, aLength);
+    }
+
+    bool operator==(const CLimitedAllocator&) const noexcept
+    {
+        return true;
+    }
+
+    bool operator!=(const CLimitedAllocator&) const noexcept
+    {
+        return false;
+    }
+};
+
+} // namespace
+
+TEST(StringStreamTests, getline)
+{
+    std::istringstream stream{"first line\nsecond, much longer line of the text\n\nlast"};
+    CSmallStringOpt<16u> s;
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s)));
+    ASSERT_STREQ(s.data(), "first line");
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s)));
+    ASSERT_STREQ(s.data(), "second, much longer line of the text");
+    const char* const memory = s.data();
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s)));
+    ASSERT_EQ(s.size(), 0u);
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s, 's')));
+    ASSERT_STREQ(s.data(), "la");
+    ASSERT_EQ(s.data(), memory); // memory is reused
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s)));
+    ASSERT_STREQ(s.data(), "t");
+    ASSERT_TRUE(stream.eof());
+    ASSERT_FALSE(static_cast<bool>(getline(stream, s)));
+}
+
+TEST(StringStreamTests, getlineLong)
+{
+    const std::string line(100000u, 'a');
+    std::istringstream stream{line + "\n" + line};
+    CSimpleString<char> s;
+    int count = 0;
+    while (getline(stream, s))
+    {
+        ASSERT_EQ(s.size(), line.size());
+        ++count;
+    }
+    ASSERT_EQ(count, 2);
+}
+
+TEST(StringStreamTests, getlineUnbuffered)
+{
+    CUnbufferedStreamBuf buffer{"ab\ncd"};
+    std::istream stream{&buffer};
+    CSmallStringOpt<4u> s;
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s)));
+    ASSERT_STREQ(s.data(), "ab");
+    ASSERT_TRUE(static_cast<bool>(getline(stream, s)));
+    ASSERT_STREQ(s.data(), "cd");
+    ASSERT_TRUE(stream.eof());
+}
+
+TEST(StringStreamTests, readWord)
+{
+    std::istringstream stream{"  alpha\tbeta-gamma \n delta"};
+    CSmallStringOpt<8u> s;
+    CSimpleString<char> t;
+    stream >> s >> t;
+    ASSERT_STREQ(s.data(), "alpha");
+    ASSERT_STREQ(t.data(), "beta-gamma");
+    stream >> std::setw(3) >> s;
+    ASSERT_STREQ(s.data(), "del");
+    stream >> s;
+    ASSERT_STREQ(s.data(), "ta");
+    ASSERT_TRUE(stream.eof());
+    ASSERT_FALSE(static_cast<bool>(stream >> s));
+
+    CUnbufferedStreamBuf buffer{" xy z"};
+    std::istream unbuffered{&buffer};
+    unbuffered >> s;
+    ASSERT_STREQ(s.data(), "xy");
+    unbuffered >> s;
+    ASSERT_STREQ(s.data(), "z");
+}
+
+TEST(StringStreamTests, readBadAlloc)
+{
+    using DType = CSmallStringOpt<8u, char, CLimitedAllocator<char>>;
+    const std::string text = "short " + std::string(100u, 'a') + "\n";
+    DType s;
+
+    std::istringstream stream1{text};
+    ASSERT_FALSE(static_cast<bool>(getline(stream1, s)));
+    ASSERT_TRUE(stream1.bad());
+
+    std::istringstream stream2{text};
+    stream2 >> s;
+    ASSERT_STREQ(s.data(), "short");
+    ASSERT_FALSE(static_cast<bool>(stream2 >> s));
+    ASSERT_TRUE(stream2.bad());
+
+    std::istringstream stream3{text};
+    stream3.exceptions(std::ios_base::badbit);
+    ASSERT_THROW(getline(stream3, s), std::bad_alloc);
+    ASSERT_TRUE(stream3.bad());
+
+    std::istringstream stream4{text};
+    stream4.exceptions(std::ios_base::failbit);
+    stream4 >> s;
+    ASSERT_THROW(stream4 >> s, std::ios_base::failure);
+    ASSERT_TRUE(stream4.bad());
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/StringVector.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+#include <SmallStringOptimization/CountingAllocator.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace NSSO;
+
+TEST(StringVectorTests, triviallyRelocatable)
+{
+    static_assert(gIsTriviallyRelocatable<int>, "");
+    static_assert(gIsTriviallyRelocatable<CSmallStringOpt<10u>>, "");
+    static_assert(gIsTriviallyRelocatable<CSmallStringOpt<10u, char, std::allocator<char>, CCopyOnWritePolicy>>, "");
+    static_assert(gIsTriviallyRelocatable<CSimpleString<char>>, "");
+    static_assert(gIsTriviallyRelocatable<CSmallStringOpt<10u, char, CCountingAllocator<char>>>, "");
+    static_assert(false == gIsTriviallyRelocatable<std::string>, "");
+    static_assert(CStringVector<CSmallStringOpt<10u>>::sTriviallyRelocatable, "");
+    static_assert(false == CStringVector<std::string>::sTriviallyRelocatable, "");
+}
+
+TEST(StringVectorTests, pushBackRelocatesWithoutAllocations)
+{
+    using DType = CSmallStringOpt<10u, char, CCountingAllocator<char>>;
+    CStringVector<DType> strings;
+    const auto start = CAllocationStatistics::instance().snapshot();
+    for (int i = 0; i < 100; ++i)
+    {
+        strings.push_back(DType{i % 2 == 0 ? "abc" : "abcdefghijklmnop"});
+    }
+    const auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 50u);
+    ASSERT_EQ(diff.mDeallocations, 0u);
+    ASSERT_EQ(strings.size(), 100u);
+    ASSERT_GE(strings.capacity(), 100u);
+    for (std::size_t i = 0u; i < strings.size(); ++i)
+    {
+        ASSERT_STREQ(strings[i].data(), i % 2 == 0 ? "abc" : "abcdefghijklmnop");
+    }
+}
+
+template<typename TString>
+void checkInsertErase()
+{
+    std::vector<std::string> expected;
+    CStringVector<TString> strings;
+    const char* const words[] = {"a", "bcdefghijklmnopqrstuvwxyz", "cd", "efghijklmnopqrstuvwxyz", "g"};
+    for (int i = 0; i < 40; ++i)
+    {
+        const char* const word = words[i % 5];
+        const std::size_t pos = static_cast<std::size_t>(i * 7) % (expected.size() + 1u);
+        expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(pos), word);
+        const auto iter = strings.insert(strings.begin() + pos, TString{word});
+        ASSERT_EQ(iter, strings.begin() + pos);
+    }
+    // argument refers to an element
+    strings.emplace(strings.begin(), strings.back());
+    expected.insert(expected.begin(), expected.back());
+    strings.erase(strings.begin() + 3);
+    expected.erase(expected.begin() + 3);
+    strings.erase(strings.begin() + 10, strings.begin() + 20);
+    expected.erase(expected.begin() + 10, expected.begin() + 20);
+    strings.erase(strings.end() - 1);
+    expected.erase(expected.end() - 1);
+    strings.pop_back();
+    expected.pop_back();
+
+    ASSERT_EQ(strings.size(), expected.size());
+    for (std::size_t i = 0u; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(std::string(strings[i].data(), strings[i].size()), expected[i]);
+    }
+
+    CStringVector<TString> copy{strings};
+    CStringVector<TString> moved{std::move(strings)};
+    ASSERT_TRUE(strings.empty());
+    ASSERT_EQ(copy.size(), moved.size());
+    ASSERT_EQ(std::string(copy.front().data(), copy.front().size()), expected.front());
+    copy.clear();
+    ASSERT_TRUE(copy.empty());
+    swap(copy, moved);
+    ASSERT_EQ(copy.size(), expected.size());
+}
+
+TEST(StringVectorTests, insertEraseSmallStringOpt)
+{
+    checkInsertErase<CSmallStringOpt<10u>>();
+}
+
+TEST(StringVectorTests, insertEraseCopyOnWrite)
+{
+    checkInsertErase<CSmallStringOpt<10u, char, std::allocator<char>, CCopyOnWritePolicy>>();
+}
+
+TEST(StringVectorTests, insertEraseSimpleString)
+{
+    checkInsertErase<CSimpleString<char>>();
+}
+
+TEST(StringVectorTests, insertEraseStdString)
+{
+    checkInsertErase<std::string>();
+}
+
+namespace
+{
+
+template<typename T, bool TPropagate>
+struct CTaggedVectorAllocator
+{
+    using value_type = T;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_copy_assignment = std::integral_constant<bool, TPropagate>;
+    using propagate_on_container_move_assignment = std::integral_constant<bool, TPropagate>;
+    using propagate_on_container_swap = std::integral_constant<bool, TPropagate>;
+
+    static inline int sNextTag = 0;
+    static inline std::map<const void*, int> sOwners;
+    static inline std::size_t sForeignDeallocations = 0u;
+
+    int mTag = ++sNextTag;
+    bool mSelectedForCopy = false;
+
+    CTaggedVectorAllocator select_on_container_copy_construction() const
+    {
+        CTaggedVectorAllocator allocator;
+        allocator.mSelectedForCopy = true;
+        return allocator;
+    }
+
+    T* allocate(std::size_t aLength)
+    {
+        T* const ptr = std::allocator<T>{}.allocate(aLength);
+        sOwners[ptr] = mTag;
+        return ptr;
+    }
+
+    void deallocate(T* aPtr, std::size_t aLength) noexcept
+    {
+        if (aPtr != nullptr)
+        {
+            sForeignDeallocations += sOwners[aPtr] != mTag ? 1u : 0u;
+            sOwners.erase(aPtr);
+        }
+        std::allocator<T>{}.deallocate(aPtr, aLength);
+    }
+
+    bool operator==(const CTaggedVectorAllocator& aObj) const noexcept
+    {
+        return mTag == aObj.mTag;
+    }
+
+    bool operator!=(const CTaggedVectorAllocator& aObj) const noexcept
+    {
+        return mTag != aObj.mTag;
+    }
+};
+
+template<bool TPropagate>
+void checkAllocatorTraits()
+{
+    using DType = CSmallStringOpt<10u>;
+    using DAllocator = CTaggedVectorAllocator<DType, TPropagate>;
+    using DVector = CStringVector<DType, DAllocator>;
+    static_assert(std::is_nothrow_move_assignable<DVector>::value == TPropagate, "");
+    {
+        DVector v1;
+        v1.push_back(DType{"abc"});
+        v1.push_back(DType{"abcdefghijklmnop"});
+        const DType* const data = v1.data();
+
+        // the copy gets the allocator of select_on_container_copy_construction
+        DVector v2{v1};
+        ASSERT_TRUE(v2.get_allocator().mSelectedForCopy);
+        ASSERT_STREQ(v2.back().data(), "abcdefghijklmnop");
+
+        DVector v3;
+        v3 = v1;
+        ASSERT_EQ(v3.get_allocator() == v1.get_allocator(), TPropagate);
+        ASSERT_STREQ(v3.front().data(), "abc");
+
+        DVector v4;
+        const DAllocator allocator4 = v4.get_allocator();
+        v4 = std::move(v1);
+        ASSERT_EQ(v4.get_allocator() == allocator4, false == TPropagate);
+        ASSERT_EQ(v4.data() == data, TPropagate);
+        ASSERT_STREQ(v4.back().data(), "abcdefghijklmnop");
+
+        const DAllocator allocator2 = v2.get_allocator();
+        swap(v2, v3);
+        ASSERT_EQ(v3.get_allocator() == allocator2, TPropagate);
+        ASSERT_STREQ(v2.front().data(), "abc");
+        ASSERT_STREQ(v3.back().data(), "abcdefghijklmnop");
+    }
+    ASSERT_TRUE(DAllocator::sOwners.empty());
+    ASSERT_EQ(DAllocator::sForeignDeallocations, 0u);
+}
+
+} // namespace
+
+TEST(StringVectorTests, propagatedAllocator)
+{
+    checkAllocatorTraits<true>();
+}
+
+TEST(StringVectorTests, notPropagatedAllocator)
+{
+    checkAllocatorTraits<false>();
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/Transcode.hpp>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+#include <SmallStringOptimization/CountingAllocator.hpp>
+
+#include <random>
+#include <string>
+
+using namespace NSSO;
+
+namespace
+{
+
+/**
+ * @brief Return random code points, mostly ASCII in runs, so both vector and scalar paths are taken.
+ */
+std::u32string randomCodePoints(std::mt19937& aGenerator, std::size_t aLength)
+{
+    std::u32string output;
+    while (output.size() < aLength)
+    {
+        const std::size_t run = aGenerator() % 40u;
+        for (std::size_t i = 0u; i < run; ++i)
+        {
+            output.push_back(static_cast<char32_t>(0x20u + aGenerator() % 0x5Fu));
+        }
+        switch (aGenerator() % 4u)
+        {
+        case 0u:
+            output.push_back(static_cast<char32_t>(0x104u + aGenerator() % 0x80u));
+            break;
+        case 1u:
+            output.push_back(static_cast<char32_t>(0xE000u + aGenerator() % 0x1000u));
+            break;
+        case 2u:
+            output.push_back(static_cast<char32_t>(0x10000u + aGenerator() % 0x100000u));
+            break;
+        default:
+            output.push_back(static_cast<char32_t>(0x800u + aGenerator() % 0xD000u));
+            break;
+        }
+    }
+    return output;
+}
+
+/**
+ * @brief Compare SIMD transcoding with scalar transcoding of the given input.
+ */
+template<typename TOut, typename TIn>
+void checkSameAsScalar(const std::basic_string<TIn>& aInput)
+{
+    using TString = CSimpleString<TOut>;
+    const TString simd = transcode<TString>(aInput);
+    TString scalar;
+    transcode_to<TString, std::basic_string<TIn>, CScalarTranscoder<TIn, TOut>>(scalar, aInput);
+    ASSERT_EQ(simd.size(), scalar.size());
+    ASSERT_TRUE(std::equal(simd.begin(), simd.end(), scalar.begin()));
+}
+
+} // namespace
+
+TEST(TranscodeTests, roundTrip)
+{
+    std::mt19937 generator{1234u};
+    for (int i = 0; i < 300; ++i)
+    {
+        const std::u32string codePoints = randomCodePoints(generator, generator() % 200u);
+        const auto utf8 = transcode<CSimpleString<char>>(codePoints);
+        const auto utf16 = transcode<CSimpleString<char16_t>>(utf8);
+        const auto utf32 = transcode<CSimpleString<char32_t>>(utf16);
+        ASSERT_EQ(std::u32string(utf32.data(), utf32.size()), codePoints);
+        ASSERT_TRUE(utf8.is_valid_utf8());
+        ASSERT_EQ(utf8.count_code_points(), codePoints.size());
+
+        const auto utf8From16 = transcode<CSmallStringOpt<32u, char>>(utf16);
+        ASSERT_EQ(std::string(utf8From16.data(), utf8From16.size()), std::string(utf8.data(), utf8.size()));
+        const auto utf16From32 = transcode<CSmallStringOpt<32u, char16_t>>(codePoints);
+        ASSERT_EQ(std::u16string(utf16From32.data(), utf16From32.size()), std::u16string(utf16.data(), utf16.size()));
+        const auto utf32From8 = transcode<CSmallStringOpt<32u, char32_t>>(utf8);
+        ASSERT_EQ(std::u32string(utf32From8.data(), utf32From8.size()), codePoints);
+    }
+}
+
+TEST(TranscodeTests, invalidInput)
+{
+    // truncated and overlong UTF-8, unpaired surrogates and code points above U+10FFFF are replaced by U+FFFD
+    const auto fromUtf8 = transcode<CSmallStringOpt<16u, char32_t>>(std::string{"a\xC0\x80" "b\xE2\x82"});
+    ASSERT_EQ(std::u32string(fromUtf8.data(), fromUtf8.size()), U"a��b��");
+    const std::u16string unpaired{u'a', static_cast<char16_t>(0xD800u), u'b', static_cast<char16_t>(0xDC00u)};
+    const auto fromUtf16 = transcode<CSmallStringOpt<16u, char>>(unpaired);
+    ASSERT_STREQ(fromUtf16.data(), "a\xEF\xBF\xBD" "b\xEF\xBF\xBD");
+    const std::u32string tooLarge{U'a', static_cast<char32_t>(0x110000u), static_cast<char32_t>(0xD800u), U'b'};
+    const auto fromUtf32 = transcode<CSmallStringOpt<16u, char16_t>>(tooLarge);
+    ASSERT_EQ(std::u16string(fromUtf32.data(), fromUtf32.size()), u"a��b");
+
+    std::mt19937 generator{4321u};
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string bytes;
+        std::u16string units;
+        std::u32string codePoints;
+        for (std::size_t j = generator() % 100u; j != 0u; --j)
+        {
+            const bool ascii = generator() % 3u != 0u;
+            bytes.push_back(static_cast<char>(ascii ? generator() % 0x80u : generator() % 0x100u));
+            units.push_back(static_cast<char16_t>(ascii ? generator() % 0x80u : 0xD000u + generator() % 0x1000u));
+            codePoints.push_back(static_cast<char32_t>(ascii ? generator() % 0x80u : generator()));
+        }
+        checkSameAsScalar<char16_t>(bytes);
+        checkSameAsScalar<char32_t>(bytes);
+        checkSameAsScalar<char>(units);
+        checkSameAsScalar<char32_t>(units);
+        checkSameAsScalar<char>(codePoints);
+        checkSameAsScalar<char16_t>(codePoints);
+    }
+}
+
+TEST(TranscodeTests, sizedOnce)
+{
+    using DUtf16 = CSmallStringOptBytes<32u, char16_t, CCountingAllocator<char16_t>>;
+    const std::string polish{"zażółć gęślą"};
+    auto start = CAllocationStatistics::instance().snapshot();
+    const DUtf16 inlineStr = transcode<DUtf16>(polish);
+    auto diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 0u);
+    ASSERT_EQ(std::u16string(inlineStr.data(), inlineStr.size()), u"zażółć gęślą");
+
+    const std::string longText{"zażółć gęślą jaźń, zażółć gęślą jaźń, zażółć gęślą jaźń"};
+    start = CAllocationStatistics::instance().snapshot();
+    const DUtf16 longStr = transcode<DUtf16>(longText);
+    diff = CAllocationStatistics::instance().snapshot() - start;
+    ASSERT_EQ(diff.mAllocations, 1u);
+    ASSERT_EQ(longStr.size(), 55u);
+
+    CSimpleString<char> appended{"> "};
+    transcode_to(appended, std::u32string{U"żółw 🐢"});
+    ASSERT_STREQ(appended.data(), "> żółw 🐢");
+
+    const auto wide = transcode<CSimpleString<wchar_t>>(polish);
+    ASSERT_EQ(std::wstring(wide.data(), wide.size()), L"zażółć gęślą");
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <SmallStringOptimization/SmallStringOptimization.hpp>
+#include <SmallStringOptimization/SimpleString.hpp>
+
+#include <random>
+#include <string>
+
+using namespace NSSO;
+
+namespace
+{
+
+using TScalarUtf8 = CUtf8<char, CScalarUtf8>;
+
+/**
+ * @brief Append code point encoded in UTF-8.
+ */
+void appendCodePoint(std::string& aOutput, std::uint32_t aCodePoint)
+{
+    if (aCodePoint < 0x80u)
+    {
+        aOutput.push_back(static_cast<char>(aCodePoint));
+    }
+    else if (aCodePoint < 0x800u)
+    {
+        aOutput.push_back(static_cast<char>(0xC0u | (aCodePoint >> 6u)));
+        aOutput.push_back(static_cast<char>(0x80u | (aCodePoint & 0x3Fu)));
+    }
+    else if (aCodePoint < 0x10000u)
+    {
+        aOutput.push_back(static_cast<char>(0xE0u | (aCodePoint >> 12u)));
+        aOutput.push_back(static_cast<char>(0x80u | ((aCodePoint >> 6u) & 0x3Fu)));
+        aOutput.push_back(static_cast<char>(0x80u | (aCodePoint & 0x3Fu)));
+    }
+    else
+    {
+        aOutput.push_back(static_cast<char>(0xF0u | (aCodePoint >> 18u)));
+        aOutput.push_back(static_cast<char>(0x80u | ((aCodePoint >> 12u) & 0x3Fu)));
+        aOutput.push_back(static_cast<char>(0x80u | ((aCodePoint >> 6u) & 0x3Fu)));
+        aOutput.push_back(static_cast<char>(0x80u | (aCodePoint & 0x3Fu)));
+    }
+}
+
+/**
+ * @brief Return random valid UTF-8 of the given number of code points, mostly ASCII and Polish letters.
+ */
+std::string randomText(std::mt19937& aGenerator, std::size_t aCodePoints)
+{
+    std::string output;
+    for (std::size_t i = 0u; i < aCodePoints; ++i)
+    {
+        switch (aGenerator() % 6u)
+        {
+        case 0u:
+            appendCodePoint(output, 0x104u + aGenerator() % 0x80u);
+            break;
+        case 1u:
+            appendCodePoint(output, 0x800u + aGenerator() % 0xD000u);
+            break;
+        case 2u:
+            appendCodePoint(output, 0x10000u + aGenerator() % 0x100000u);
+            break;
+        default:
+            appendCodePoint(output, 0x20u + aGenerator() % 0x5Fu);
+            break;
+        }
+    }
+    return output;
+}
+
+} // namespace
+
+TEST(Utf8Tests, knownSequences)
+{
+    const char* const valid[] = {"", "a", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+        "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "zażółć gęślą jaźń"};
+    const char* const invalid[] = {"\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41", "\xE0\x80\x80",
+        "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xE1\x80", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+        "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xF0\x90\x80", "\xC2\x80\x80"};
+    // every sequence at every position of vectors, between ASCII characters
+    for (std::size_t prefix = 0u; prefix < 70u; ++prefix)
+    {
+        for (const char* txt : valid)
+        {
+            const std::string str = std::string(prefix, 'a') + txt + "bcd";
+            ASSERT_TRUE(TScalarUtf8::isValid(str.data(), str.size())) << prefix << " " << txt;
+            ASSERT_TRUE(CUtf8<char>::isValid(str.data(), str.size())) << prefix << " " << txt;
+        }
+        for (const char* txt : invalid)
+        {
+            const std::string str = std::string(prefix, 'a') + txt;
+            ASSERT_FALSE(TScalarUtf8::isValid(str.data(), str.size())) << prefix << " " << txt;
+            ASSERT_FALSE(CUtf8<char>::isValid(str.data(), str.size())) << prefix << " " << txt;
+            const std::string followed = str + std::string(40u, 'b');
+            ASSERT_FALSE(CUtf8<char>::isValid(followed.data(), followed.size())) << prefix << " " << txt;
+        }
+    }
+}
+
+TEST(Utf8Tests, compareWithScalar)
+{
+    std::mt19937 generator{1234u};
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string str = randomText(generator, generator() % 80u);
+        if (i % 2 == 1 && !str.empty())
+        {
+            // corrupt a random byte
+            str[generator() % str.size()] = static_cast<char>(generator() % 256u);
+        }
+        ASSERT_EQ(CUtf8<char>::isValid(str.data(), str.size()), TScalarUtf8::isValid(str.data(), str.size())) << i;
+        ASSERT_EQ(CUtf8<char>::countCodePoints(str.data(), str.size()),
+            TScalarUtf8::countCodePoints(str.data(), str.size()));
+        const std::size_t width = generator() % 90u;
+        ASSERT_EQ(CUtf8<char>::prefixOfWidth(str.data(), str.size(), width),
+            TScalarUtf8::prefixOfWidth(str.data(), str.size(), width));
+    }
+}
+
+TEST(Utf8Tests, smallStringOpt)
+{
+    CSmallStringOpt<16u> str{"zażółć gęślą jaźń"};
+    ASSERT_TRUE(str.is_valid_utf8());
+    ASSERT_EQ(str.size(), 26u);
+    ASSERT_EQ(str.count_code_points(), 17u);
+    ASSERT_EQ(str.utf8_prefix_of_width(3u), 4u);
+    ASSERT_EQ(str.utf8_prefix_of_width(17u), 26u);
+    ASSERT_EQ(str.utf8_prefix_of_width(100u), 26u);
+    str.resize(str.utf8_prefix_of_width(6u));
+    ASSERT_STREQ(str.data(), "zażółć");
+
+    const CSmallStringOpt<16u> ascii{"short"};
+    ASSERT_TRUE(ascii.is_valid_utf8());
+    ASSERT_EQ(ascii.count_code_points(), 5u);
+    ASSERT_EQ(ascii.utf8_prefix_of_width(2u), 2u);
+    ASSERT_FALSE(CSmallStringOpt<16u>{"ab\xC5"}.is_valid_utf8());
+    ASSERT_TRUE(CSmallStringOpt<16u>{}.is_valid_utf8());
+
+#if defined(__cpp_char8_t)
+    const CSmallStringOpt<16u, char8_t> str8{u8"żółw"};
+    ASSERT_TRUE(str8.is_valid_utf8());
+    ASSERT_EQ(str8.count_code_points(), 4u);
+#endif
+}
+
+TEST(Utf8Tests, simpleString)
+{
+    CSimpleString<char> str{"zażółć gęślą jaźń"};
+    ASSERT_TRUE(str.is_valid_utf8());
+    ASSERT_EQ(str.count_code_points(), 17u);
+    ASSERT_EQ(str.utf8_prefix_of_width(7u), 11u);
+    str.append("\xF0\x9F");
+    ASSERT_FALSE(str.is_valid_utf8());
+}